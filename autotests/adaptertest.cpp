@@ -140,6 +140,11 @@ void AdapterTest::getPropertiesTest()
         QCOMPARE(unit.adapter->modalias(), unit.dbusAdapter->modalias());
 
         compareUuids(unit.adapter->uuids(), unit.dbusAdapter->uUIDs());
+
+        QCOMPARE(unit.adapter->uuidValues().count(), unit.adapter->uuids().count());
+        for (int i = 0; i < unit.adapter->uuids().count(); ++i) {
+            QCOMPARE(unit.adapter->uuidValues().at(i), Uuid(unit.adapter->uuids().at(i)));
+        }
     }
 }
 
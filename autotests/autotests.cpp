@@ -102,6 +102,20 @@ void StartJob::processFinished(int code, QProcess::ExitStatus status)
     m_eventLoop.quit();
 }
 
+class MessageReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    QDBusMessage message;
+
+public Q_SLOTS:
+    void messageReceived(const QDBusMessage &msg)
+    {
+        message = msg;
+    }
+};
+
 void FakeBluez::start()
 {
     if (isRunning()) {
@@ -167,6 +181,7 @@ void Autotests::registerMetatypes()
     qRegisterMetaType<BluezQt::GattDescriptorRemotePtr>("GattDescriptorRemotePtr");
     qRegisterMetaType<BluezQt::GattCharacteristicRemotePtr>("GattCharacteristicRemotePtr");
     qRegisterMetaType<BluezQt::GattServiceRemotePtr>("GattServiceRemotePtr");
+    qRegisterMetaType<BluezQt::GattDatabase>("GattDatabase");
     qRegisterMetaType<BluezQt::DevicePtr>("DevicePtr");
     qRegisterMetaType<BluezQt::AdapterPtr>("AdapterPtr");
     qRegisterMetaType<BluezQt::BatteryPtr>("BatteryPtr");
@@ -195,4 +210,135 @@ void Autotests::verifyPropertiesChangedSignal(const QSignalSpy &spy, const QStri
     QCOMPARE(changes, 1);
 }
 
+QVariant Autotests::sendThroughDBus(const QVariant &value)
+{
+    const QString path = QStringLiteral("/org/kde/bluezqt/autotests");
+    const QString interface = QStringLiteral("org.kde.bluezqt.Autotests");
+    const QString name = QStringLiteral("Value");
+
+    QDBusConnection connection = QDBusConnection::sessionBus();
+    MessageReceiver receiver;
+    connection.connect(QString(), path, interface, name, &receiver, SLOT(messageReceived(QDBusMessage)));
+
+    QDBusMessage signal = QDBusMessage::createSignal(path, interface, name);
+    signal << value;
+    connection.send(signal);
+
+    QTest::qWaitFor([&receiver] {
+        return receiver.message.type() == QDBusMessage::SignalMessage;
+    });
+
+    connection.disconnect(QString(), path, interface, name, &receiver, SLOT(messageReceived(QDBusMessage)));
+    return receiver.message.arguments().value(0);
+}
+
+// UUIDs are derived from handles, so that all fixtures of one device are distinct
+static QString fixtureUuid(quint16 handle)
+{
+    return QStringLiteral("04FA28C0-2D0C-11EC-8D3D-0242AC13%1").arg(handle, 4, 16, QLatin1Char('0')).toUpper();
+}
+
+QDBusObjectPath Autotests::createAdapter()
+{
+    QDBusObjectPath adapterPath = QDBusObjectPath(QStringLiteral("/org/bluez/hci0"));
+    QVariantMap adapterProps;
+    adapterProps[QStringLiteral("Path")] = QVariant::fromValue(adapterPath);
+    adapterProps[QStringLiteral("Address")] = QStringLiteral("1C:E5:C3:BC:94:7E");
+    adapterProps[QStringLiteral("Name")] = QStringLiteral("TestAdapter");
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-adapter"), adapterProps);
+
+    return adapterPath;
+}
+
+QList<QDBusObjectPath> Autotests::createDevices(const QDBusObjectPath &adapter, int count)
+{
+    QList<QDBusObjectPath> paths;
+    paths.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        const QString address = QStringLiteral("40:79:6A:0C:%1:%2").arg(i / 256, 2, 16, QLatin1Char('0')).arg(i % 256, 2, 16, QLatin1Char('0')).toUpper();
+        const QDBusObjectPath devicePath(adapter.path() + QStringLiteral("/dev_") + QString(address).replace(QLatin1Char(':'), QLatin1Char('_')));
+
+        QVariantMap deviceProps;
+        deviceProps[QStringLiteral("Path")] = QVariant::fromValue(devicePath);
+        deviceProps[QStringLiteral("Adapter")] = QVariant::fromValue(adapter);
+        deviceProps[QStringLiteral("Address")] = address;
+        deviceProps[QStringLiteral("Name")] = QStringLiteral("TestDevice");
+        deviceProps[QStringLiteral("RSSI")] = QVariant::fromValue(qint16(-50));
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-device"), deviceProps);
+
+        paths.append(devicePath);
+    }
+
+    return paths;
+}
+
+QList<QDBusObjectPath> Autotests::createGattServices(const QDBusObjectPath &device, int count, quint16 firstHandle)
+{
+    QList<QDBusObjectPath> paths;
+    paths.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        const quint16 handle = firstHandle + i;
+        const QDBusObjectPath servicePath(device.path() + QStringLiteral("/service%1").arg(handle, 4, 16, QLatin1Char('0')));
+
+        QVariantMap serviceProps;
+        serviceProps[QStringLiteral("Path")] = QVariant::fromValue(servicePath);
+        serviceProps[QStringLiteral("UUID")] = fixtureUuid(handle);
+        serviceProps[QStringLiteral("Primary")] = true;
+        serviceProps[QStringLiteral("Device")] = QVariant::fromValue(device);
+        serviceProps[QStringLiteral("Includes")] = QVariant::fromValue(QList<QDBusObjectPath>());
+        serviceProps[QStringLiteral("Handle")] = QVariant::fromValue(qint16(handle));
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-gatt-service"), serviceProps);
+
+        paths.append(servicePath);
+    }
+
+    return paths;
+}
+
+QList<QDBusObjectPath> Autotests::createGattCharacteristics(const QDBusObjectPath &service, int count, quint16 firstHandle)
+{
+    QList<QDBusObjectPath> paths;
+    paths.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        const quint16 handle = firstHandle + i;
+        const QDBusObjectPath charPath(service.path() + QStringLiteral("/char%1").arg(handle, 4, 16, QLatin1Char('0')));
+
+        QVariantMap charProps;
+        charProps[QStringLiteral("Path")] = QVariant::fromValue(charPath);
+        charProps[QStringLiteral("UUID")] = fixtureUuid(handle);
+        charProps[QStringLiteral("Service")] = QVariant::fromValue(service);
+        charProps[QStringLiteral("Value")] = QVariant::fromValue(QByteArray());
+        charProps[QStringLiteral("Notifying")] = false;
+        charProps[QStringLiteral("Flags")] = QStringList({QStringLiteral("read")});
+        charProps[QStringLiteral("Handle")] = QVariant::fromValue(qint16(handle));
+        charProps[QStringLiteral("MTU")] = QVariant::fromValue(qint16(512));
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-gatt-characteristic"), charProps);
+
+        paths.append(charPath);
+    }
+
+    return paths;
+}
+
+void Autotests::removeGattServices(const QList<QDBusObjectPath> &services)
+{
+    for (const QDBusObjectPath &path : services) {
+        QVariantMap properties;
+        properties[QStringLiteral("Path")] = QVariant::fromValue(path);
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("remove-gatt-service"), properties);
+    }
+}
+
+void Autotests::removeGattCharacteristics(const QList<QDBusObjectPath> &characteristics)
+{
+    for (const QDBusObjectPath &path : characteristics) {
+        QVariantMap properties;
+        properties[QStringLiteral("Path")] = QVariant::fromValue(path);
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("remove-gatt-characteristic"), properties);
+    }
+}
+
 #include "autotests.moc"
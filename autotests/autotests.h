@@ -9,6 +9,8 @@
 
 #include <QDBusConnection>
 #include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QList>
 #include <QProcess>
 #include <QSignalSpy>
 #include <QTest>
@@ -31,6 +33,17 @@ namespace Autotests
 void registerMetatypes();
 void verifyPropertiesChangedSignal(const QSignalSpy &spy, const QString &propertyName, const QVariant &propertyValue);
 
+// Sends value to ourselves over session bus, returns it as demarshalled from received message
+QVariant sendThroughDBus(const QVariant &value);
+
+// Fixtures created in fakebluez, returned paths are only valid once the client has seen the objects
+QDBusObjectPath createAdapter();
+QList<QDBusObjectPath> createDevices(const QDBusObjectPath &adapter, int count);
+QList<QDBusObjectPath> createGattServices(const QDBusObjectPath &device, int count, quint16 firstHandle);
+QList<QDBusObjectPath> createGattCharacteristics(const QDBusObjectPath &service, int count, quint16 firstHandle);
+void removeGattServices(const QList<QDBusObjectPath> &services);
+void removeGattCharacteristics(const QList<QDBusObjectPath> &characteristics);
+
 }
 
 #endif // AUTOTESTS_H
@@ -6,15 +6,18 @@
 
 #include "devicetest.h"
 #include "autotests.h"
+#include "devicesmodel.h"
 #include "initmanagerjob.h"
 #include "pendingcall.h"
 
+#include <QDBusArgument>
 #include <QSignalSpy>
 #include <QTest>
 
 namespace BluezQt
 {
 extern void bluezqt_initFakeBluezTestRun();
+extern void bluezqt_devicePropertiesChanged(Device *device, const QVariantMap &changed);
 }
 
 using namespace BluezQt;
@@ -214,6 +217,229 @@ void DeviceTest::setBlockedTest()
     }
 }
 
+void DeviceTest::mergePropertiesChangedTest()
+{
+    m_manager->setPropertiesChangedLatency(500);
+
+    for (const DeviceUnit &unit : m_units) {
+        QSignalSpy rssiSpy(unit.device.data(), SIGNAL(rssiChanged(qint16)));
+        QSignalSpy deviceSpy(unit.device.data(), SIGNAL(deviceChanged(DevicePtr)));
+
+        const quint64 mergedCount = m_manager->mergedPropertiesChangedCount();
+
+        QVariantMap properties;
+        properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(unit.device->ubi()));
+        properties[QStringLiteral("Name")] = QStringLiteral("RSSI");
+
+        for (qint16 rssi : {-40, -50, -60}) {
+            properties[QStringLiteral("Value")] = QVariant::fromValue(rssi);
+            FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+        }
+
+        QTRY_COMPARE(rssiSpy.count(), 1);
+        QCOMPARE(rssiSpy.at(0).at(0).value<qint16>(), qint16(-60));
+        QCOMPARE(deviceSpy.count(), 1);
+        QCOMPARE(unit.device->rssi(), qint16(-60));
+        QCOMPARE(m_manager->mergedPropertiesChangedCount(), mergedCount + 2);
+    }
+
+    m_manager->setPropertiesChangedLatency(0);
+}
+
+void DeviceTest::orderPropertiesChangedTest()
+{
+    QVERIFY(m_units.count() >= 2);
+    m_manager->setPropertiesChangedLatency(500);
+
+    const DeviceUnit &first = m_units.at(0);
+    const DeviceUnit &second = m_units.at(1);
+    const quint64 mergedCount = m_manager->mergedPropertiesChangedCount();
+
+    QStringList order;
+    connect(first.device.data(), &Device::rssiChanged, this, [&order](qint16 rssi) {
+        order.append(QStringLiteral("first %1").arg(rssi));
+    });
+    connect(second.device.data(), &Device::rssiChanged, this, [&order](qint16 rssi) {
+        order.append(QStringLiteral("second %1").arg(rssi));
+    });
+
+    QVariantMap properties;
+    properties[QStringLiteral("Name")] = QStringLiteral("RSSI");
+
+    // Changes separated by a change of another object are not merged
+    const QList<QPair<const DeviceUnit *, qint16>> changes = {{&first, -41}, {&second, -42}, {&first, -43}};
+    for (const auto &change : changes) {
+        properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(change.first->device->ubi()));
+        properties[QStringLiteral("Value")] = QVariant::fromValue(change.second);
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+    }
+
+    QTRY_COMPARE(order.count(), 3);
+    QCOMPARE(order, QStringList({QStringLiteral("first -41"), QStringLiteral("second -42"), QStringLiteral("first -43")}));
+    QCOMPARE(m_manager->mergedPropertiesChangedCount(), mergedCount);
+
+    first.device->disconnect(this);
+    second.device->disconnect(this);
+    m_manager->setPropertiesChangedLatency(0);
+}
+
+void DeviceTest::updatePolicyTest()
+{
+    Device::UpdatePolicy policy;
+    policy.rssiThreshold = 10;
+    m_manager->setDeviceUpdatePolicy(policy);
+
+    for (const DeviceUnit &unit : m_units) {
+        QCOMPARE(unit.device->updatePolicy().rssiThreshold, 10);
+
+        QSignalSpy rssiSpy(unit.device.data(), SIGNAL(rssiChanged(qint16)));
+
+        const qint16 rssi = unit.device->rssi();
+
+        QVariantMap properties;
+        properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(unit.device->ubi()));
+        properties[QStringLiteral("Name")] = QStringLiteral("RSSI");
+
+        // Change below threshold is not reported
+        properties[QStringLiteral("Value")] = QVariant::fromValue(qint16(rssi + 3));
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+
+        QTRY_COMPARE(unit.device->rawRssi(), qint16(rssi + 3));
+        QCOMPARE(unit.device->rssi(), rssi);
+        QCOMPARE(rssiSpy.count(), 0);
+
+        properties[QStringLiteral("Value")] = QVariant::fromValue(qint16(rssi + 15));
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+
+        QTRY_COMPARE(rssiSpy.count(), 1);
+        QCOMPARE(rssiSpy.at(0).at(0).value<qint16>(), qint16(rssi + 15));
+        QCOMPARE(unit.device->rssi(), qint16(rssi + 15));
+        QCOMPARE(unit.device->rawRssi(), qint16(rssi + 15));
+    }
+
+    m_manager->setDeviceUpdatePolicy(Device::UpdatePolicy());
+}
+
+void DeviceTest::updatePolicyRateAndThresholdTest()
+{
+    Device::UpdatePolicy policy;
+    policy.maxUpdatesPerSecond = 2;
+    policy.rssiThreshold = 10;
+    m_manager->setDeviceUpdatePolicy(policy);
+
+    for (const DeviceUnit &unit : m_units) {
+        QSignalSpy rssiSpy(unit.device.data(), SIGNAL(rssiChanged(qint16)));
+
+        const qint16 rssi = unit.device->rssi();
+
+        QVariantMap properties;
+        properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(unit.device->ubi()));
+        properties[QStringLiteral("Name")] = QStringLiteral("RSSI");
+
+        properties[QStringLiteral("Value")] = QVariant::fromValue(qint16(rssi - 20));
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+        QTRY_COMPARE(rssiSpy.count(), 1);
+
+        // Deferred by rate limit, then superseded by a sample below threshold
+        properties[QStringLiteral("Value")] = QVariant::fromValue(qint16(rssi));
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+        properties[QStringLiteral("Value")] = QVariant::fromValue(qint16(rssi - 19));
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+
+        QTRY_COMPARE(unit.device->rawRssi(), qint16(rssi - 19));
+        QTest::qWait(700);
+        QCOMPARE(rssiSpy.count(), 1);
+        QCOMPARE(unit.device->rssi(), qint16(rssi - 20));
+    }
+
+    m_manager->setDeviceUpdatePolicy(Device::UpdatePolicy());
+}
+
+void DeviceTest::devicesModelRolesTest()
+{
+    DevicesModel model(m_manager);
+
+    for (const DeviceUnit &unit : m_units) {
+        QSignalSpy dataChangedSpy(&model, SIGNAL(dataChanged(QModelIndex, QModelIndex, QVector<int>)));
+
+        QVariantMap properties;
+        properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(unit.device->ubi()));
+        properties[QStringLiteral("Name")] = QStringLiteral("RSSI");
+        properties[QStringLiteral("Value")] = QVariant::fromValue(qint16(unit.device->rssi() - 7));
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+
+        QTRY_COMPARE(dataChangedSpy.count(), 1);
+
+        const QModelIndex index = dataChangedSpy.at(0).at(0).toModelIndex();
+        QCOMPARE(model.device(index), unit.device);
+        QCOMPARE(dataChangedSpy.at(0).at(2).value<QVector<int>>(), QVector<int>{DevicesModel::RssiRole});
+
+        // Repeated values don't change any role
+        properties[QStringLiteral("Name")] = QStringLiteral("Paired");
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("repeat-device-property"), properties);
+
+        properties[QStringLiteral("Name")] = QStringLiteral("RSSI");
+        properties[QStringLiteral("Value")] = QVariant::fromValue(qint16(unit.device->rssi() + 7));
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+
+        QTRY_COMPARE(dataChangedSpy.count(), 2);
+        QCOMPARE(dataChangedSpy.at(1).at(2).value<QVector<int>>(), QVector<int>{DevicesModel::RssiRole});
+    }
+}
+
+void DeviceTest::serviceDataTest()
+{
+    for (const DeviceUnit &unit : m_units) {
+        QVariantMap serviceData;
+        serviceData[QStringLiteral("0000180d-0000-1000-8000-00805f9b34fb")] = QByteArray("\x01\x02\x03", 3);
+
+        QVariantMap properties;
+        properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(unit.device->ubi()));
+        properties[QStringLiteral("Name")] = QStringLiteral("ServiceData");
+        properties[QStringLiteral("Value")] = serviceData;
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+
+        // Keys are uppercase UUIDs
+        QHash<QString, QByteArray> expected;
+        expected[QStringLiteral("0000180D-0000-1000-8000-00805F9B34FB")] = QByteArray("\x01\x02\x03", 3);
+        QTRY_COMPARE(unit.device->serviceData(), expected);
+    }
+}
+
+void DeviceTest::serviceDataBenchmark()
+{
+    // Advertisements with service data arriving at high rate, D-Bus delivery is not measured
+
+    const DeviceUnit &unit = m_units.first();
+
+    const int advertisementsCount = 500;
+
+    QVariantList advertisements;
+    for (int i = 1; i <= advertisementsCount; ++i) {
+        QByteArray payload(20, char(i));
+        QVariantMap serviceData;
+        serviceData[QStringLiteral("0000180d-0000-1000-8000-00805f9b34fb")] = payload;
+        serviceData[QStringLiteral("0000fe9f-0000-1000-8000-00805f9b34fb")] = payload;
+        advertisements.append(serviceData);
+    }
+
+    // Each ServiceData value is a{sv} waiting to be demarshalled, as in PropertiesChanged
+    QVariantList values;
+    Autotests::sendThroughDBus(advertisements).value<QDBusArgument>() >> values;
+    QCOMPARE(values.count(), advertisementsCount);
+
+    QVariantMap changed;
+
+    QBENCHMARK_ONCE {
+        for (const QVariant &value : qAsConst(values)) {
+            changed[QStringLiteral("ServiceData")] = value;
+            bluezqt_devicePropertiesChanged(unit.device.data(), changed);
+        }
+    }
+
+    QTRY_COMPARE(unit.device->serviceData().value(QStringLiteral("0000FE9F-0000-1000-8000-00805F9B34FB")), QByteArray(20, char(advertisementsCount)));
+}
+
 void DeviceTest::deviceRemovedTest()
 {
     for (const DeviceUnit &unit : m_units) {
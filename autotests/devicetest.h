@@ -32,6 +32,13 @@ private Q_SLOTS:
     void setAliasTest();
     void setTrustedTest();
     void setBlockedTest();
+    void mergePropertiesChangedTest();
+    void orderPropertiesChangedTest();
+    void updatePolicyTest();
+    void updatePolicyRateAndThresholdTest();
+    void devicesModelRolesTest();
+    void serviceDataTest();
+    void serviceDataBenchmark();
 
     void deviceRemovedTest();
 
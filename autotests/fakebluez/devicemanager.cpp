@@ -16,6 +16,14 @@
 #include "mediatransportinterface.h"
 #include "objectmanager.h"
 
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QTimer>
+#include <QtEndian>
+
 DeviceManager::DeviceManager(ObjectManager *parent)
     : QObject(parent)
     , m_objectManager(parent)
@@ -48,6 +56,10 @@ void DeviceManager::runAction(const QString &actionName, const QVariantMap &prop
         runChangeAdapterProperty(properties);
     } else if (actionName == QLatin1String("change-device-property")) {
         runChangeDeviceProperty(properties);
+    } else if (actionName == QLatin1String("repeat-device-property")) {
+        runRepeatDeviceProperty(properties);
+    } else if (actionName == QLatin1String("notify-gatt-characteristic")) {
+        runNotifyGattCharacteristic(properties);
     } else if (actionName.startsWith(QLatin1String("adapter-media:"))) {
         runAdapterMediaAction(actionName.mid(14), properties);
     } else if (actionName.startsWith(QLatin1String("adapter-leadvertisingmanager:"))) {
@@ -173,6 +185,82 @@ void DeviceManager::runChangeDeviceProperty(const QVariantMap &properties)
     device->changeProperty(properties.value(QStringLiteral("Name")).toString(), properties.value(QStringLiteral("Value")));
 }
 
+void DeviceManager::runRepeatDeviceProperty(const QVariantMap &properties)
+{
+    const QDBusObjectPath &path = properties.value(QStringLiteral("Path")).value<QDBusObjectPath>();
+    Object *device = m_objectManager->objectByPath(path);
+    if (!device || device->name() != QLatin1String("org.bluez.Device1")) {
+        return;
+    }
+
+    // PropertiesChanged with the current value, BlueZ may send these too
+    const QString name = properties.value(QStringLiteral("Name")).toString();
+    QVariantMap updatedProperties;
+    updatedProperties[name] = device->property(name);
+
+    QDBusMessage signal = QDBusMessage::createSignal(path.path(), QStringLiteral("org.freedesktop.DBus.Properties"), QStringLiteral("PropertiesChanged"));
+    signal << device->name();
+    signal << updatedProperties;
+    signal << QStringList();
+    QDBusConnection::sessionBus().send(signal);
+}
+
+void DeviceManager::runNotifyGattCharacteristic(const QVariantMap &properties)
+{
+    const QDBusObjectPath &path = properties.value(QStringLiteral("Path")).value<QDBusObjectPath>();
+    GattCharacteristicInterface *characteristic = dynamic_cast<GattCharacteristicInterface *>(m_objectManager->objectByPath(path));
+    if (!characteristic) {
+        return;
+    }
+
+    // Count notifications are sent with the index appended to make each value unique,
+    // Timestamp prepends the send time (CLOCK_MONOTONIC ns, little endian) to each value
+    const QByteArray value = properties.value(QStringLiteral("Value")).toByteArray();
+    const int count = properties.value(QStringLiteral("Count"), 1).toInt();
+    const bool timestamp = properties.value(QStringLiteral("Timestamp")).toBool();
+    const int rate = properties.value(QStringLiteral("Rate")).toInt();
+
+    auto makeValue = [value, count, timestamp](int i) {
+        QByteArray v = count > 1 ? value + QByteArray::number(i) : value;
+        if (timestamp) {
+            char ns[sizeof(qint64)];
+            qToLittleEndian<qint64>(QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs(), ns);
+            v.prepend(ns, sizeof(ns));
+        }
+        return v;
+    };
+
+    if (rate <= 0) {
+        for (int i = 0; i < count; ++i) {
+            characteristic->notify(makeValue(i));
+        }
+        return;
+    }
+
+    // Sustained rate (notifications per second) is kept by a timer, so that
+    // the action returns right away and the client can receive meanwhile
+    QPointer<GattCharacteristicInterface> guard = characteristic;
+    QTimer *timer = new QTimer(this);
+    timer->setTimerType(Qt::PreciseTimer);
+    timer->setInterval(1);
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    int sent = 0;
+
+    connect(timer, &QTimer::timeout, this, [=]() mutable {
+        const int due = qMin<qint64>(count, elapsed.nsecsElapsed() * rate / 1000000000);
+        while (guard && sent < due) {
+            guard->notify(makeValue(sent++));
+        }
+        if (!guard || sent >= count) {
+            timer->stop();
+            timer->deleteLater();
+        }
+    });
+    timer->start();
+}
+
 void DeviceManager::runAdapterMediaAction(const QString action, const QVariantMap &properties)
 {
     const QDBusObjectPath &path = properties.value(QStringLiteral("AdapterPath")).value<QDBusObjectPath>();
@@ -33,6 +33,8 @@ private:
     void runRemoveGattDescriptorAction(const QVariantMap &properties);
     void runChangeAdapterProperty(const QVariantMap &properties);
     void runChangeDeviceProperty(const QVariantMap &properties);
+    void runRepeatDeviceProperty(const QVariantMap &properties);
+    void runNotifyGattCharacteristic(const QVariantMap &properties);
     void runAdapterMediaAction(const QString action, const QVariantMap &properties);
     void runAdapterLeAdvertisingManagerAction(const QString action, const QVariantMap &properties);
     void runAdapterGattManagerAction(const QString action, const QVariantMap &properties);
@@ -11,6 +11,11 @@
 #include <QDBusArgument>
 #include <QDBusConnection>
 #include <QDBusMessage>
+#include <QSocketNotifier>
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 // GattServiceObject
 GattCharacteristicObject::GattCharacteristicObject(const QDBusObjectPath &path, QObject *parent)
@@ -22,6 +27,11 @@ GattCharacteristicObject::GattCharacteristicObject(const QDBusObjectPath &path,
 // GattServiceInterface
 GattCharacteristicInterface::GattCharacteristicInterface(const QDBusObjectPath &path, const QVariantMap &properties, QObject *parent)
     : QDBusAbstractAdaptor(parent)
+    , m_writeSocket(-1)
+    , m_writeNotifier(nullptr)
+    , m_notifySocket(-1)
+    , m_notifyNotifier(nullptr)
+    , m_notifyHangupNotifier(nullptr)
 {
     setPath(path);
     setObjectParent(parent);
@@ -29,6 +39,12 @@ GattCharacteristicInterface::GattCharacteristicInterface(const QDBusObjectPath &
     setName(QStringLiteral("org.bluez.GattCharacteristic1"));
 }
 
+GattCharacteristicInterface::~GattCharacteristicInterface()
+{
+    closeWriteSocket();
+    closeNotifySocket();
+}
+
 QString GattCharacteristicInterface::UUID() const
 {
     return Object::property(QStringLiteral("UUID")).toString();
@@ -92,3 +108,134 @@ void GattCharacteristicInterface::StopNotify()
 {
     Object::changeProperty(QStringLiteral("Notifying"), false);
 }
+
+QDBusUnixFileDescriptor GattCharacteristicInterface::AcquireWrite(const QVariantMap &options, quint16 &mtu)
+{
+    Q_UNUSED(options)
+
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) < 0) {
+        return QDBusUnixFileDescriptor();
+    }
+
+    closeWriteSocket();
+    m_writeSocket = fds[0];
+    m_writeNotifier = new QSocketNotifier(m_writeSocket, QSocketNotifier::Read, this);
+    connect(m_writeNotifier, &QSocketNotifier::activated, this, &GattCharacteristicInterface::writeSocketActivated);
+    Object::changeProperty(QStringLiteral("WriteAcquired"), true);
+
+    mtu = MTU();
+    QDBusUnixFileDescriptor fd(fds[1]);
+    ::close(fds[1]);
+    return fd;
+}
+
+QDBusUnixFileDescriptor GattCharacteristicInterface::AcquireNotify(const QVariantMap &options, quint16 &mtu)
+{
+    Q_UNUSED(options)
+
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) < 0) {
+        return QDBusUnixFileDescriptor();
+    }
+
+    closeNotifySocket();
+    m_notifySocket = fds[0];
+
+    // Client closing its end stops the notifications
+    m_notifyHangupNotifier = new QSocketNotifier(m_notifySocket, QSocketNotifier::Read, this);
+    connect(m_notifyHangupNotifier, &QSocketNotifier::activated, this, [this]() {
+        char c;
+        if (::recv(m_notifySocket, &c, 1, MSG_DONTWAIT) == 0) {
+            closeNotifySocket();
+        }
+    });
+
+    m_notifyNotifier = new QSocketNotifier(m_notifySocket, QSocketNotifier::Write, this);
+    m_notifyNotifier->setEnabled(false);
+    connect(m_notifyNotifier, &QSocketNotifier::activated, this, &GattCharacteristicInterface::flushNotifications);
+
+    Object::changeProperty(QStringLiteral("NotifyAcquired"), true);
+    Object::changeProperty(QStringLiteral("Notifying"), true);
+
+    mtu = MTU();
+    QDBusUnixFileDescriptor fd(fds[1]);
+    ::close(fds[1]);
+    return fd;
+}
+
+void GattCharacteristicInterface::notify(const QByteArray &value)
+{
+    if (m_notifySocket < 0) {
+        Object::changeProperty(QStringLiteral("Value"), value);
+        return;
+    }
+
+    m_pendingNotifications.enqueue(value);
+    flushNotifications();
+}
+
+void GattCharacteristicInterface::flushNotifications()
+{
+    // Writes must not block as the client may be waiting for the action to finish
+    while (m_notifySocket >= 0 && !m_pendingNotifications.isEmpty()) {
+        const QByteArray &value = m_pendingNotifications.head();
+        if (::send(m_notifySocket, value.constData(), value.size(), MSG_DONTWAIT | MSG_NOSIGNAL) < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                closeNotifySocket();
+            }
+            break;
+        }
+        m_pendingNotifications.dequeue();
+    }
+
+    if (m_notifyNotifier) {
+        m_notifyNotifier->setEnabled(!m_pendingNotifications.isEmpty());
+    }
+}
+
+void GattCharacteristicInterface::writeSocketActivated()
+{
+    while (m_writeSocket >= 0) {
+        QByteArray value(qMax<int>(MTU(), 23), Qt::Uninitialized);
+        const ssize_t size = ::recv(m_writeSocket, value.data(), value.size(), MSG_DONTWAIT);
+        if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else if (size <= 0) {
+            closeWriteSocket();
+            break;
+        }
+        value.resize(size);
+        Object::changeProperty(QStringLiteral("Value"), value);
+    }
+}
+
+void GattCharacteristicInterface::closeWriteSocket()
+{
+    if (m_writeSocket < 0) {
+        return;
+    }
+
+    delete m_writeNotifier;
+    m_writeNotifier = nullptr;
+    ::close(m_writeSocket);
+    m_writeSocket = -1;
+    Object::changeProperty(QStringLiteral("WriteAcquired"), false);
+}
+
+void GattCharacteristicInterface::closeNotifySocket()
+{
+    if (m_notifySocket < 0) {
+        return;
+    }
+
+    delete m_notifyNotifier;
+    m_notifyNotifier = nullptr;
+    delete m_notifyHangupNotifier;
+    m_notifyHangupNotifier = nullptr;
+    ::close(m_notifySocket);
+    m_notifySocket = -1;
+    m_pendingNotifications.clear();
+    Object::changeProperty(QStringLiteral("NotifyAcquired"), false);
+    Object::changeProperty(QStringLiteral("Notifying"), false);
+}
@@ -10,9 +10,12 @@
 #include "object.h"
 
 #include <QDBusAbstractAdaptor>
+#include <QDBusUnixFileDescriptor>
+#include <QQueue>
 #include <QStringList>
 
 class QDBusObjectPath;
+class QSocketNotifier;
 
 class GattCharacteristicObject : public QObject
 {
@@ -34,6 +37,7 @@ class GattCharacteristicInterface : public QDBusAbstractAdaptor, public Object
 
 public:
     explicit GattCharacteristicInterface(const QDBusObjectPath &path, const QVariantMap &properties, QObject *parent = nullptr);
+    ~GattCharacteristicInterface() override;
 
     QString UUID() const;
 
@@ -55,8 +59,22 @@ public Q_SLOTS:
     void WriteValue(const QByteArray& value, const QVariantMap& options);
     void StartNotify();
     void StopNotify();
+    QDBusUnixFileDescriptor AcquireWrite(const QVariantMap &options, quint16 &mtu);
+    QDBusUnixFileDescriptor AcquireNotify(const QVariantMap &options, quint16 &mtu);
 
 private:
+    void notify(const QByteArray &value);
+    void flushNotifications();
+    void writeSocketActivated();
+    void closeWriteSocket();
+    void closeNotifySocket();
+
+    int m_writeSocket;
+    QSocketNotifier *m_writeNotifier;
+    int m_notifySocket;
+    QSocketNotifier *m_notifyNotifier;
+    QSocketNotifier *m_notifyHangupNotifier;
+    QQueue<QByteArray> m_pendingNotifications;
 
     friend class DeviceManager;
 };
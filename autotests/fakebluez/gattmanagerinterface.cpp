@@ -11,6 +11,11 @@
 #include <QDBusMessage>
 #include <QDBusPendingCall>
 #include <QDBusPendingReply>
+#include <QDBusUnixFileDescriptor>
+#include <QSocketNotifier>
+
+#include <sys/socket.h>
+#include <unistd.h>
 
 GattManagerInterface::GattManagerInterface(const QDBusObjectPath &path, QObject *parent)
     : QDBusAbstractAdaptor(parent)
@@ -27,6 +32,22 @@ void GattManagerInterface::runAction(const QString &actionName, const QVariantMa
         runReadCharcAction(properties);
     } else if (actionName == QLatin1String("write-charc")) {
         runWriteCharcAction(properties);
+    } else if (actionName == QLatin1String("write-desc")) {
+        runWriteDescAction(properties);
+    } else if (actionName == QLatin1String("start-notify-charc")) {
+        runStartNotifyCharcAction();
+    } else if (actionName == QLatin1String("stop-notify-charc")) {
+        runStopNotifyCharcAction();
+    } else if (actionName == QLatin1String("report-notify-count")) {
+        runReportNotifyCountAction();
+    } else if (actionName == QLatin1String("acquire-write-charc")) {
+        runAcquireWriteCharcAction();
+    } else if (actionName == QLatin1String("write-acquired-charc")) {
+        runWriteAcquiredCharcAction(properties);
+    } else if (actionName == QLatin1String("acquire-notify-charc")) {
+        runAcquireNotifyCharcAction();
+    } else if (actionName == QLatin1String("release-notify-charc")) {
+        runReleaseNotifyCharcAction();
     }
 }
 
@@ -61,9 +82,14 @@ void GattManagerInterface::runGetObjectsAction()
 
         DBusManagerStruct objects = reply.value();
         for (const auto &object : objects.keys()) {
-            if (object.path().contains(QLatin1String("char"))) {
-                m_characteristic = object;
-                break;
+            if (object.path().contains(QLatin1String("desc"))) {
+                if (m_descriptor.path().isEmpty()) {
+                    m_descriptor = object;
+                }
+            } else if (object.path().contains(QLatin1String("char"))) {
+                if (m_characteristic.path().isEmpty()) {
+                    m_characteristic = object;
+                }
             }
         }
     });
@@ -85,3 +111,132 @@ void GattManagerInterface::runWriteCharcAction(const QVariantMap &properties)
     call << properties.value(QStringLiteral("Options"));
     QDBusConnection::sessionBus().asyncCall(call);
 }
+
+void GattManagerInterface::runWriteDescAction(const QVariantMap &properties)
+{
+    QDBusMessage call =
+        QDBusMessage::createMethodCall(m_service, m_descriptor.path(), QStringLiteral("org.bluez.GattDescriptor1"), QStringLiteral("WriteValue"));
+    call << properties.value(QStringLiteral("Value"));
+    call << properties.value(QStringLiteral("Options"));
+    QDBusConnection::sessionBus().asyncCall(call);
+}
+
+void GattManagerInterface::runStartNotifyCharcAction()
+{
+    m_notifyCount = 0;
+    QDBusConnection::sessionBus().connect(m_service,
+                                          m_characteristic.path(),
+                                          QStringLiteral("org.freedesktop.DBus.Properties"),
+                                          QStringLiteral("PropertiesChanged"),
+                                          this,
+                                          SLOT(characteristicPropertiesChanged(QString, QVariantMap, QStringList)));
+
+    QDBusMessage call =
+        QDBusMessage::createMethodCall(m_service, m_characteristic.path(), QStringLiteral("org.bluez.GattCharacteristic1"), QStringLiteral("StartNotify"));
+    QDBusConnection::sessionBus().asyncCall(call);
+}
+
+void GattManagerInterface::runStopNotifyCharcAction()
+{
+    QDBusConnection::sessionBus().disconnect(m_service,
+                                             m_characteristic.path(),
+                                             QStringLiteral("org.freedesktop.DBus.Properties"),
+                                             QStringLiteral("PropertiesChanged"),
+                                             this,
+                                             SLOT(characteristicPropertiesChanged(QString, QVariantMap, QStringList)));
+
+    QDBusMessage call =
+        QDBusMessage::createMethodCall(m_service, m_characteristic.path(), QStringLiteral("org.bluez.GattCharacteristic1"), QStringLiteral("StopNotify"));
+    QDBusConnection::sessionBus().asyncCall(call);
+}
+
+void GattManagerInterface::runReportNotifyCountAction()
+{
+    // Count notifications already sent to the socket too
+    readNotifySocket();
+
+    // Number of received notifications is written back to the characteristic
+    QVariantMap properties;
+    properties.insert(QStringLiteral("Value"), QByteArray::number(m_notifyCount));
+    properties.insert(QStringLiteral("Options"), QVariantMap());
+    runWriteCharcAction(properties);
+}
+
+void GattManagerInterface::characteristicPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
+{
+    Q_UNUSED(invalidated)
+
+    if (interface == QLatin1String("org.bluez.GattCharacteristic1") && changed.contains(QStringLiteral("Value"))) {
+        m_notifyCount++;
+    }
+}
+
+void GattManagerInterface::runAcquireWriteCharcAction()
+{
+    QDBusMessage call =
+        QDBusMessage::createMethodCall(m_service, m_characteristic.path(), QStringLiteral("org.bluez.GattCharacteristic1"), QStringLiteral("AcquireWrite"));
+    call << QVariantMap({{QStringLiteral("mtu"), QVariant::fromValue(quint16(512))}});
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(call));
+    connect(watcher, &QDBusPendingCallWatcher::finished, [this](QDBusPendingCallWatcher *watcher) {
+        const QDBusPendingReply<QDBusUnixFileDescriptor, quint16> &reply = *watcher;
+        watcher->deleteLater();
+        if (reply.isError()) {
+            return;
+        }
+
+        if (m_writeSocket >= 0) {
+            ::close(m_writeSocket);
+        }
+        m_writeSocket = ::dup(reply.argumentAt<0>().fileDescriptor());
+    });
+}
+
+void GattManagerInterface::runWriteAcquiredCharcAction(const QVariantMap &properties)
+{
+    const QByteArray value = properties.value(QStringLiteral("Value")).toByteArray();
+    ::send(m_writeSocket, value.constData(), value.size(), MSG_NOSIGNAL);
+}
+
+void GattManagerInterface::runAcquireNotifyCharcAction()
+{
+    m_notifyCount = 0;
+
+    QDBusMessage call =
+        QDBusMessage::createMethodCall(m_service, m_characteristic.path(), QStringLiteral("org.bluez.GattCharacteristic1"), QStringLiteral("AcquireNotify"));
+    call << QVariantMap({{QStringLiteral("mtu"), QVariant::fromValue(quint16(512))}});
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(call));
+    connect(watcher, &QDBusPendingCallWatcher::finished, [this](QDBusPendingCallWatcher *watcher) {
+        const QDBusPendingReply<QDBusUnixFileDescriptor, quint16> &reply = *watcher;
+        watcher->deleteLater();
+        if (reply.isError()) {
+            qFatal("AcquireNotify failed: %s", qPrintable(reply.error().message()));
+        }
+
+        runReleaseNotifyCharcAction();
+        m_notifySocket = ::dup(reply.argumentAt<0>().fileDescriptor());
+        m_notifySocketNotifier = new QSocketNotifier(m_notifySocket, QSocketNotifier::Read, this);
+        connect(m_notifySocketNotifier, &QSocketNotifier::activated, this, &GattManagerInterface::readNotifySocket);
+    });
+}
+
+void GattManagerInterface::runReleaseNotifyCharcAction()
+{
+    if (m_notifySocket < 0) {
+        return;
+    }
+
+    delete m_notifySocketNotifier;
+    m_notifySocketNotifier = nullptr;
+    ::close(m_notifySocket);
+    m_notifySocket = -1;
+}
+
+void GattManagerInterface::readNotifySocket()
+{
+    char buffer[512];
+    while (m_notifySocket >= 0 && ::recv(m_notifySocket, buffer, sizeof(buffer), MSG_DONTWAIT) > 0) {
+        m_notifyCount++;
+    }
+}
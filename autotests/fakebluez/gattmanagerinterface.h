@@ -11,6 +11,7 @@
 #include <QDBusAbstractAdaptor>
 
 class QDBusMessage;
+class QSocketNotifier;
 
 class GattManagerInterface : public QDBusAbstractAdaptor, public Object
 {
@@ -30,9 +31,26 @@ private:
     void runGetObjectsAction();
     void runReadCharcAction(const QVariantMap &properties);
     void runWriteCharcAction(const QVariantMap &properties);
+    void runWriteDescAction(const QVariantMap &properties);
+    void runStartNotifyCharcAction();
+    void runStopNotifyCharcAction();
+    void runReportNotifyCountAction();
+    void runAcquireWriteCharcAction();
+    void runWriteAcquiredCharcAction(const QVariantMap &properties);
+    void runAcquireNotifyCharcAction();
+    void runReleaseNotifyCharcAction();
+    void readNotifySocket();
+
+private Q_SLOTS:
+    void characteristicPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
 
     QDBusObjectPath m_application;
     QDBusObjectPath m_characteristic;
+    QDBusObjectPath m_descriptor;
     QString m_service;
     QVariantMap m_properties;
+    int m_notifyCount = 0;
+    int m_writeSocket = -1;
+    int m_notifySocket = -1;
+    QSocketNotifier *m_notifySocketNotifier = nullptr;
 };
@@ -6,9 +6,14 @@
 
 #include "gattcharacteristicremotetest.h"
 #include "autotests.h"
+#include "device.h"
 #include "initmanagerjob.h"
+#include "gattreadjob.h"
+#include "gattwritejob.h"
 #include "pendingcall.h"
 
+#include <QBuffer>
+
 #include <QSignalSpy>
 #include <QTest>
 #include <QDebug>
@@ -20,6 +25,49 @@ extern void bluezqt_initFakeBluezTestRun();
 
 using namespace BluezQt;
 
+// Sequential device receiving its data after the job was started
+class LateDevice : public QIODevice
+{
+public:
+    bool isSequential() const override
+    {
+        return true;
+    }
+
+    qint64 bytesAvailable() const override
+    {
+        return m_data.size() + QIODevice::bytesAvailable();
+    }
+
+    void receive(const QByteArray &data)
+    {
+        m_data.append(data);
+        Q_EMIT readyRead();
+    }
+
+    void finish()
+    {
+        Q_EMIT readChannelFinished();
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        const qint64 size = qMin<qint64>(maxSize, m_data.size());
+        memcpy(data, m_data.constData(), size);
+        m_data.remove(0, size);
+        return size;
+    }
+
+    qint64 writeData(const char *, qint64) override
+    {
+        return -1;
+    }
+
+private:
+    QByteArray m_data;
+};
+
 GattCharacteristicRemoteTest::GattCharacteristicRemoteTest()
     : m_manager(nullptr)
 {
@@ -257,6 +305,75 @@ void GattCharacteristicRemoteTest::writeValueTest()
     }
 }
 
+void GattCharacteristicRemoteTest::writeValueStreamTest()
+{
+    QByteArray data;
+    for (int i = 0; i < 5000; ++i) {
+        data.append(char(i % 251));
+    }
+
+    for (const GattCharacteristicRemoteUnit &unit : qAsConst(m_units)) {
+        GattWriteJob *job = unit.characteristic->writeValueStream(data, {});
+        QCOMPARE(job->writeType(), QStringLiteral("request"));
+        QCOMPARE(job->chunkSize(), unit.characteristic->MTU() - 3);
+        QCOMPARE(job->totalSize(), qint64(data.size()));
+
+        const int chunks = (data.size() + job->chunkSize() - 1) / job->chunkSize();
+        QSignalSpy progressSpy(job, SIGNAL(progress(qint64, qint64)));
+        QVERIFY(job->exec());
+        QCOMPARE(progressSpy.count(), chunks);
+        QCOMPARE(progressSpy.last().at(0).toLongLong(), qint64(data.size()));
+
+        // Last chunk is the last written value
+        const QByteArray last = data.mid((chunks - 1) * (unit.characteristic->MTU() - 3));
+        QTRY_COMPARE(unit.characteristic->value(), last);
+
+        // Write from device
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+        job = unit.characteristic->writeValueStream(&buffer, {{QStringLiteral("type"), QStringLiteral("command")}});
+        QCOMPARE(job->writeType(), QStringLiteral("command"));
+        QCOMPARE(job->totalSize(), qint64(data.size()));
+        QSignalSpy deviceProgressSpy(job, SIGNAL(progress(qint64, qint64)));
+        QVERIFY(job->exec());
+        QCOMPARE(deviceProgressSpy.count(), chunks);
+        QCOMPARE(deviceProgressSpy.last().at(0).toLongLong(), qint64(data.size()));
+        QVERIFY(buffer.atEnd());
+    }
+}
+
+void GattCharacteristicRemoteTest::writeValueStreamSequentialTest()
+{
+    QByteArray data;
+    for (int i = 0; i < 1000; ++i) {
+        data.append(char(i % 251));
+    }
+
+    for (const GattCharacteristicRemoteUnit &unit : qAsConst(m_units)) {
+        LateDevice device;
+        device.open(QIODevice::ReadOnly);
+
+        GattWriteJob *job = unit.characteristic->writeValueStream(&device, {});
+        QCOMPARE(job->totalSize(), qint64(-1));
+        QSignalSpy progressSpy(job, SIGNAL(progress(qint64, qint64)));
+        QSignalSpy resultSpy(job, &GattWriteJob::result);
+        job->start();
+
+        // No data yet, job must not finish
+        QTest::qWait(50);
+        QCOMPARE(resultSpy.count(), 0);
+
+        device.receive(data.left(400));
+        QTRY_COMPARE(progressSpy.count(), (400 + job->chunkSize() - 1) / job->chunkSize());
+        QCOMPARE(resultSpy.count(), 0);
+
+        device.receive(data.mid(400));
+        device.finish();
+        QTRY_COMPARE(resultSpy.count(), 1);
+        QCOMPARE(progressSpy.last().at(0).toLongLong(), qint64(data.size()));
+    }
+}
+
 void GattCharacteristicRemoteTest::startNotifyTest()
 {
     for (const GattCharacteristicRemoteUnit &unit : qAsConst(m_units)) {
@@ -311,6 +428,443 @@ void GattCharacteristicRemoteTest::stopNotifyTest()
     }
 }
 
+void GattCharacteristicRemoteTest::acquireNotifyTest()
+{
+    for (const GattCharacteristicRemoteUnit &unit : qAsConst(m_units)) {
+        QSignalSpy notifyingSpy(unit.characteristic.data(), SIGNAL(notifyingChanged(bool)));
+        QSignalSpy notifyAcquiredSpy(unit.characteristic.data(), SIGNAL(notifyAcquiredChanged(bool)));
+        QSignalSpy writeAcquiredSpy(unit.characteristic.data(), SIGNAL(writeAcquiredChanged(bool)));
+
+        TPendingCall<QDBusUnixFileDescriptor, uint16_t> *call = unit.characteristic->acquireNotify({});
+        call->waitForFinished();
+        QVERIFY(!call->error());
+        QVERIFY(call->valueAt<0>().isValid());
+        QCOMPARE(call->valueAt<1>(), unit.characteristic->MTU());
+        QTRY_COMPARE(notifyingSpy.count(), 1);
+        QVERIFY(unit.characteristic->isNotifying());
+        QTRY_COMPARE(notifyAcquiredSpy.count(), 1);
+        QVERIFY(unit.characteristic->isNotifyAcquired());
+        QVERIFY(!unit.characteristic->isWriteAcquired());
+
+        // Notifications are delivered through the socket, not through D-Bus
+        QSignalSpy valueSpy(unit.characteristic.data(), SIGNAL(valueChanged(const QByteArray)));
+        QSignalSpy dbusSpy(unit.dbusProperties, SIGNAL(PropertiesChanged(QString, QVariantMap, QStringList)));
+
+        QVariantMap properties;
+        properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(unit.characteristic->ubi()));
+        properties[QStringLiteral("Value")] = QByteArray("NOTIFY");
+        properties[QStringLiteral("Count")] = 3;
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("notify-gatt-characteristic"), properties);
+
+        QTRY_COMPARE(valueSpy.count(), 3);
+        QCOMPARE(valueSpy.at(0).at(0).toByteArray(), QByteArray("NOTIFY0"));
+        QCOMPARE(valueSpy.at(2).at(0).toByteArray(), QByteArray("NOTIFY2"));
+        QCOMPARE(unit.characteristic->value(), QByteArray("NOTIFY2"));
+        QCOMPARE(dbusSpy.count(), 0);
+
+        // Closing the socket stops notifications
+        unit.characteristic->releaseNotify();
+        QTRY_COMPARE(notifyingSpy.count(), 2);
+        QVERIFY(!unit.characteristic->isNotifying());
+        QTRY_COMPARE(notifyAcquiredSpy.count(), 2);
+        QVERIFY(!unit.characteristic->isNotifyAcquired());
+        QCOMPARE(writeAcquiredSpy.count(), 0);
+    }
+}
+
+void GattCharacteristicRemoteTest::acquireWriteTest()
+{
+    for (const GattCharacteristicRemoteUnit &unit : qAsConst(m_units)) {
+        QVERIFY(!unit.characteristic->sendValue(QByteArray("SOCKET")));
+
+        TPendingCall<QDBusUnixFileDescriptor, uint16_t> *call = unit.characteristic->acquireWrite({});
+        call->waitForFinished();
+        QVERIFY(!call->error());
+        QVERIFY(call->valueAt<0>().isValid());
+
+        QSignalSpy valueSpy(unit.characteristic.data(), SIGNAL(valueChanged(const QByteArray)));
+
+        // Values must fit into MTU without the ATT header
+        const int maxSize = call->valueAt<1>() - 3;
+        QVERIFY(!unit.characteristic->sendValue(QByteArray(maxSize + 1, 'x')));
+
+        QVERIFY(unit.characteristic->sendValue(QByteArray(maxSize, 'x')));
+        QTRY_COMPARE(valueSpy.count(), 1);
+        QCOMPARE(unit.characteristic->value(), QByteArray(maxSize, 'x'));
+
+        QVERIFY(unit.characteristic->sendValue(QByteArray("SOCKET")));
+        QTRY_COMPARE(valueSpy.count(), 2);
+        QCOMPARE(unit.characteristic->value(), QByteArray("SOCKET"));
+        QCOMPARE(unit.dbusCharacteristic->value(), QByteArray("SOCKET"));
+
+        unit.characteristic->releaseWrite();
+        QVERIFY(!unit.characteristic->sendValue(QByteArray("SOCKET")));
+    }
+}
+
+void GattCharacteristicRemoteTest::notificationBufferTest()
+{
+    for (const GattCharacteristicRemoteUnit &unit : qAsConst(m_units)) {
+        unit.characteristic->setNotificationBufferSize(4);
+        QCOMPARE(unit.characteristic->notificationBufferSize(), 4);
+
+        QSignalSpy availableSpy(unit.characteristic.data(), SIGNAL(notificationsAvailable(int)));
+        QSignalSpy valueSpy(unit.characteristic.data(), SIGNAL(valueChanged(const QByteArray)));
+        QSignalSpy characteristicSpy(unit.characteristic.data(), SIGNAL(characteristicChanged(GattCharacteristicRemotePtr)));
+
+        QVariantMap properties;
+        properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(unit.characteristic->ubi()));
+        properties[QStringLiteral("Value")] = QByteArray("BUF");
+        properties[QStringLiteral("Count")] = 10;
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("notify-gatt-characteristic"), properties);
+
+        // Oldest notifications are dropped when the buffer is full
+        QTRY_COMPARE(unit.characteristic->droppedNotifications(), quint64(6));
+        QTRY_VERIFY(availableSpy.count() >= 1);
+        QCOMPARE(availableSpy.count(), valueSpy.count());
+        QCOMPARE(availableSpy.count(), characteristicSpy.count());
+        QCOMPARE(unit.characteristic->notificationsPending(), 4);
+        QCOMPARE(unit.characteristic->value(), QByteArray("BUF9"));
+
+        QVector<GattCharacteristicRemote::Notification> notifications = unit.characteristic->takeNotifications(1);
+        QCOMPARE(notifications.count(), 1);
+        QCOMPARE(notifications.at(0).value, QByteArray("BUF6"));
+        QVERIFY(notifications.at(0).timestamp > 0);
+
+        notifications = unit.characteristic->takeNotifications();
+        QCOMPARE(notifications.count(), 3);
+        QCOMPARE(notifications.at(0).value, QByteArray("BUF7"));
+        QCOMPARE(notifications.at(2).value, QByteArray("BUF9"));
+        QVERIFY(notifications.at(0).timestamp <= notifications.at(2).timestamp);
+        QCOMPARE(unit.characteristic->notificationsPending(), 0);
+
+        properties[QStringLiteral("Count")] = 4;
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("notify-gatt-characteristic"), properties);
+        QTRY_COMPARE(unit.characteristic->notificationsPending(), 4);
+
+        // Notifications that do not fit into the shrunk buffer are dropped
+        unit.characteristic->setNotificationBufferSize(2);
+        QCOMPARE(unit.characteristic->notificationsPending(), 2);
+        QCOMPARE(unit.characteristic->droppedNotifications(), quint64(8));
+
+        unit.characteristic->setNotificationBufferSize(0);
+        QCOMPARE(unit.characteristic->notificationBufferSize(), 0);
+        QCOMPARE(unit.characteristic->notificationsPending(), 0);
+        QCOMPARE(unit.characteristic->droppedNotifications(), quint64(10));
+    }
+}
+
+void GattCharacteristicRemoteTest::notifyBenchmark_data()
+{
+    QTest::addColumn<bool>("socket");
+    QTest::addColumn<bool>("buffered");
+
+    QTest::newRow("D-Bus") << false << false;
+    QTest::newRow("D-Bus buffered") << false << true;
+    QTest::newRow("socket") << true << false;
+    QTest::newRow("socket buffered") << true << true;
+}
+
+void GattCharacteristicRemoteTest::notifyBenchmark()
+{
+    QFETCH(bool, socket);
+    QFETCH(bool, buffered);
+
+    const int count = 1000;
+    const GattCharacteristicRemoteUnit &unit = m_units.first();
+
+    if (socket) {
+        TPendingCall<QDBusUnixFileDescriptor, uint16_t> *call = unit.characteristic->acquireNotify({});
+        call->waitForFinished();
+        QVERIFY(!call->error());
+    }
+
+    QVariantMap properties;
+    properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(unit.characteristic->ubi()));
+    properties[QStringLiteral("Value")] = QByteArray("BENCH");
+    properties[QStringLiteral("Count")] = count;
+
+    int received = 0;
+    unit.characteristic->setNotificationBufferSize(buffered ? count : 0);
+    QMetaObject::Connection connection;
+    if (buffered) {
+        connection = connect(unit.characteristic.data(), &GattCharacteristicRemote::notificationsAvailable, this, [&received, &unit]() {
+            received += unit.characteristic->takeNotifications().count();
+        });
+    } else {
+        connection = connect(unit.characteristic.data(), &GattCharacteristicRemote::valueChanged, this, [&received]() {
+            received++;
+        });
+    }
+
+    QBENCHMARK_ONCE {
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("notify-gatt-characteristic"), properties);
+        QTRY_COMPARE_WITH_TIMEOUT(received, count, 30000);
+    }
+
+    disconnect(connection);
+    unit.characteristic->setNotificationBufferSize(0);
+
+    if (socket) {
+        unit.characteristic->releaseNotify();
+        QTRY_VERIFY(!unit.characteristic->isNotifying());
+    }
+}
+
+void GattCharacteristicRemoteTest::writeStreamBenchmark_data()
+{
+    QTest::addColumn<bool>("stream");
+
+    QTest::newRow("writeValue") << false;
+    QTest::newRow("writeValueStream") << true;
+}
+
+void GattCharacteristicRemoteTest::writeStreamBenchmark()
+{
+    QFETCH(bool, stream);
+
+    const GattCharacteristicRemoteUnit &unit = m_units.first();
+    const int chunkSize = unit.characteristic->MTU() - 3;
+    const QByteArray data(256 * 1024, 'x');
+
+    QBENCHMARK_ONCE {
+        if (stream) {
+            QVERIFY(unit.characteristic->writeValueStream(data, {})->exec());
+        } else {
+            for (int pos = 0; pos < data.size(); pos += chunkSize) {
+                PendingCall *call = unit.characteristic->writeValue(data.mid(pos, chunkSize), {});
+                call->waitForFinished();
+                QVERIFY(!call->error());
+            }
+        }
+    }
+}
+
+void GattCharacteristicRemoteTest::findCharacteristicTest()
+{
+    for (const GattCharacteristicRemoteUnit &unit : qAsConst(m_units)) {
+        const GattServiceRemotePtr service = unit.characteristic->service();
+        const DevicePtr device = service->device();
+
+        QCOMPARE(device->findService(service->uuidValue()), service);
+        QCOMPARE(device->findCharacteristic(service->uuidValue(), unit.characteristic->uuidValue()), unit.characteristic);
+        QCOMPARE(service->findCharacteristic(unit.characteristic->uuidValue()), unit.characteristic);
+        QCOMPARE(device->findByHandle(unit.characteristic->handle()), unit.characteristic);
+
+        QVERIFY(!device->findService(Uuid(quint32(0x180F))));
+        QVERIFY(!device->findCharacteristic(service->uuidValue(), Uuid(quint32(0x2A19))));
+        QVERIFY(!device->findCharacteristic(Uuid(quint32(0x180F)), unit.characteristic->uuidValue()));
+
+        // Index follows handle changes
+        QSignalSpy handleSpy(unit.characteristic.data(), SIGNAL(handleChanged(quint16)));
+        const quint16 oldHandle = unit.characteristic->handle();
+        const quint16 newHandle = oldHandle + 100;
+        unit.characteristic->setHandle(newHandle);
+        QTRY_COMPARE(handleSpy.count(), 1);
+
+        QCOMPARE(device->findByHandle(newHandle), unit.characteristic);
+        QVERIFY(!device->findByHandle(oldHandle));
+
+        unit.characteristic->setHandle(oldHandle);
+        QTRY_COMPARE(handleSpy.count(), 2);
+        QCOMPARE(device->findByHandle(oldHandle), unit.characteristic);
+    }
+
+    // Characteristic with the lowest handle wins among services with the same UUID
+    const GattCharacteristicRemotePtr characteristic = m_units.first().characteristic;
+    const GattServiceRemotePtr service = characteristic->service();
+    const DevicePtr device = service->device();
+    const QDBusObjectPath servicePath(device->ubi() + QStringLiteral("/service0100"));
+    const QDBusObjectPath charPath(servicePath.path() + QStringLiteral("/char0101"));
+
+    QVariantMap serviceProps;
+    serviceProps[QStringLiteral("Path")] = QVariant::fromValue(servicePath);
+    serviceProps[QStringLiteral("UUID")] = service->uuid();
+    serviceProps[QStringLiteral("Primary")] = true;
+    serviceProps[QStringLiteral("Device")] = QVariant::fromValue(QDBusObjectPath(device->ubi()));
+    serviceProps[QStringLiteral("Includes")] = QVariant::fromValue(QList<QDBusObjectPath>());
+    serviceProps[QStringLiteral("Handle")] = QVariant::fromValue(qint16(0x100));
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-gatt-service"), serviceProps);
+
+    QVariantMap charProps;
+    charProps[QStringLiteral("Path")] = QVariant::fromValue(charPath);
+    charProps[QStringLiteral("UUID")] = characteristic->uuid();
+    charProps[QStringLiteral("Service")] = QVariant::fromValue(servicePath);
+    charProps[QStringLiteral("Value")] = QVariant::fromValue(QByteArray());
+    charProps[QStringLiteral("Notifying")] = false;
+    charProps[QStringLiteral("Flags")] = QStringList({QStringLiteral("read")});
+    charProps[QStringLiteral("Handle")] = QVariant::fromValue(qint16(0x101));
+    charProps[QStringLiteral("MTU")] = QVariant::fromValue(qint16(512));
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-gatt-characteristic"), charProps);
+
+    QTRY_VERIFY(device->findByHandle(0x101));
+    const GattCharacteristicRemotePtr duplicate = device->findByHandle(0x101);
+    QCOMPARE(device->findService(service->uuidValue()), service);
+    QCOMPARE(device->findCharacteristic(service->uuidValue(), characteristic->uuidValue()), characteristic);
+
+    QSignalSpy handleSpy(characteristic.data(), SIGNAL(handleChanged(quint16)));
+    const quint16 oldHandle = characteristic->handle();
+    characteristic->setHandle(0x102);
+    QTRY_COMPARE(handleSpy.count(), 1);
+    QCOMPARE(device->findCharacteristic(service->uuidValue(), characteristic->uuidValue()), duplicate);
+
+    characteristic->setHandle(oldHandle);
+    QTRY_COMPARE(handleSpy.count(), 2);
+    QCOMPARE(device->findCharacteristic(service->uuidValue(), characteristic->uuidValue()), characteristic);
+
+    Autotests::removeGattCharacteristics({charPath});
+    Autotests::removeGattServices({servicePath});
+    QTRY_COMPARE(device->gattServices().count(), 1);
+}
+
+void GattCharacteristicRemoteTest::findCharacteristicBenchmark_data()
+{
+    QTest::addColumn<bool>("indexed");
+
+    QTest::newRow("scan") << false;
+    QTest::newRow("index") << true;
+}
+
+void GattCharacteristicRemoteTest::findCharacteristicBenchmark()
+{
+    QFETCH(bool, indexed);
+
+    // Database of a typical device, the looked up characteristic is the last one
+    const int serviceCount = 10;
+    const int characteristicCount = 10;
+    const DevicePtr device = m_units.first().characteristic->service()->device();
+    const QList<QDBusObjectPath> servicePaths = Autotests::createGattServices(QDBusObjectPath(device->ubi()), serviceCount, 0x100);
+    QList<QDBusObjectPath> charPaths;
+    for (int i = 0; i < serviceCount; ++i) {
+        charPaths += Autotests::createGattCharacteristics(servicePaths.at(i), characteristicCount, 0x200 + i * characteristicCount);
+    }
+
+    const quint16 lastHandle = 0x200 + serviceCount * characteristicCount - 1;
+    QTRY_COMPARE(device->gattServices().count(), serviceCount + 1);
+    QTRY_VERIFY(device->findByHandle(lastHandle));
+
+    const GattCharacteristicRemotePtr characteristic = device->findByHandle(lastHandle);
+    const QString serviceUuid = characteristic->service()->uuid();
+    const QString characteristicUuid = characteristic->uuid();
+    const Uuid serviceUuidValue = characteristic->service()->uuidValue();
+    const Uuid characteristicUuidValue = characteristic->uuidValue();
+
+    GattCharacteristicRemotePtr found;
+
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i) {
+            found.clear();
+            if (indexed) {
+                found = device->findCharacteristic(serviceUuidValue, characteristicUuidValue);
+            } else {
+                const QList<GattServiceRemotePtr> services = device->gattServices();
+                for (const GattServiceRemotePtr &service : services) {
+                    if (service->uuid() != serviceUuid) {
+                        continue;
+                    }
+                    const QList<GattCharacteristicRemotePtr> characteristics = service->characteristics();
+                    for (const GattCharacteristicRemotePtr &ch : characteristics) {
+                        if (ch->uuid() == characteristicUuid) {
+                            found = ch;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    QCOMPARE(found, characteristic);
+
+    Autotests::removeGattCharacteristics(charPaths);
+    Autotests::removeGattServices(servicePaths);
+    QTRY_COMPARE(device->gattServices().count(), 1);
+}
+
+void GattCharacteristicRemoteTest::readCharacteristicsTest()
+{
+    const GattServiceRemotePtr service = m_units.first().characteristic->service();
+    const DevicePtr device = service->device();
+    const int initialCount = service->characteristics().count();
+
+    const QList<QDBusObjectPath> paths = Autotests::createGattCharacteristics(QDBusObjectPath(service->ubi()), 20, 200);
+    QTRY_COMPARE(service->characteristics().count(), initialCount + 20);
+    QList<GattCharacteristicRemotePtr> characteristics = service->characteristics().mid(initialCount);
+
+    GattReadJob *job = device->readCharacteristics(characteristics);
+    job->setMaxInFlight(4);
+    QSignalSpy resultSpy(job, SIGNAL(result(GattReadJob*)));
+    QVERIFY(job->exec());
+    QCOMPARE(resultSpy.count(), 1);
+
+    QCOMPARE(job->values().count(), 20);
+    QVERIFY(job->errors().isEmpty());
+    for (const GattCharacteristicRemotePtr &characteristic : qAsConst(characteristics)) {
+        QCOMPARE(job->values().value(characteristic->uuidValue()), QByteArray("TEST"));
+    }
+
+    // Failed reads are reported per characteristic
+    const GattCharacteristicRemotePtr removed = characteristics.takeLast();
+    Autotests::removeGattCharacteristics({QDBusObjectPath(removed->ubi())});
+    QTRY_VERIFY(!service->findCharacteristic(removed->uuidValue()));
+
+    job = device->readCharacteristics(characteristics + QList<GattCharacteristicRemotePtr>{removed});
+    job->setMaxInFlight(8);
+    QVERIFY(job->exec());
+    QCOMPARE(job->values().count(), 19);
+    QCOMPARE(job->errors().count(), 1);
+    QVERIFY(job->errors().contains(removed->uuidValue()));
+
+    // Empty list finishes right away
+    job = device->readCharacteristics({});
+    QVERIFY(job->exec());
+    QVERIFY(job->values().isEmpty());
+
+    Autotests::removeGattCharacteristics(paths.mid(0, paths.count() - 1));
+    QTRY_COMPARE(service->characteristics().count(), initialCount);
+}
+
+void GattCharacteristicRemoteTest::readCharacteristicsBenchmark_data()
+{
+    QTest::addColumn<bool>("batched");
+
+    QTest::newRow("readValue") << false;
+    QTest::newRow("readCharacteristics") << true;
+}
+
+void GattCharacteristicRemoteTest::readCharacteristicsBenchmark()
+{
+    QFETCH(bool, batched);
+
+    const GattServiceRemotePtr service = m_units.first().characteristic->service();
+    const DevicePtr device = service->device();
+    const int initialCount = service->characteristics().count();
+
+    const QList<QDBusObjectPath> paths = Autotests::createGattCharacteristics(QDBusObjectPath(service->ubi()), 24, 200);
+    QTRY_COMPARE(service->characteristics().count(), initialCount + 24);
+    const QList<GattCharacteristicRemotePtr> characteristics = service->characteristics().mid(initialCount);
+
+    QBENCHMARK {
+        if (batched) {
+            GattReadJob *job = device->readCharacteristics(characteristics);
+            QVERIFY(job->exec());
+            QCOMPARE(job->values().count(), characteristics.count());
+        } else {
+            QList<PendingCall *> calls;
+            for (const GattCharacteristicRemotePtr &characteristic : characteristics) {
+                calls.append(characteristic->readValue({}));
+            }
+            for (PendingCall *call : qAsConst(calls)) {
+                call->waitForFinished();
+                QVERIFY(!call->error());
+            }
+        }
+    }
+
+    Autotests::removeGattCharacteristics(paths);
+    QTRY_COMPARE(service->characteristics().count(), initialCount);
+}
+
 void GattCharacteristicRemoteTest::characteristicRemovedTest()
 {
     for (const GattCharacteristicRemoteUnit &unit : qAsConst(m_units)) {
@@ -323,6 +877,10 @@ void GattCharacteristicRemoteTest::characteristicRemovedTest()
         QTRY_COMPARE(serviceSpy.count(), 1);
 
         QCOMPARE(serviceSpy.at(0).at(0).value<GattCharacteristicRemotePtr>(), unit.characteristic);
+
+        const GattServiceRemotePtr service = unit.characteristic->service();
+        QVERIFY(!service->findCharacteristic(unit.characteristic->uuidValue()));
+        QVERIFY(!service->device()->findByHandle(unit.characteristic->handle()));
     }
 }
 
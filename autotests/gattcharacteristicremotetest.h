@@ -33,8 +33,27 @@ private Q_SLOTS:
 
     void readValueTest();
     void writeValueTest();
+    void writeValueStreamTest();
+    void writeValueStreamSequentialTest();
     void startNotifyTest();
     void stopNotifyTest();
+    void acquireNotifyTest();
+    void acquireWriteTest();
+    void notificationBufferTest();
+    void findCharacteristicTest();
+    void readCharacteristicsTest();
+
+    void notifyBenchmark_data();
+    void notifyBenchmark();
+
+    void writeStreamBenchmark_data();
+    void writeStreamBenchmark();
+
+    void findCharacteristicBenchmark_data();
+    void findCharacteristicBenchmark();
+
+    void readCharacteristicsBenchmark_data();
+    void readCharacteristicsBenchmark();
 
     void characteristicRemovedTest();
 
@@ -10,8 +10,10 @@
 #include "pendingcall.h"
 #include "gattserviceremote.h"
 #include "gattcharacteristicremote.h"
+#include "gattdatabase.h"
 
 #include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QTest>
 #include <QDebug>
 
@@ -282,6 +284,105 @@ void GattDescriptorRemoteTest::writeValueTest()
     }
 }
 
+void GattDescriptorRemoteTest::gattDatabaseTest()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    for (const GattDescriptorRemoteUnit &unit : qAsConst(m_units)) {
+        const GattCharacteristicRemotePtr characteristic = unit.descriptor->characteristic();
+        const GattServiceRemotePtr service = characteristic->service();
+        const DevicePtr device = service->device();
+
+        const GattDatabase database = device->gattDatabase();
+        QVERIFY(database.isValid());
+        QCOMPARE(database.address(), device->address());
+        QCOMPARE(database.servicesCount(), 1);
+        QCOMPARE(database.hash().size(), 16);
+
+        const QVector<GattDatabase::Attribute> attributes = database.attributes();
+        QCOMPARE(attributes.count(), 3);
+        QCOMPARE(attributes.at(0).type, GattDatabase::Attribute::Service);
+        QCOMPARE(attributes.at(0).handle, service->handle());
+        QCOMPARE(attributes.at(0).uuid, service->uuidValue());
+        QCOMPARE(attributes.at(1).type, GattDatabase::Attribute::Characteristic);
+        QCOMPARE(attributes.at(1).handle, characteristic->handle());
+        QCOMPARE(attributes.at(1).path, characteristic->ubi());
+        QCOMPARE(attributes.at(1).flags, characteristic->flags());
+        QCOMPARE(attributes.at(2).type, GattDatabase::Attribute::Descriptor);
+        QCOMPARE(attributes.at(2).handle, unit.descriptor->handle());
+        QCOMPARE(attributes.at(2).uuid, unit.descriptor->uuidValue());
+
+        // Same layout yields same hash
+        QCOMPARE(device->gattDatabase().hash(), database.hash());
+
+        const QString fileName = dir.filePath(device->address());
+        QVERIFY(database.save(fileName));
+
+        const GattDatabase loaded = GattDatabase::load(fileName);
+        QVERIFY(loaded.isValid());
+        QCOMPARE(loaded.address(), database.address());
+        QCOMPARE(loaded.hash(), database.hash());
+        QCOMPARE(loaded.attributes().count(), attributes.count());
+        for (int i = 0; i < attributes.count(); ++i) {
+            QCOMPARE(loaded.attributes().at(i).type, attributes.at(i).type);
+            QCOMPARE(loaded.attributes().at(i).handle, attributes.at(i).handle);
+            QCOMPARE(loaded.attributes().at(i).uuid, attributes.at(i).uuid);
+            QCOMPARE(loaded.attributes().at(i).path, attributes.at(i).path);
+            QCOMPARE(loaded.attributes().at(i).flags, attributes.at(i).flags);
+        }
+    }
+
+    QVERIFY(!GattDatabase::load(dir.filePath(QStringLiteral("missing"))).isValid());
+
+    // Hash doesn't depend on the order services are announced in
+    const DevicePtr device = m_units.first().descriptor->characteristic()->service()->device();
+    const QDBusObjectPath devicePath(device->ubi());
+    const int servicesCount = device->gattServices().count();
+
+    QList<QDBusObjectPath> services = Autotests::createGattServices(devicePath, 1, 0x300) + Autotests::createGattServices(devicePath, 1, 0x200);
+    QTRY_COMPARE(device->gattServices().count(), servicesCount + 2);
+    const GattDatabase database = device->gattDatabase();
+    const QVector<GattDatabase::Attribute> attributes = database.attributes();
+    for (int i = 1; i < attributes.count(); ++i) {
+        QVERIFY(attributes.at(i - 1).handle < attributes.at(i).handle);
+    }
+    Autotests::removeGattServices(services);
+    QTRY_COMPARE(device->gattServices().count(), servicesCount);
+
+    services = Autotests::createGattServices(devicePath, 2, 0x200);
+    QTRY_COMPARE(device->gattServices().count(), servicesCount + 2);
+    QCOMPARE(device->gattDatabase().hash(), database.hash());
+    Autotests::removeGattServices(services);
+    QTRY_COMPARE(device->gattServices().count(), servicesCount);
+}
+
+void GattDescriptorRemoteTest::gattDatabaseResolvedTest()
+{
+    for (const GattDescriptorRemoteUnit &unit : qAsConst(m_units)) {
+        const DevicePtr device = unit.descriptor->characteristic()->service()->device();
+
+        QSignalSpy resolvedSpy(device.data(), SIGNAL(gattDatabaseResolved(GattDatabase)));
+
+        QVariantMap properties;
+        properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(device->ubi()));
+        properties[QStringLiteral("Name")] = QStringLiteral("ServicesResolved");
+        properties[QStringLiteral("Value")] = true;
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+
+        QTRY_COMPARE(resolvedSpy.count(), 1);
+        const GattDatabase database = resolvedSpy.at(0).at(0).value<GattDatabase>();
+        QCOMPARE(database.attributes().count(), 3);
+        QCOMPARE(database.hash(), device->gattDatabase().hash());
+
+        // Only the transition to resolved is reported
+        properties[QStringLiteral("Value")] = false;
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+        QTRY_VERIFY(!device->isServicesResolved());
+        QCOMPARE(resolvedSpy.count(), 1);
+    }
+}
+
 void GattDescriptorRemoteTest::descriptorRemovedTest()
 {
     for (const GattDescriptorRemoteUnit &unit : qAsConst(m_units)) {
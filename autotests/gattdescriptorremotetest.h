@@ -33,6 +33,9 @@ private Q_SLOTS:
     void readValueTest();
     void writeValueTest();
 
+    void gattDatabaseTest();
+    void gattDatabaseResolvedTest();
+
     void descriptorRemovedTest();
 
 private:
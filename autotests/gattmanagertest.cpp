@@ -6,6 +6,8 @@
 
 #include "gattmanagertest.h"
 #include "autotests.h"
+#include "bluezqt_dbustypes.h"
+#include "dbusproperties_tst.h"
 #include "gattmanager.h"
 #include "gattservice.h"
 #include "initmanagerjob.h"
@@ -13,6 +15,8 @@
 #include "pendingcall.h"
 
 #include <QDBusObjectPath>
+#include <QDBusPendingCall>
+#include <QDBusReply>
 
 namespace BluezQt
 {
@@ -47,6 +51,9 @@ void GattManagerTest::initTestCase()
     m_application = new GattApplication(QStringLiteral("/org/kde/bluezqt"), this);
     auto service = new GattService(QStringLiteral("ad100000-d901-11e8-9f8b-f2801f1b9fd1"), true, m_application);
     m_characteristic = new GattCharacteristic(QStringLiteral("ad10e100-d901-11e8-9f8b-f2801f1b9fd1"), service);
+    m_characteristic->setFlags({QStringLiteral("read"), QStringLiteral("write"), QStringLiteral("notify")});
+    m_descriptor = GattDescriptor::createUserDescription(QStringLiteral("Test characteristic"), m_characteristic);
+    m_descriptor->setFlags({QStringLiteral("read"), QStringLiteral("write")});
     m_adapter->gattManager()->registerApplication(m_application)->waitForFinished();
 
     // Let FakeBluez read local characteristic
@@ -93,4 +100,236 @@ void GattManagerTest::writeCharcTest()
     QTRY_COMPARE(m_characteristic->readValue(), QByteArray("4321"));
 }
 
+void GattManagerTest::writeDescTest()
+{
+    QCOMPARE(m_descriptor->readValue(), QByteArray("Test characteristic"));
+
+    QVariantMap params;
+    params.insert(QStringLiteral("AdapterPath"), QVariant::fromValue(QDBusObjectPath(m_adapter->ubi())));
+    params.insert(QStringLiteral("Value"), QVariant::fromValue(QByteArray("Description")));
+    params.insert(QStringLiteral("Options"), QVariant::fromValue(QVariantMap()));
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:write-desc"), params);
+
+    QTRY_COMPARE(m_descriptor->readValue(), QByteArray("Description"));
+}
+
+static DBusManagerStruct getManagedObjects()
+{
+    // Objects are exported on the same connection, the call is handled locally
+    QDBusConnection connection = QDBusConnection::sessionBus();
+    QDBusMessage call = QDBusMessage::createMethodCall(connection.baseService(),
+                                                       QStringLiteral("/org/kde/bluezqt/app0"),
+                                                       QStringLiteral("org.freedesktop.DBus.ObjectManager"),
+                                                       QStringLiteral("GetManagedObjects"));
+    const QDBusReply<DBusManagerStruct> reply = connection.call(call);
+    return reply.value();
+}
+
+void GattManagerTest::managedObjectsTest()
+{
+    const QDBusObjectPath servicePath(QStringLiteral("/org/kde/bluezqt/app0/service0"));
+    const QDBusObjectPath charcPath(QStringLiteral("/org/kde/bluezqt/app0/service0/char0"));
+    const QDBusObjectPath descPath(QStringLiteral("/org/kde/bluezqt/app0/service0/char0/desc0"));
+
+    DBusManagerStruct objects = getManagedObjects();
+    QCOMPARE(objects.count(), 3);
+    QVERIFY(objects.value(servicePath).contains(QStringLiteral("org.bluez.GattService1")));
+
+    const QVariantMap charcProperties = objects.value(charcPath).value(QStringLiteral("org.bluez.GattCharacteristic1"));
+    QCOMPARE(charcProperties.value(QStringLiteral("UUID")).toString(), m_characteristic->uuid());
+    QCOMPARE(charcProperties.value(QStringLiteral("Flags")).toStringList(), m_characteristic->flags());
+
+    const QVariantMap descProperties = objects.value(descPath).value(QStringLiteral("org.bluez.GattDescriptor1"));
+    QCOMPARE(descProperties.value(QStringLiteral("UUID")).toString(), QStringLiteral("00002901-0000-1000-8000-00805f9b34fb"));
+    QCOMPARE(descProperties.value(QStringLiteral("Characteristic")).value<QDBusObjectPath>(), charcPath);
+
+    // Property values are current even though the object tree is cached
+    m_descriptor->writeValue(QByteArray("Changed"));
+    objects = getManagedObjects();
+    QCOMPARE(objects.value(descPath).value(QStringLiteral("org.bluez.GattDescriptor1")).value(QStringLiteral("Value")).toByteArray(), QByteArray("Changed"));
+}
+
+void GattManagerTest::notifyCharcTest()
+{
+    QSignalSpy notifyingSpy(m_characteristic, SIGNAL(notifyingChanged(bool)));
+    QVariantMap params;
+    params.insert(QStringLiteral("AdapterPath"), QVariant::fromValue(QDBusObjectPath(m_adapter->ubi())));
+
+    // Values are not sent without subscriber
+    QVERIFY(!m_characteristic->isNotifying());
+    m_characteristic->notify(QByteArray("0"));
+    QCOMPARE(m_characteristic->readValue(), QByteArray("0"));
+
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:start-notify-charc"), params);
+    QTRY_COMPARE(notifyingSpy.count(), 1);
+    QVERIFY(m_characteristic->isNotifying());
+
+    // Rapid updates are coalesced into the latest value
+    const quint64 merged = m_characteristic->mergedNotificationsCount();
+    m_characteristic->notify(QByteArray("A"));
+    m_characteristic->notify(QByteArray("B"));
+    m_characteristic->notify(QByteArray("C"));
+    QCOMPARE(m_characteristic->mergedNotificationsCount(), merged + 2);
+    QTest::qWait(0);
+
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:report-notify-count"), params);
+    QTRY_COMPARE(m_characteristic->readValue(), QByteArray("1"));
+
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:stop-notify-charc"), params);
+    QTRY_COMPARE(notifyingSpy.count(), 2);
+    QVERIFY(!m_characteristic->isNotifying());
+}
+
+void GattManagerTest::notifyNotSupportedTest()
+{
+    // Calls go through the bus daemon from another connection, like from BlueZ
+    const QString connectionName = QStringLiteral("gattmanagertest");
+    QDBusConnection connection = QDBusConnection::connectToBus(QDBusConnection::SessionBus, connectionName);
+    const QString service = QDBusConnection::sessionBus().baseService();
+    const QString charcPath = QStringLiteral("/org/kde/bluezqt/app0/service0/char0");
+
+    QDBusMessage startNotify = QDBusMessage::createMethodCall(service, charcPath, QStringLiteral("org.bluez.GattCharacteristic1"), QStringLiteral("StartNotify"));
+    QDBusMessage stopNotify = QDBusMessage::createMethodCall(service, charcPath, QStringLiteral("org.bluez.GattCharacteristic1"), QStringLiteral("StopNotify"));
+
+    // Subscription is refused without notify or indicate flag
+    const QStringList flags = m_characteristic->flags();
+    m_characteristic->setFlags({QStringLiteral("read")});
+
+    QDBusPendingCall call = connection.asyncCall(startNotify);
+    QTRY_VERIFY(call.isFinished());
+    QVERIFY(call.isError());
+    QCOMPARE(call.error().name(), QStringLiteral("org.bluez.Error.NotSupported"));
+    QVERIFY(!m_characteristic->isNotifying());
+
+    // Accepted subscription is announced with PropertiesChanged
+    m_characteristic->setFlags(flags);
+    org::freedesktop::DBus::Properties properties(service, charcPath, connection);
+    QSignalSpy propertiesSpy(&properties, SIGNAL(PropertiesChanged(QString, QVariantMap, QStringList)));
+
+    call = connection.asyncCall(startNotify);
+    QTRY_VERIFY(call.isFinished());
+    QVERIFY(!call.isError());
+    QVERIFY(m_characteristic->isNotifying());
+    QTRY_COMPARE(propertiesSpy.count(), 1);
+    Autotests::verifyPropertiesChangedSignal(propertiesSpy, QStringLiteral("Notifying"), true);
+
+    call = connection.asyncCall(stopNotify);
+    QTRY_VERIFY(call.isFinished());
+    QVERIFY(!m_characteristic->isNotifying());
+    QTRY_COMPARE(propertiesSpy.count(), 2);
+
+    QDBusConnection::disconnectFromBus(connectionName);
+}
+
+void GattManagerTest::acquireWriteCharcTest()
+{
+    QVariantMap params;
+    params.insert(QStringLiteral("AdapterPath"), QVariant::fromValue(QDBusObjectPath(m_adapter->ubi())));
+
+    QVERIFY(!m_characteristic->writeDevice());
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:acquire-write-charc"), params);
+    QTRY_VERIFY(m_characteristic->writeDevice());
+
+    QIODevice *device = m_characteristic->writeDevice();
+    QSignalSpy readyReadSpy(device, SIGNAL(readyRead()));
+
+    // Each read returns one written value
+    params.insert(QStringLiteral("Value"), QByteArray("SOCKET1"));
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:write-acquired-charc"), params);
+    params.insert(QStringLiteral("Value"), QByteArray("SOCKET2"));
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:write-acquired-charc"), params);
+
+    QTRY_VERIFY(readyReadSpy.count() >= 1);
+    QCOMPARE(device->read(512), QByteArray("SOCKET1"));
+    QTRY_COMPARE(device->read(512), QByteArray("SOCKET2"));
+}
+
+void GattManagerTest::acquireNotifyCharcTest()
+{
+    QSignalSpy notifyingSpy(m_characteristic, SIGNAL(notifyingChanged(bool)));
+    QVariantMap params;
+    params.insert(QStringLiteral("AdapterPath"), QVariant::fromValue(QDBusObjectPath(m_adapter->ubi())));
+
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:acquire-notify-charc"), params);
+    QTRY_VERIFY(m_characteristic->notifyDevice());
+    QTRY_COMPARE(notifyingSpy.count(), 1);
+    QVERIFY(m_characteristic->isNotifying());
+
+    // Values are written to the socket without coalescing
+    for (int i = 0; i < 10; ++i) {
+        QVERIFY(m_characteristic->notify(QByteArray::number(i)));
+    }
+
+    // Values larger than MTU minus ATT header are not sent
+    QVERIFY(!m_characteristic->notify(QByteArray(510, 'X')));
+    QVERIFY(m_characteristic->notify(QByteArray(509, 'X')));
+
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:report-notify-count"), params);
+    QTRY_COMPARE(m_characteristic->readValue(), QByteArray("11"));
+
+    // BlueZ closing the socket stops notifications
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:release-notify-charc"), params);
+    QTRY_COMPARE(notifyingSpy.count(), 2);
+    QVERIFY(!m_characteristic->isNotifying());
+    QVERIFY(!m_characteristic->notifyDevice());
+}
+
+void GattManagerTest::notifyBenchmark_data()
+{
+    QTest::addColumn<bool>("coalesced");
+    QTest::addColumn<bool>("acquired");
+
+    QTest::newRow("every update") << false << false;
+    QTest::newRow("coalesced") << true << false;
+    QTest::newRow("acquired socket") << true << true;
+}
+
+void GattManagerTest::notifyBenchmark()
+{
+    QFETCH(bool, coalesced);
+    QFETCH(bool, acquired);
+
+    const int count = 1000;
+    QVariantMap params;
+    params.insert(QStringLiteral("AdapterPath"), QVariant::fromValue(QDBusObjectPath(m_adapter->ubi())));
+
+    if (acquired) {
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:acquire-notify-charc"), params);
+        QTRY_VERIFY(m_characteristic->notifyDevice());
+    } else {
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:start-notify-charc"), params);
+    }
+    QTRY_VERIFY(m_characteristic->isNotifying());
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < count; ++i) {
+            QVERIFY(m_characteristic->notify(QByteArray("N") + QByteArray::number(i)));
+            if (!coalesced) {
+                QTest::qWait(0);
+            }
+        }
+        QTest::qWait(0);
+        if (acquired) {
+            QTRY_COMPARE(m_characteristic->notifyDevice()->bytesToWrite(), qint64(0));
+        }
+
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:report-notify-count"), params);
+        QTRY_COMPARE(m_characteristic->readValue(), QByteArray::number(coalesced && !acquired ? 1 : count));
+    }
+
+    if (acquired) {
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:release-notify-charc"), params);
+    } else {
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-gattmanager:stop-notify-charc"), params);
+    }
+    QTRY_VERIFY(!m_characteristic->isNotifying());
+}
+
+void GattManagerTest::managedObjectsBenchmark()
+{
+    QBENCHMARK {
+        getManagedObjects();
+    }
+}
+
 QTEST_MAIN(GattManagerTest)
@@ -9,6 +9,7 @@
 #include "adapter.h"
 #include "gattapplication.h"
 #include "gattcharacteristic.h"
+#include "gattdescriptor.h"
 
 class GattManagerTest : public QObject
 {
@@ -20,9 +21,21 @@ private Q_SLOTS:
 
     void readCharcTest();
     void writeCharcTest();
+    void writeDescTest();
+    void managedObjectsTest();
+    void notifyCharcTest();
+    void notifyNotSupportedTest();
+    void acquireWriteCharcTest();
+    void acquireNotifyCharcTest();
+
+    void notifyBenchmark_data();
+    void notifyBenchmark();
+
+    void managedObjectsBenchmark();
 
 private:
     BluezQt::GattApplication *m_application;
     BluezQt::GattCharacteristic *m_characteristic;
+    BluezQt::GattDescriptor *m_descriptor;
     BluezQt::AdapterPtr m_adapter;
 };
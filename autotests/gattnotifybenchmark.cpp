@@ -0,0 +1,242 @@
+/*
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "gattnotifybenchmark.h"
+#include "autotests.h"
+#include "device.h"
+#include "gattserviceremote.h"
+#include "initmanagerjob.h"
+#include "pendingcall.h"
+#include "tpendingcall.h"
+
+#include <QDBusUnixFileDescriptor>
+#include <QDeadlineTimer>
+#include <QSignalSpy>
+#include <QTest>
+#include <QtEndian>
+
+#include <algorithm>
+#include <ctime>
+
+namespace BluezQt
+{
+extern void bluezqt_initFakeBluezTestRun();
+}
+
+using namespace BluezQt;
+
+// Notifications carry their send time (CLOCK_MONOTONIC ns) in the first 8 bytes
+static qint64 notificationLatency(const QByteArray &value)
+{
+    if (value.size() < int(sizeof(qint64))) {
+        return -1;
+    }
+    const qint64 sent = qFromLittleEndian<qint64>(value.constData());
+    return QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs() - sent;
+}
+
+static qint64 percentile(const QVector<qint64> &sorted, double p)
+{
+    if (sorted.isEmpty()) {
+        return 0;
+    }
+    return sorted.at(qMin(sorted.size() - 1, int(p * sorted.size())));
+}
+
+GattNotifyBenchmark::GattNotifyBenchmark()
+    : m_manager(nullptr)
+{
+    Autotests::registerMetatypes();
+}
+
+void GattNotifyBenchmark::initTestCase()
+{
+    bluezqt_initFakeBluezTestRun();
+
+    FakeBluez::start();
+    FakeBluez::runTest(QStringLiteral("bluez-standard"));
+
+    QVariantMap adapterProps;
+    adapterProps[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(QStringLiteral("/org/bluez/hci0")));
+    adapterProps[QStringLiteral("Address")] = QStringLiteral("1C:E5:C3:BC:94:7E");
+    adapterProps[QStringLiteral("Name")] = QStringLiteral("TestAdapter");
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-adapter"), adapterProps);
+
+    QVariantMap deviceProps;
+    deviceProps[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath("/org/bluez/hci0/dev_40_79_6A_0C_39_75"));
+    deviceProps[QStringLiteral("Adapter")] = QVariant::fromValue(QDBusObjectPath("/org/bluez/hci0"));
+    deviceProps[QStringLiteral("Address")] = QStringLiteral("40:79:6A:0C:39:75");
+    deviceProps[QStringLiteral("Name")] = QStringLiteral("TestDevice");
+    deviceProps[QStringLiteral("UUIDs")] = QStringList();
+    deviceProps[QStringLiteral("Connected")] = true;
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-device"), deviceProps);
+
+    QVariantMap serviceProps;
+    serviceProps[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath("/org/bluez/hci0/dev_40_79_6A_0C_39_75/service0"));
+    serviceProps[QStringLiteral("UUID")] = QStringLiteral("0000180D-0000-1000-8000-00805F9B34FB");
+    serviceProps[QStringLiteral("Primary")] = true;
+    serviceProps[QStringLiteral("Device")] = QVariant::fromValue(QDBusObjectPath("/org/bluez/hci0/dev_40_79_6A_0C_39_75"));
+    serviceProps[QStringLiteral("Includes")] = QVariant::fromValue(QList<QDBusObjectPath>());
+    serviceProps[QStringLiteral("Handle")] = QVariant::fromValue(qint16(1));
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-gatt-service"), serviceProps);
+
+    QVariantMap charProps;
+    charProps[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath("/org/bluez/hci0/dev_40_79_6A_0C_39_75/service0/char0"));
+    charProps[QStringLiteral("UUID")] = QStringLiteral("00002A37-0000-1000-8000-00805F9B34FB");
+    charProps[QStringLiteral("Service")] = QVariant::fromValue(QDBusObjectPath("/org/bluez/hci0/dev_40_79_6A_0C_39_75/service0"));
+    charProps[QStringLiteral("Value")] = QVariant::fromValue(QByteArray());
+    charProps[QStringLiteral("Notifying")] = false;
+    charProps[QStringLiteral("Flags")] = QStringList({QStringLiteral("read"), QStringLiteral("write-without-response"), QStringLiteral("notify")});
+    charProps[QStringLiteral("Handle")] = QVariant::fromValue(qint16(2));
+    charProps[QStringLiteral("MTU")] = QVariant::fromValue(qint16(247));
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-gatt-characteristic"), charProps);
+
+    m_manager = new Manager();
+    InitManagerJob *initJob = m_manager->init();
+    initJob->exec();
+    QVERIFY(!initJob->error());
+
+    QCOMPARE(m_manager->devices().count(), 1);
+    const DevicePtr device = m_manager->devices().first();
+    QCOMPARE(device->gattServices().count(), 1);
+    QCOMPARE(device->gattServices().first()->characteristics().count(), 1);
+    m_characteristic = device->gattServices().first()->characteristics().first();
+}
+
+void GattNotifyBenchmark::cleanupTestCase()
+{
+    m_characteristic.clear();
+    delete m_manager;
+
+    FakeBluez::stop();
+}
+
+void GattNotifyBenchmark::acquiredStateTest()
+{
+    QSignalSpy writeAcquiredSpy(m_characteristic.data(), SIGNAL(writeAcquiredChanged(bool)));
+    QSignalSpy notifyAcquiredSpy(m_characteristic.data(), SIGNAL(notifyAcquiredChanged(bool)));
+
+    QVERIFY(!m_characteristic->isWriteAcquired());
+    QVERIFY(!m_characteristic->isNotifyAcquired());
+
+    // Both acquire modes are tracked independently
+    TPendingCall<QDBusUnixFileDescriptor, uint16_t> *notifyCall = m_characteristic->acquireNotify({});
+    notifyCall->waitForFinished();
+    QVERIFY(!notifyCall->error());
+    QTRY_COMPARE(notifyAcquiredSpy.count(), 1);
+    QVERIFY(m_characteristic->isNotifyAcquired());
+    QVERIFY(!m_characteristic->isWriteAcquired());
+    QCOMPARE(writeAcquiredSpy.count(), 0);
+
+    TPendingCall<QDBusUnixFileDescriptor, uint16_t> *writeCall = m_characteristic->acquireWrite({});
+    writeCall->waitForFinished();
+    QVERIFY(!writeCall->error());
+    QTRY_COMPARE(writeAcquiredSpy.count(), 1);
+    QVERIFY(m_characteristic->isWriteAcquired());
+    QVERIFY(m_characteristic->isNotifyAcquired());
+
+    m_characteristic->releaseNotify();
+    QTRY_COMPARE(notifyAcquiredSpy.count(), 2);
+    QVERIFY(!m_characteristic->isNotifyAcquired());
+    QVERIFY(m_characteristic->isWriteAcquired());
+
+    m_characteristic->releaseWrite();
+    QTRY_COMPARE(writeAcquiredSpy.count(), 2);
+    QVERIFY(!m_characteristic->isWriteAcquired());
+    QCOMPARE(notifyAcquiredSpy.count(), 2);
+}
+
+void GattNotifyBenchmark::notifyRateBenchmark_data()
+{
+    QTest::addColumn<bool>("socket");
+    QTest::addColumn<bool>("buffered");
+    QTest::addColumn<int>("rate");
+
+    for (int rate : {1000, 10000}) {
+        QTest::newRow(qPrintable(QStringLiteral("dbus-%1").arg(rate))) << false << false << rate;
+        QTest::newRow(qPrintable(QStringLiteral("dbus-buffered-%1").arg(rate))) << false << true << rate;
+        QTest::newRow(qPrintable(QStringLiteral("socket-%1").arg(rate))) << true << false << rate;
+        QTest::newRow(qPrintable(QStringLiteral("socket-buffered-%1").arg(rate))) << true << true << rate;
+    }
+}
+
+void GattNotifyBenchmark::notifyRateBenchmark()
+{
+    QFETCH(bool, socket);
+    QFETCH(bool, buffered);
+    QFETCH(int, rate);
+
+    // Half a second of sustained notifications
+    const int count = rate / 2;
+
+    if (socket) {
+        TPendingCall<QDBusUnixFileDescriptor, uint16_t> *call = m_characteristic->acquireNotify({});
+        call->waitForFinished();
+        QVERIFY(!call->error());
+        QTRY_VERIFY(m_characteristic->isNotifyAcquired());
+    } else {
+        PendingCall *call = m_characteristic->startNotify();
+        call->waitForFinished();
+        QVERIFY(!call->error());
+    }
+
+    QVector<qint64> latencies;
+    latencies.reserve(count);
+
+    m_characteristic->setNotificationBufferSize(buffered ? count : 0);
+    QMetaObject::Connection connection;
+    if (buffered) {
+        connection = connect(m_characteristic.data(), &GattCharacteristicRemote::notificationsAvailable, this, [this, &latencies]() {
+            const QVector<GattCharacteristicRemote::Notification> notifications = m_characteristic->takeNotifications();
+            for (const GattCharacteristicRemote::Notification &notification : notifications) {
+                latencies.append(notificationLatency(notification.value));
+            }
+        });
+    } else {
+        connection = connect(m_characteristic.data(), &GattCharacteristicRemote::valueChanged, this, [&latencies](const QByteArray &value) {
+            latencies.append(notificationLatency(value));
+        });
+    }
+
+    QVariantMap properties;
+    properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(m_characteristic->ubi()));
+    properties[QStringLiteral("Value")] = QByteArray(20, 'x');
+    properties[QStringLiteral("Count")] = count;
+    properties[QStringLiteral("Rate")] = rate;
+    properties[QStringLiteral("Timestamp")] = true;
+
+    // Process CPU time only, fakebluez runs in its own process
+    const std::clock_t cpuStart = std::clock();
+
+    QBENCHMARK_ONCE {
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("notify-gatt-characteristic"), properties);
+        QTRY_COMPARE_WITH_TIMEOUT(latencies.count(), count, 30000);
+    }
+
+    const double cpuNs = double(std::clock() - cpuStart) * 1e9 / CLOCKS_PER_SEC;
+
+    disconnect(connection);
+    m_characteristic->setNotificationBufferSize(0);
+
+    if (socket) {
+        m_characteristic->releaseNotify();
+        QTRY_VERIFY(!m_characteristic->isNotifyAcquired());
+    } else {
+        m_characteristic->stopNotify()->waitForFinished();
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    QVERIFY(latencies.first() >= 0);
+
+    qInfo().noquote() << QStringLiteral("%1: %2 notifications, CPU %3 us/notification, latency p50 %4 us, p90 %5 us, p99 %6 us, max %7 us")
+                             .arg(QString::fromLatin1(QTest::currentDataTag()))
+                             .arg(count)
+                             .arg(cpuNs / count / 1000.0, 0, 'f', 2)
+                             .arg(percentile(latencies, 0.50) / 1000)
+                             .arg(percentile(latencies, 0.90) / 1000)
+                             .arg(percentile(latencies, 0.99) / 1000)
+                             .arg(latencies.last() / 1000);
+}
+
+QTEST_MAIN(GattNotifyBenchmark)
@@ -0,0 +1,34 @@
+/*
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#ifndef GATTNOTIFYBENCHMARK_H
+#define GATTNOTIFYBENCHMARK_H
+
+#include <QObject>
+
+#include "gattcharacteristicremote.h"
+#include "manager.h"
+
+class GattNotifyBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GattNotifyBenchmark();
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void acquiredStateTest();
+
+    void notifyRateBenchmark_data();
+    void notifyRateBenchmark();
+
+private:
+    BluezQt::Manager *m_manager;
+    BluezQt::GattCharacteristicRemotePtr m_characteristic;
+};
+
+#endif // GATTNOTIFYBENCHMARK_H
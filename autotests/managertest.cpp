@@ -8,6 +8,8 @@
 #include "adapter.h"
 #include "autotests.h"
 #include "device.h"
+#include "devicesmodel.h"
+#include "gattserviceremote.h"
 #include "initmanagerjob.h"
 #include "manager.h"
 
@@ -15,6 +17,20 @@
 #include <QSignalSpy>
 #include <QTest>
 
+#ifdef __GLIBC__
+#include <malloc.h>
+
+static qint64 heapInUse()
+{
+#if __GLIBC_PREREQ(2, 33)
+    return qint64(mallinfo2().uordblks);
+#else
+    // Fields are int before glibc 2.33
+    return qint64(mallinfo().uordblks);
+#endif
+}
+#endif
+
 namespace BluezQt
 {
 extern void bluezqt_initFakeBluezTestRun();
@@ -444,4 +460,234 @@ void ManagerTest::bug377405()
     QTRY_COMPARE(manager->isBluetoothOperational(), true);
 }
 
+void ManagerTest::devicesModelBatchTest()
+{
+    // Devices removed together with adapter are removed from model in one range
+
+    FakeBluez::start();
+    FakeBluez::runTest(QStringLiteral("bluez-standard"));
+    Autotests::createDevices(Autotests::createAdapter(), 20);
+
+    Manager *manager = new Manager;
+
+    InitManagerJob *job = manager->init();
+    job->exec();
+
+    QVERIFY(!job->error());
+
+    DevicesModel *model = new DevicesModel(manager);
+    QCOMPARE(model->rowCount(), 20);
+
+    QSignalSpy rowsRemovedSpy(model, SIGNAL(rowsRemoved(QModelIndex, int, int)));
+    QSignalSpy deviceRemovedSpy(manager, SIGNAL(deviceRemoved(DevicePtr)));
+
+    QVariantMap properties;
+    properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(QStringLiteral("/org/bluez/hci0")));
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("remove-adapter"), properties);
+
+    QTRY_COMPARE(deviceRemovedSpy.count(), 20);
+    QTRY_COMPARE(rowsRemovedSpy.count(), 1);
+    QCOMPARE(rowsRemovedSpy.at(0).at(1).toInt(), 0);
+    QCOMPARE(rowsRemovedSpy.at(0).at(2).toInt(), 19);
+    QCOMPARE(model->rowCount(), 0);
+
+    delete model;
+    delete manager;
+}
+
+void ManagerTest::forEachDeviceTest()
+{
+    FakeBluez::start();
+    FakeBluez::runTest(QStringLiteral("bluez-standard"));
+    Autotests::createDevices(Autotests::createAdapter(), 10);
+
+    Manager *manager = new Manager;
+
+    InitManagerJob *job = manager->init();
+    job->exec();
+
+    QVERIFY(!job->error());
+
+    const QList<DevicePtr> devices = manager->devices();
+    QCOMPARE(devices.count(), 10);
+
+    QList<DevicePtr> visited;
+    manager->forEachDevice([&visited](const DevicePtr &device) {
+        visited.append(device);
+    });
+    QCOMPARE(visited, devices);
+
+    AdapterPtr adapter = manager->adapters().first();
+    visited.clear();
+    adapter->forEachDevice([&visited](const DevicePtr &device) {
+        visited.append(device);
+    });
+    QCOMPARE(visited.count(), 10);
+
+    int adaptersCount = 0;
+    manager->forEachAdapter([&adaptersCount](const AdapterPtr &) {
+        ++adaptersCount;
+    });
+    QCOMPARE(adaptersCount, 1);
+
+    // Removing devices keeps the order of the others
+    QSignalSpy deviceRemovedSpy(manager, SIGNAL(deviceRemoved(DevicePtr)));
+
+    for (int i : {4, 0, 9}) {
+        QVariantMap properties;
+        properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(devices.at(i)->ubi()));
+        FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("remove-device"), properties);
+    }
+
+    QTRY_COMPARE(deviceRemovedSpy.count(), 3);
+    const QList<DevicePtr> remaining = devices.mid(1, 3) + devices.mid(5, 4);
+    QCOMPARE(manager->devices(), remaining);
+    QCOMPARE(adapter->devices(), remaining);
+
+    delete manager;
+}
+
+void ManagerTest::interfacesAddedBenchmark_data()
+{
+    QTest::addColumn<int>("devicesCount");
+
+    QTest::newRow("10 devices") << 10;
+    QTest::newRow("100 devices") << 100;
+    QTest::newRow("1000 devices") << 1000;
+}
+
+void ManagerTest::interfacesAddedBenchmark()
+{
+    // Routing of InterfacesAdded for GATT objects should not depend on number of known devices
+
+    QFETCH(int, devicesCount);
+
+    FakeBluez::start();
+    FakeBluez::runTest(QStringLiteral("bluez-standard"));
+    Autotests::createDevices(Autotests::createAdapter(), devicesCount);
+
+    Manager *manager = new Manager;
+
+    InitManagerJob *job = manager->init();
+    job->exec();
+
+    QVERIFY(!job->error());
+    QCOMPARE(manager->devices().count(), devicesCount);
+
+    DevicePtr device = manager->devices().first();
+    QSignalSpy serviceAddedSpy(device.data(), SIGNAL(gattServiceAdded(GattServiceRemotePtr)));
+
+    const int servicesCount = 50;
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < servicesCount; ++i) {
+            const QString servicePath = device->ubi() + QStringLiteral("/service%1").arg(i, 4, 16, QLatin1Char('0'));
+
+            QVariantMap serviceProps;
+            serviceProps[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(servicePath));
+            serviceProps[QStringLiteral("UUID")] = QStringLiteral("04FA28C0-2D0C-11EC-8D3D-0242AC130003");
+            serviceProps[QStringLiteral("Primary")] = true;
+            serviceProps[QStringLiteral("Device")] = QVariant::fromValue(QDBusObjectPath(device->ubi()));
+            FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-gatt-service"), serviceProps);
+
+            QVariantMap characteristicProps;
+            characteristicProps[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(servicePath + QStringLiteral("/char0001")));
+            characteristicProps[QStringLiteral("UUID")] = QStringLiteral("04FA28C0-2D0C-11EC-8D3D-0242AC130004");
+            characteristicProps[QStringLiteral("Service")] = QVariant::fromValue(QDBusObjectPath(servicePath));
+            FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-gatt-characteristic"), characteristicProps);
+        }
+
+        QTRY_COMPARE(serviceAddedSpy.count(), servicesCount);
+        QTRY_COMPARE(device->gattServices().last()->characteristics().count(), 1);
+    }
+
+    delete manager;
+}
+
+void ManagerTest::devicesModelBenchmark_data()
+{
+    QTest::addColumn<int>("devicesCount");
+
+    QTest::newRow("10 devices") << 10;
+    QTest::newRow("100 devices") << 100;
+    QTest::newRow("1000 devices") << 1000;
+}
+
+void ManagerTest::devicesModelBenchmark()
+{
+    // Updating a device row should not depend on number of devices in the model
+
+    QFETCH(int, devicesCount);
+
+    FakeBluez::start();
+    FakeBluez::runTest(QStringLiteral("bluez-standard"));
+    Autotests::createDevices(Autotests::createAdapter(), devicesCount);
+
+    Manager *manager = new Manager;
+
+    InitManagerJob *job = manager->init();
+    job->exec();
+
+    QVERIFY(!job->error());
+
+    DevicesModel *model = new DevicesModel(manager);
+    QCOMPARE(model->rowCount(), devicesCount);
+
+    const QModelIndex lastIndex = model->index(devicesCount - 1, 0);
+    DevicePtr device = model->device(lastIndex);
+    QSignalSpy dataChangedSpy(model, SIGNAL(dataChanged(QModelIndex, QModelIndex, QVector<int>)));
+
+    // One change through fakebluez, so that the device has changed properties to report
+    QVariantMap properties;
+    properties[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(device->ubi()));
+    properties[QStringLiteral("Name")] = QStringLiteral("RSSI");
+    properties[QStringLiteral("Value")] = QVariant::fromValue(qint16(-51));
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("change-device-property"), properties);
+    QTRY_COMPARE(dataChangedSpy.count(), 1);
+
+    const int changesCount = 1000;
+
+    // Emitted directly to only measure the row lookup in the model
+    QBENCHMARK {
+        for (int i = 0; i < changesCount; ++i) {
+            Q_EMIT manager->deviceChanged(device);
+        }
+    }
+
+    QVERIFY(dataChangedSpy.count() > changesCount);
+    QCOMPARE(dataChangedSpy.last().at(0).toModelIndex(), lastIndex);
+
+    delete model;
+    delete manager;
+}
+
+void ManagerTest::deviceFootprintBenchmark()
+{
+    // Heap used per known device, D-Bus interfaces are only created when needed
+#ifndef __GLIBC__
+    QSKIP("Heap usage is only measured with glibc");
+#else
+    const int devicesCount = 1000;
+
+    FakeBluez::start();
+    FakeBluez::runTest(QStringLiteral("bluez-standard"));
+    Autotests::createDevices(Autotests::createAdapter(), devicesCount);
+
+    Manager *manager = new Manager;
+
+    const qint64 heapBefore = heapInUse();
+
+    InitManagerJob *job = manager->init();
+    job->exec();
+
+    QVERIFY(!job->error());
+    QCOMPARE(manager->devices().count(), devicesCount);
+
+    const qint64 heapAfter = heapInUse();
+    QTest::setBenchmarkResult(qreal(heapAfter - heapBefore) / devicesCount, QTest::BytesAllocated);
+
+    delete manager;
+#endif
+}
+
 QTEST_MAIN(ManagerTest)
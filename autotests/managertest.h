@@ -28,6 +28,16 @@ private Q_SLOTS:
     void adapterWithDevicesRemovedTest();
     void bug364416();
     void bug377405();
+    void devicesModelBatchTest();
+    void forEachDeviceTest();
+
+    void interfacesAddedBenchmark_data();
+    void interfacesAddedBenchmark();
+
+    void devicesModelBenchmark_data();
+    void devicesModelBenchmark();
+
+    void deviceFootprintBenchmark();
 };
 
 #endif // MANAGERTEST_H
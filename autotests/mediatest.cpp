@@ -11,6 +11,7 @@
 #include "manager.h"
 #include "media.h"
 #include "pendingcall.h"
+#include "request.h"
 
 #include <QDBusObjectPath>
 #include <QSignalSpy>
@@ -20,8 +21,36 @@ namespace BluezQt
 extern void bluezqt_initFakeBluezTestRun();
 }
 
+Q_DECLARE_METATYPE(BluezQt::MediaEndpoint::ChannelMode)
+Q_DECLARE_METATYPE(BluezQt::MediaEndpoint::Codec)
+Q_DECLARE_METATYPE(BluezQt::MediaEndpoint::Preference)
+
 using namespace BluezQt;
 
+static QByteArray sbcCapabilitiesData(quint8 frequency, quint8 channelMode, quint8 blockLength, quint8 subbands, quint8 minBitpool, quint8 maxBitpool)
+{
+    a2dp_sbc_t sbc = a2dp_sbc_t();
+    sbc.frequency = frequency;
+    sbc.channel_mode = channelMode;
+    sbc.block_length = blockLength;
+    sbc.subbands = subbands;
+    sbc.allocation_method = SBC_ALLOCATION_LOUDNESS;
+    sbc.min_bitpool = minBitpool;
+    sbc.max_bitpool = maxBitpool;
+    return QByteArray(reinterpret_cast<const char *>(&sbc), sizeof(sbc));
+}
+
+static QByteArray aacCapabilitiesData(quint8 objectType, quint16 frequency, quint8 channels, bool vbr, quint32 bitrate)
+{
+    a2dp_aac_t aac = a2dp_aac_t();
+    aac.object_type = objectType;
+    AAC_SET_FREQUENCY(aac, frequency);
+    aac.channels = channels;
+    aac.vbr = vbr;
+    AAC_SET_BITRATE(aac, bitrate);
+    return QByteArray(reinterpret_cast<const char *>(&aac), sizeof(aac));
+}
+
 void TestEndpoint::release()
 {
     m_releaseCalled = true;
@@ -107,6 +136,213 @@ void MediaTest::selectConfigurationTest()
     QCOMPARE(args.at(1).toByteArray(), QByteArray());
 }
 
+void MediaTest::selectSbcConfigurationTest_data()
+{
+    QTest::addColumn<int>("bitrate");
+    QTest::addColumn<int>("packetLatency");
+    QTest::addColumn<MediaEndpoint::ChannelMode>("channelMode");
+    QTest::addColumn<QByteArray>("capabilities");
+    QTest::addColumn<QByteArray>("configuration");
+
+    a2dp_sbc_t sink = sbcCapabilities;
+    sink.channel_mode |= SBC_CHANNEL_MODE_MONO | SBC_CHANNEL_MODE_DUAL_CHANNEL;
+    const QByteArray all(reinterpret_cast<const char *>(&sink), sizeof(sink));
+    const auto stereo = MediaEndpoint::ChannelMode::Stereo;
+
+    QTest::newRow("default") << 0 << 0 << stereo << all
+                             << sbcCapabilitiesData(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, 2, 53);
+    QTest::newRow("maximum-bitpool") << 1000000 << 0 << stereo << all
+                                     << sbcCapabilitiesData(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, 2, 64);
+    QTest::newRow("bitrate-200000") << 200000 << 0 << stereo << all
+                                    << sbcCapabilitiesData(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, 2, 30);
+    QTest::newRow("bitrate-below-minimum") << 1000 << 0 << stereo << all
+                                           << sbcCapabilitiesData(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, 2, 2);
+    QTest::newRow("joint-stereo") << 0 << 0 << MediaEndpoint::ChannelMode::JointStereo << all
+                                  << sbcCapabilitiesData(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_JOINT_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, 2, 53);
+    QTest::newRow("mono-64000") << 64000 << 0 << MediaEndpoint::ChannelMode::Mono << all
+                                << sbcCapabilitiesData(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_MONO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, 2, 7);
+    QTest::newRow("mono-not-supported") << 0 << 0 << MediaEndpoint::ChannelMode::Mono
+                                        << sbcCapabilitiesData(SBC_SAMPLING_FREQ_44100,
+                                                               SBC_CHANNEL_MODE_STEREO | SBC_CHANNEL_MODE_JOINT_STEREO,
+                                                               SBC_BLOCK_LENGTH_16,
+                                                               SBC_SUBBANDS_8,
+                                                               2,
+                                                               64)
+                                        << sbcCapabilitiesData(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, 2, 53);
+    QTest::newRow("latency-10ms") << 0 << 10000 << stereo << all
+                                  << sbcCapabilitiesData(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_4, 2, 53);
+    QTest::newRow("latency-6ms") << 0 << 6000 << stereo << all
+                                 << sbcCapabilitiesData(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_4, SBC_SUBBANDS_4, 2, 53);
+    QTest::newRow("latency-unreachable") << 0 << 1000 << stereo << all
+                                         << sbcCapabilitiesData(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_4, SBC_SUBBANDS_4, 2, 53);
+    QTest::newRow("remote-max-bitpool") << 0 << 0 << stereo
+                                        << sbcCapabilitiesData(SBC_SAMPLING_FREQ_48000, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, 10, 35)
+                                        << sbcCapabilitiesData(SBC_SAMPLING_FREQ_48000, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, 10, 35);
+    QTest::newRow("no-common-bitpool") << 0 << 0 << stereo
+                                       << sbcCapabilitiesData(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, 70, 80)
+                                       << QByteArray();
+    QTest::newRow("no-common-frequency") << 0 << 0 << stereo
+                                         << sbcCapabilitiesData(SBC_SAMPLING_FREQ_16000, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, 2, 53)
+                                         << QByteArray();
+}
+
+void MediaTest::selectSbcConfigurationTest()
+{
+    QFETCH(int, bitrate);
+    QFETCH(int, packetLatency);
+    QFETCH(MediaEndpoint::ChannelMode, channelMode);
+    QFETCH(QByteArray, capabilities);
+    QFETCH(QByteArray, configuration);
+
+    MediaEndpoint endpoint({MediaEndpoint::Role::AudioSink, MediaEndpoint::Codec::Sbc});
+    endpoint.setBitrate(bitrate);
+    endpoint.setPacketLatency(packetLatency);
+    endpoint.setChannelMode(channelMode);
+    QSignalSpy endpointSpy(&endpoint, SIGNAL(configurationSelected(QByteArray, QByteArray)));
+
+    endpoint.selectConfiguration(capabilities, Request<QByteArray>());
+    QCOMPARE(endpointSpy.count(), 1);
+    QCOMPARE(endpointSpy.first().at(1).toByteArray(), configuration);
+}
+
+void MediaTest::sbcChannelModesTest()
+{
+    MediaEndpoint source({MediaEndpoint::Role::AudioSource, MediaEndpoint::Codec::Sbc});
+    MediaEndpoint sink({MediaEndpoint::Role::AudioSink, MediaEndpoint::Codec::Sbc});
+
+    const QByteArray sourceCapabilities = source.properties().value(QStringLiteral("Capabilities")).toByteArray();
+    const QByteArray sinkCapabilities = sink.properties().value(QStringLiteral("Capabilities")).toByteArray();
+    QCOMPARE(int(reinterpret_cast<const a2dp_sbc_t *>(sourceCapabilities.constData())->channel_mode),
+             SBC_CHANNEL_MODE_STEREO | SBC_CHANNEL_MODE_JOINT_STEREO);
+    QCOMPARE(int(reinterpret_cast<const a2dp_sbc_t *>(sinkCapabilities.constData())->channel_mode),
+             SBC_CHANNEL_MODE_MONO | SBC_CHANNEL_MODE_DUAL_CHANNEL | SBC_CHANNEL_MODE_STEREO | SBC_CHANNEL_MODE_JOINT_STEREO);
+
+    // Source never sends mono, even if preferred and supported by remote sink
+    source.setChannelMode(MediaEndpoint::ChannelMode::Mono);
+    QSignalSpy endpointSpy(&source, SIGNAL(configurationSelected(QByteArray, QByteArray)));
+
+    source.selectConfiguration(sinkCapabilities, Request<QByteArray>());
+    QCOMPARE(endpointSpy.count(), 1);
+    const QByteArray configuration = endpointSpy.first().at(1).toByteArray();
+    QCOMPARE(int(reinterpret_cast<const a2dp_sbc_t *>(configuration.constData())->channel_mode), SBC_CHANNEL_MODE_STEREO);
+}
+
+void MediaTest::selectAacConfigurationTest_data()
+{
+    QTest::addColumn<MediaEndpoint::Preference>("preference");
+    QTest::addColumn<QByteArray>("capabilities");
+    QTest::addColumn<QByteArray>("configuration");
+
+    const quint8 allObjectTypes = AAC_OBJECT_TYPE_MPEG2_AAC_LC | AAC_OBJECT_TYPE_MPEG4_AAC_LC | AAC_OBJECT_TYPE_MPEG4_AAC_LTP | AAC_OBJECT_TYPE_MPEG4_AAC_SCA;
+    const quint16 allFrequencies = 0x0FFF;
+    const quint8 allChannels = AAC_CHANNELS_1 | AAC_CHANNELS_2;
+    const auto highestBitrate = MediaEndpoint::Preference::HighestBitrate;
+    const auto lowestLatency = MediaEndpoint::Preference::LowestLatency;
+
+    QTest::newRow("all-highest-bitrate") << highestBitrate << aacCapabilitiesData(allObjectTypes, allFrequencies, allChannels, true, 0)
+                                         << aacCapabilitiesData(AAC_OBJECT_TYPE_MPEG2_AAC_LC, AAC_SAMPLING_FREQ_48000, AAC_CHANNELS_2, true, 320000);
+    QTest::newRow("all-lowest-latency") << lowestLatency << aacCapabilitiesData(allObjectTypes, allFrequencies, allChannels, true, 0)
+                                        << aacCapabilitiesData(AAC_OBJECT_TYPE_MPEG2_AAC_LC, AAC_SAMPLING_FREQ_48000, AAC_CHANNELS_2, false, 192000);
+    QTest::newRow("own-capabilities") << highestBitrate << QByteArray(reinterpret_cast<const char *>(&aacCapabilities), sizeof(aacCapabilities))
+                                      << aacCapabilitiesData(AAC_OBJECT_TYPE_MPEG2_AAC_LC, AAC_SAMPLING_FREQ_48000, AAC_CHANNELS_2, true, 320000);
+    QTest::newRow("own-capabilities-lowest-latency") << lowestLatency << QByteArray(reinterpret_cast<const char *>(&aacCapabilities), sizeof(aacCapabilities))
+                                                     << aacCapabilitiesData(AAC_OBJECT_TYPE_MPEG2_AAC_LC, AAC_SAMPLING_FREQ_48000, AAC_CHANNELS_2, false, 192000);
+    QTest::newRow("mpeg4-44100") << highestBitrate
+                                 << aacCapabilitiesData(AAC_OBJECT_TYPE_MPEG4_AAC_LC | AAC_OBJECT_TYPE_MPEG4_AAC_LTP,
+                                                        AAC_SAMPLING_FREQ_44100 | AAC_SAMPLING_FREQ_96000,
+                                                        allChannels,
+                                                        true,
+                                                        256000)
+                                 << aacCapabilitiesData(AAC_OBJECT_TYPE_MPEG4_AAC_LC, AAC_SAMPLING_FREQ_44100, AAC_CHANNELS_2, true, 256000);
+    QTest::newRow("remote-cbr") << highestBitrate << aacCapabilitiesData(AAC_OBJECT_TYPE_MPEG2_AAC_LC, AAC_SAMPLING_FREQ_48000, AAC_CHANNELS_2, false, 400000)
+                                << aacCapabilitiesData(AAC_OBJECT_TYPE_MPEG2_AAC_LC, AAC_SAMPLING_FREQ_48000, AAC_CHANNELS_2, false, 320000);
+    QTest::newRow("remote-bitrate-below-policy") << lowestLatency << aacCapabilitiesData(AAC_OBJECT_TYPE_MPEG2_AAC_LC, AAC_SAMPLING_FREQ_44100, AAC_CHANNELS_2, true, 128000)
+                                                 << aacCapabilitiesData(AAC_OBJECT_TYPE_MPEG2_AAC_LC, AAC_SAMPLING_FREQ_44100, AAC_CHANNELS_2, false, 128000);
+    QTest::newRow("no-common-object-type") << highestBitrate << aacCapabilitiesData(AAC_OBJECT_TYPE_MPEG4_AAC_LTP, allFrequencies, allChannels, true, 0) << QByteArray();
+    QTest::newRow("no-common-frequency") << highestBitrate
+                                         << aacCapabilitiesData(allObjectTypes, AAC_SAMPLING_FREQ_32000 | AAC_SAMPLING_FREQ_96000, allChannels, true, 0)
+                                         << QByteArray();
+    QTest::newRow("no-common-channels") << highestBitrate << aacCapabilitiesData(allObjectTypes, allFrequencies, AAC_CHANNELS_1, true, 0) << QByteArray();
+    QTest::newRow("invalid-size") << highestBitrate << QByteArray(3, 0) << QByteArray();
+}
+
+void MediaTest::selectAacConfigurationTest()
+{
+    QFETCH(MediaEndpoint::Preference, preference);
+    QFETCH(QByteArray, capabilities);
+    QFETCH(QByteArray, configuration);
+
+    MediaEndpoint endpoint({MediaEndpoint::Role::AudioSource, MediaEndpoint::Codec::Aac});
+    endpoint.setPreference(preference);
+    QCOMPARE(endpoint.preference(), preference);
+    QSignalSpy endpointSpy(&endpoint, SIGNAL(configurationSelected(QByteArray, QByteArray)));
+
+    endpoint.selectConfiguration(capabilities, Request<QByteArray>());
+    QCOMPARE(endpointSpy.count(), 1);
+    auto args = endpointSpy.takeFirst();
+    QCOMPARE(args.at(0).toByteArray(), capabilities);
+    QCOMPARE(args.at(1).toByteArray(), configuration);
+
+    // Advertised bitrate is limited by the preference
+    const QByteArray own = endpoint.properties().value(QStringLiteral("Capabilities")).toByteArray();
+    QCOMPARE(own.size(), int(sizeof(a2dp_aac_t)));
+    const quint32 maxBitrate = preference == MediaEndpoint::Preference::LowestLatency ? 192000 : 320000;
+    QCOMPARE(quint32(AAC_GET_BITRATE(*reinterpret_cast<const a2dp_aac_t *>(own.constData()))), maxBitrate);
+}
+
+void MediaTest::selectVendorConfigurationTest_data()
+{
+    QTest::addColumn<MediaEndpoint::Codec>("codec");
+    QTest::addColumn<QByteArray>("capabilities");
+    QTest::addColumn<QByteArray>("configuration");
+
+    a2dp_aptx_t aptx = aptxCapabilities;
+    aptx.frequency = APTX_SAMPLING_FREQ_16000 | APTX_SAMPLING_FREQ_44100 | APTX_SAMPLING_FREQ_48000;
+    aptx.channel_mode = APTX_CHANNEL_MODE_MONO | APTX_CHANNEL_MODE_STEREO;
+    const QByteArray aptxAll(reinterpret_cast<const char *>(&aptx), sizeof(aptx));
+    aptx.frequency = APTX_SAMPLING_FREQ_48000;
+    aptx.channel_mode = APTX_CHANNEL_MODE_STEREO;
+    const QByteArray aptxSelected(reinterpret_cast<const char *>(&aptx), sizeof(aptx));
+    aptx.frequency = APTX_SAMPLING_FREQ_16000;
+    const QByteArray aptx16000(reinterpret_cast<const char *>(&aptx), sizeof(aptx));
+
+    a2dp_ldac_t ldac = ldacCapabilities;
+    ldac.frequency = 0x3F;
+    ldac.channel_mode = LDAC_CHANNEL_MODE_MONO | LDAC_CHANNEL_MODE_STEREO;
+    const QByteArray ldacAll(reinterpret_cast<const char *>(&ldac), sizeof(ldac));
+    ldac.frequency = LDAC_SAMPLING_FREQ_96000;
+    ldac.channel_mode = LDAC_CHANNEL_MODE_STEREO;
+    const QByteArray ldacSelected(reinterpret_cast<const char *>(&ldac), sizeof(ldac));
+    ldac.frequency = LDAC_SAMPLING_FREQ_176400 | LDAC_SAMPLING_FREQ_192000;
+    const QByteArray ldacHighRates(reinterpret_cast<const char *>(&ldac), sizeof(ldac));
+
+    QTest::newRow("aptx") << MediaEndpoint::Codec::AptX << aptxAll << aptxSelected;
+    // Vendor and codec ids as sent by remote endpoint, little endian
+    QTest::newRow("aptx-wire-ids") << MediaEndpoint::Codec::AptX << QByteArray::fromHex("4f0000000100") + aptxAll.mid(6) << aptxSelected;
+    QTest::newRow("aptx-no-common-frequency") << MediaEndpoint::Codec::AptX << aptx16000 << QByteArray();
+    QTest::newRow("aptx-ldac-capabilities") << MediaEndpoint::Codec::AptX << ldacAll.left(sizeof(a2dp_aptx_t)) << QByteArray();
+    QTest::newRow("ldac") << MediaEndpoint::Codec::Ldac << ldacAll << ldacSelected;
+    QTest::newRow("ldac-wire-ids") << MediaEndpoint::Codec::Ldac << QByteArray::fromHex("2d010000aa00") + ldacAll.mid(6) << ldacSelected;
+    QTest::newRow("ldac-no-common-frequency") << MediaEndpoint::Codec::Ldac << ldacHighRates << QByteArray();
+    QTest::newRow("ldac-aptx-capabilities") << MediaEndpoint::Codec::Ldac << aptxAll + QByteArray(1, 0) << QByteArray();
+}
+
+void MediaTest::selectVendorConfigurationTest()
+{
+    QFETCH(MediaEndpoint::Codec, codec);
+    QFETCH(QByteArray, capabilities);
+    QFETCH(QByteArray, configuration);
+
+    MediaEndpoint endpoint({MediaEndpoint::Role::AudioSink, codec});
+    QCOMPARE(endpoint.properties().value(QStringLiteral("Codec")).value<uchar>(), uchar(A2DP_CODEC_VENDOR));
+
+    QSignalSpy endpointSpy(&endpoint, SIGNAL(configurationSelected(QByteArray, QByteArray)));
+
+    endpoint.selectConfiguration(capabilities, Request<QByteArray>());
+    QCOMPARE(endpointSpy.count(), 1);
+    QCOMPARE(endpointSpy.first().at(1).toByteArray(), configuration);
+}
+
 void MediaTest::clearConfigurationTest()
 {
     QSignalSpy endpointSpy(m_endpoint, SIGNAL(configurationCleared(QString)));
@@ -131,4 +367,31 @@ void MediaTest::releaseTest()
     QTRY_COMPARE(m_endpoint->m_releaseCalled, true);
 }
 
+void MediaTest::registerEndpointsTest()
+{
+    auto *aacEndpoint = new TestEndpoint({MediaEndpoint::Role::AudioSource, MediaEndpoint::Codec::Aac}, this);
+    auto *aptxEndpoint = new TestEndpoint({MediaEndpoint::Role::AudioSource, MediaEndpoint::Codec::AptX}, this);
+    QVERIFY(aacEndpoint->objectPath() != aptxEndpoint->objectPath());
+
+    const QList<PendingCall *> calls = m_adapter->media()->registerEndpoints({aacEndpoint, aptxEndpoint});
+    QCOMPARE(calls.count(), 2);
+    for (PendingCall *call : calls) {
+        call->waitForFinished();
+        QVERIFY(!call->error());
+    }
+
+    // Fake media keeps the endpoint registered last
+    QSignalSpy endpointSpy(aptxEndpoint, SIGNAL(configurationSelected(QByteArray, QByteArray)));
+
+    const QByteArray capabilities(reinterpret_cast<const char *>(&aptxCapabilities), sizeof(aptxCapabilities));
+    QVariantMap params;
+    params.insert(QStringLiteral("AdapterPath"), QVariant::fromValue(QDBusObjectPath(m_adapter->ubi())));
+    params.insert(QStringLiteral("Capabilities"), capabilities);
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("adapter-media:select-configuration"), params);
+    endpointSpy.wait();
+    QCOMPARE(endpointSpy.count(), 1);
+    QCOMPARE(endpointSpy.first().at(0).toByteArray(), capabilities);
+    QVERIFY(!endpointSpy.first().at(1).toByteArray().isEmpty());
+}
+
 QTEST_MAIN(MediaTest)
@@ -32,8 +32,16 @@ private Q_SLOTS:
 
     void setConfigurationTest();
     void selectConfigurationTest();
+    void selectSbcConfigurationTest_data();
+    void selectSbcConfigurationTest();
+    void sbcChannelModesTest();
+    void selectAacConfigurationTest_data();
+    void selectAacConfigurationTest();
+    void selectVendorConfigurationTest_data();
+    void selectVendorConfigurationTest();
     void clearConfigurationTest();
     void releaseTest();
+    void registerEndpointsTest();
 
 private:
     TestEndpoint *m_endpoint;
@@ -0,0 +1,240 @@
+/*
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "mediatransportstreamtest.h"
+#include "mediatransportstream.h"
+
+#include <QDBusUnixFileDescriptor>
+#include <QSignalSpy>
+#include <QTest>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace BluezQt;
+
+static const int FRAME_SIZE = 119;
+static const int SAMPLES_PER_FRAME = 128;
+static const quint16 MTU = 672;
+
+// SBC frame: 44.1 kHz, 16 blocks, joint stereo, 8 subbands, bitpool 53
+static QByteArray sbcFrame(char fill)
+{
+    QByteArray frame(FRAME_SIZE, fill);
+    frame[0] = char(0x9C);
+    frame[1] = char(0xBD);
+    frame[2] = char(53);
+    frame[3] = 0;
+    return frame;
+}
+
+static QByteArray rtpPacket(quint16 sequence, quint32 timestamp, const QByteArray &frames, int count)
+{
+    QByteArray packet(13, 0);
+    packet[0] = char(0x80);
+    packet[1] = char(96);
+    packet[2] = char(sequence >> 8);
+    packet[3] = char(sequence & 0xFF);
+    packet[4] = char(timestamp >> 24);
+    packet[5] = char((timestamp >> 16) & 0xFF);
+    packet[6] = char((timestamp >> 8) & 0xFF);
+    packet[7] = char(timestamp & 0xFF);
+    packet[12] = char(count);
+    return packet + frames;
+}
+
+void MediaTransportStreamTest::init()
+{
+    QCOMPARE(::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, m_sockets), 0);
+}
+
+void MediaTransportStreamTest::cleanup()
+{
+    ::close(m_sockets[0]);
+    ::close(m_sockets[1]);
+}
+
+void MediaTransportStreamTest::writeTest()
+{
+    MediaTransportStream stream(QDBusUnixFileDescriptor(m_sockets[0]), MTU, MTU);
+    QVERIFY(stream.open(QIODevice::WriteOnly));
+
+    QSignalSpy writtenSpy(&stream, SIGNAL(bytesWritten(qint64)));
+
+    QByteArray data;
+    for (int i = 0; i < 12; ++i) {
+        data.append(sbcFrame(char(i)));
+    }
+    QCOMPARE(stream.write(data), qint64(data.size()));
+    QCOMPARE(stream.packetsSent(), quint64(3));
+    QCOMPARE(stream.bytesToWrite(), qint64(0));
+    QCOMPARE(writtenSpy.count(), 1);
+    QCOMPARE(writtenSpy.at(0).at(0).toLongLong(), qint64(data.size()));
+
+    // 5 frames fit into one packet
+    const int expectedFrames[] = {5, 5, 2};
+    int frame = 0;
+    for (int i = 0; i < 3; ++i) {
+        QByteArray packet(MTU, 0);
+        const ssize_t size = ::recv(m_sockets[1], packet.data(), packet.size(), 0);
+        QCOMPARE(size, ssize_t(13 + expectedFrames[i] * FRAME_SIZE));
+
+        const uchar *header = reinterpret_cast<const uchar *>(packet.constData());
+        QCOMPARE(int(header[0]), 0x80);
+        QCOMPARE((header[2] << 8) | header[3], i);
+        const quint32 timestamp = (header[4] << 24) | (header[5] << 16) | (header[6] << 8) | header[7];
+        QCOMPARE(timestamp, quint32(frame * SAMPLES_PER_FRAME));
+        QCOMPARE(int(header[12]), expectedFrames[i]);
+        QCOMPARE(packet.mid(13, FRAME_SIZE), sbcFrame(char(frame)));
+        frame += expectedFrames[i];
+    }
+}
+
+void MediaTransportStreamTest::partialWriteTest()
+{
+    MediaTransportStream stream(QDBusUnixFileDescriptor(m_sockets[0]), MTU, MTU);
+    QVERIFY(stream.open(QIODevice::WriteOnly));
+
+    const QByteArray frame = sbcFrame('a');
+
+    QCOMPARE(stream.write(frame.left(2)), qint64(2));
+    QCOMPARE(stream.write(frame.mid(2, 50)), qint64(50));
+    QCOMPARE(stream.packetsSent(), quint64(0));
+    QCOMPARE(stream.bytesToWrite(), qint64(52));
+
+    QCOMPARE(stream.write(frame.mid(52)), qint64(FRAME_SIZE - 52));
+    QCOMPARE(stream.packetsSent(), quint64(1));
+
+    QByteArray packet(MTU, 0);
+    QCOMPARE(::recv(m_sockets[1], packet.data(), packet.size(), 0), ssize_t(13 + FRAME_SIZE));
+    QCOMPARE(packet.mid(13, FRAME_SIZE), frame);
+
+    // Invalid frame
+    QCOMPARE(stream.write(QByteArray(FRAME_SIZE, 'x')), qint64(-1));
+}
+
+void MediaTransportStreamTest::readTest()
+{
+    MediaTransportStream stream(QDBusUnixFileDescriptor(m_sockets[0]), MTU, MTU);
+    QVERIFY(stream.open(QIODevice::ReadOnly));
+
+    QSignalSpy readySpy(&stream, SIGNAL(readyRead()));
+
+    const QByteArray frames = sbcFrame('a') + sbcFrame('b') + sbcFrame('c');
+    const QByteArray packet = rtpPacket(0, 0, frames, 3);
+    QCOMPARE(::send(m_sockets[1], packet.constData(), packet.size(), 0), ssize_t(packet.size()));
+
+    QTRY_COMPARE(readySpy.count(), 1);
+    QCOMPARE(stream.framesAvailable(), 3);
+    QCOMPARE(stream.bytesAvailable(), qint64(frames.size()));
+
+    QCOMPARE(stream.readFrame(), sbcFrame('a'));
+
+    // Only whole frames are read
+    QCOMPARE(stream.read(FRAME_SIZE + 10), sbcFrame('b'));
+    QCOMPARE(stream.readAll(), sbcFrame('c'));
+    QCOMPARE(stream.framesAvailable(), 0);
+    QCOMPARE(stream.packetsReceived(), quint64(1));
+}
+
+void MediaTransportStreamTest::loopbackTest()
+{
+    MediaTransportStream writer(QDBusUnixFileDescriptor(m_sockets[0]), MTU, MTU);
+    MediaTransportStream reader(QDBusUnixFileDescriptor(m_sockets[1]), MTU, MTU);
+    QVERIFY(writer.open(QIODevice::WriteOnly));
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+
+    QByteArray data;
+    for (int i = 0; i < 32; ++i) {
+        data.append(sbcFrame(char(i)));
+    }
+    QCOMPARE(writer.write(data), qint64(data.size()));
+
+    QTRY_COMPARE(reader.framesAvailable(), 32);
+    QCOMPARE(reader.readAll(), data);
+    QCOMPARE(reader.packetsReceived(), writer.packetsSent());
+    QCOMPARE(reader.packetsLost(), quint64(0));
+}
+
+void MediaTransportStreamTest::statisticsTest()
+{
+    MediaTransportStream stream(QDBusUnixFileDescriptor(m_sockets[0]), MTU, MTU);
+    QVERIFY(stream.open(QIODevice::ReadOnly));
+
+    // Nothing received yet, not an underrun
+    QVERIFY(stream.readFrame().isEmpty());
+    QCOMPARE(stream.underruns(), quint64(0));
+
+    const quint16 sequences[] = {0, 1, 3, 4, 8};
+    for (quint16 sequence : sequences) {
+        const QByteArray packet = rtpPacket(sequence, sequence * SAMPLES_PER_FRAME, sbcFrame('a'), 1);
+        QCOMPARE(::send(m_sockets[1], packet.constData(), packet.size(), 0), ssize_t(packet.size()));
+        QTest::qWait(2);
+    }
+
+    QTRY_COMPARE(stream.packetsReceived(), quint64(5));
+    QCOMPARE(stream.packetsLost(), quint64(4));
+    QVERIFY(stream.jitter() > 0);
+
+    QCOMPARE(stream.readAll().size(), 5 * FRAME_SIZE);
+    QVERIFY(stream.readFrame().isEmpty());
+    QCOMPARE(stream.underruns(), quint64(1));
+}
+
+void MediaTransportStreamTest::hangupTest()
+{
+    MediaTransportStream stream(QDBusUnixFileDescriptor(m_sockets[0]), MTU, MTU);
+    QVERIFY(stream.open(QIODevice::ReadOnly));
+
+    QSignalSpy finishedSpy(&stream, SIGNAL(readChannelFinished()));
+
+    ::shutdown(m_sockets[1], SHUT_RDWR);
+
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QVERIFY(!stream.isOpen());
+}
+
+void MediaTransportStreamTest::streamBenchmark_data()
+{
+    QTest::addColumn<int>("framesPerWrite");
+
+    QTest::newRow("1 frame") << 1;
+    QTest::newRow("5 frames") << 5;
+    QTest::newRow("15 frames") << 15;
+}
+
+void MediaTransportStreamTest::streamBenchmark()
+{
+    QFETCH(int, framesPerWrite);
+
+    const int frames = 3000;
+
+    MediaTransportStream writer(QDBusUnixFileDescriptor(m_sockets[0]), MTU, MTU);
+    MediaTransportStream reader(QDBusUnixFileDescriptor(m_sockets[1]), MTU, MTU);
+    QVERIFY(writer.open(QIODevice::WriteOnly));
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+
+    QByteArray data;
+    for (int i = 0; i < framesPerWrite; ++i) {
+        data.append(sbcFrame(char(i)));
+    }
+
+    QBENCHMARK {
+        int written = 0;
+        int read = 0;
+        while (read < frames) {
+            if (written < frames && writer.bytesToWrite() == 0) {
+                QCOMPARE(writer.write(data), qint64(data.size()));
+                written += framesPerWrite;
+            }
+            QCoreApplication::processEvents();
+            while (reader.framesAvailable()) {
+                reader.readFrame();
+                ++read;
+            }
+        }
+    }
+}
+
+QTEST_MAIN(MediaTransportStreamTest)
@@ -0,0 +1,32 @@
+/*
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#ifndef MEDIATRANSPORTSTREAMTEST_H
+#define MEDIATRANSPORTSTREAMTEST_H
+
+#include <QObject>
+
+class MediaTransportStreamTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void writeTest();
+    void partialWriteTest();
+    void readTest();
+    void loopbackTest();
+    void statisticsTest();
+    void hangupTest();
+
+    void streamBenchmark_data();
+    void streamBenchmark();
+
+private:
+    int m_sockets[2];
+};
+
+#endif // MEDIATRANSPORTSTREAMTEST_H
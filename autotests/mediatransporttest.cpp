@@ -25,6 +25,7 @@ Q_DECLARE_METATYPE(MediaTransport::State)
 
 static a2dp_sbc_t sbcConfiguration;
 static a2dp_aac_t aacConfiguration;
+static a2dp_aptx_t aptxConfiguration;
 
 static AudioCodec charToCodec(uchar value)
 {
@@ -35,6 +36,9 @@ static AudioCodec charToCodec(uchar value)
     case A2DP_CODEC_MPEG24:
         return AudioCodec::Aac;
         break;
+    case A2DP_CODEC_VENDOR:
+        return AudioCodec::AptX;
+        break;
     }
 
     return AudioCodec::Invalid;
@@ -75,6 +79,24 @@ static AudioSampleRate byteArrayToSampleRate(AudioCodec codec, const QByteArray
         }
         break;
     }
+    case AudioCodec::AptX: {
+        if (buffer.size() != sizeof(a2dp_aptx_t)) {
+            return AudioSampleRate::Invalid;
+        }
+
+        a2dp_aptx_t aptxConfig = *reinterpret_cast<const a2dp_aptx_t *>(buffer.constData());
+        switch (aptxConfig.frequency) {
+        case APTX_SAMPLING_FREQ_44100:
+            return AudioSampleRate::Rate44100;
+            break;
+        case APTX_SAMPLING_FREQ_48000:
+            return AudioSampleRate::Rate48000;
+            break;
+        }
+        break;
+    }
+    default:
+        break;
     }
 
     return AudioSampleRate::Invalid;
@@ -102,7 +124,12 @@ MediaTransportTest::MediaTransportTest()
     qRegisterMetaType<MediaTransport::State>("State");
 
     sbcConfiguration.frequency = SBC_SAMPLING_FREQ_44100;
+    sbcConfiguration.channel_mode = SBC_CHANNEL_MODE_JOINT_STEREO;
     AAC_SET_FREQUENCY(aacConfiguration, AAC_SAMPLING_FREQ_48000);
+    aacConfiguration.channels = AAC_CHANNELS_2;
+    aptxConfiguration = aptxCapabilities;
+    aptxConfiguration.frequency = APTX_SAMPLING_FREQ_44100;
+    aptxConfiguration.channel_mode = APTX_CHANNEL_MODE_STEREO;
 }
 
 void MediaTransportTest::initTestCase()
@@ -158,13 +185,30 @@ void MediaTransportTest::initTestCase()
     deviceProps[QStringLiteral("MediaTransport")] = mediaTransportProps;
     FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-device"), deviceProps);
 
+    QString device3 = adapter + QLatin1String("/dev_60_79_6A_0C_39_75");
+    deviceProps[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(device3));
+    deviceProps[QStringLiteral("Adapter")] = QVariant::fromValue(QDBusObjectPath(adapter));
+    deviceProps[QStringLiteral("Address")] = QStringLiteral("60:79:6A:0C:39:75");
+    deviceProps[QStringLiteral("Name")] = QStringLiteral("TestDevice3");
+    deviceProps[QStringLiteral("UUIDs")] = QStringList(Services::AudioSink);
+    mediaTransportProps[QStringLiteral("Path")] = QVariant::fromValue(QDBusObjectPath(device3 + QLatin1String("/fd0")));
+    mediaTransportProps[QStringLiteral("Device")] = QVariant::fromValue(QDBusObjectPath(device3));
+    mediaTransportProps[QStringLiteral("UUID")] = Services::AudioSink;
+    mediaTransportProps[QStringLiteral("Codec")] = QVariant::fromValue(quint8(A2DP_CODEC_VENDOR)); // aptX
+    mediaTransportProps[QStringLiteral("Configuration")] =
+        QVariant::fromValue(QByteArray(reinterpret_cast<const char *>(&aptxConfiguration), sizeof(aptxConfiguration)));
+    mediaTransportProps[QStringLiteral("State")] = QStringLiteral("idle");
+    mediaTransportProps[QStringLiteral("Volume")] = QVariant::fromValue(quint16(0));
+    deviceProps[QStringLiteral("MediaTransport")] = mediaTransportProps;
+    FakeBluez::runAction(QStringLiteral("devicemanager"), QStringLiteral("create-device"), deviceProps);
+
     m_manager = new Manager();
     InitManagerJob *initJob = m_manager->init();
     initJob->exec();
     QVERIFY(!initJob->error());
 
     QCOMPARE(m_manager->adapters().count(), 1);
-    QCOMPARE(m_manager->devices().count(), 2);
+    QCOMPARE(m_manager->devices().count(), 3);
 }
 
 void MediaTransportTest::cleanupTestCase()
@@ -237,6 +281,7 @@ void MediaTransportTest::getPropertiesTest()
         QCOMPARE(unit.device->mediaTransport()->audioConfiguration().codec, charToCodec(unit.dbusMediaTransport->codec()));
         QCOMPARE(unit.device->mediaTransport()->audioConfiguration().sampleRate,
                  byteArrayToSampleRate(unit.device->mediaTransport()->audioConfiguration().codec, unit.dbusMediaTransport->configuration()));
+        QCOMPARE(unit.device->mediaTransport()->channels(), 2);
         QCOMPARE(stateString(unit.device->mediaTransport()->state()), unit.dbusMediaTransport->state());
         QCOMPARE(unit.device->mediaTransport()->volume(), unit.dbusMediaTransport->volume());
     }
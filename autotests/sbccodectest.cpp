@@ -0,0 +1,436 @@
+/*
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "sbccodectest.h"
+#include "a2dp-codecs.h"
+#include "sbcdecoder.h"
+#include "sbcencoder.h"
+#include "sbcstreaminfo.h"
+
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QTest>
+#include <QVector>
+
+#include <cmath>
+
+namespace BluezQt
+{
+extern bool bluezqt_setSbcFilterImplementation(int implementation);
+extern void bluezqt_resetSbcFilterImplementation();
+}
+
+using namespace BluezQt;
+
+// Values of SbcFilter::Implementation
+static const char *implementations[] = {"scalar", "sse2", "avx2", "neon"};
+
+static QByteArray sbcConfiguration(quint8 frequency, quint8 channelMode, quint8 blocks, quint8 subbands, quint8 allocation, quint8 bitpool)
+{
+    a2dp_sbc_t configuration;
+    configuration.frequency = frequency;
+    configuration.channel_mode = channelMode;
+    configuration.block_length = blocks;
+    configuration.subbands = subbands;
+    configuration.allocation_method = allocation;
+    configuration.min_bitpool = MIN_BITPOOL;
+    configuration.max_bitpool = bitpool;
+    return QByteArray(reinterpret_cast<const char *>(&configuration), sizeof(configuration));
+}
+
+// Triangle wave with noise, integer only so the reference vectors do not depend on libm
+static QByteArray testSignal(int samples, int channels)
+{
+    QVector<qint16> pcm(samples * channels);
+    quint32 seed = 1;
+    for (int i = 0; i < samples; ++i) {
+        for (int ch = 0; ch < channels; ++ch) {
+            seed = seed * 1103515245u + 12345u;
+            const int noise = int((seed >> 16) & 0x7FF) - 1024;
+            const int period = 100 * (ch + 1);
+            const int phase = i % period;
+            const int triangle = qAbs(2 * phase - period) * 40000 / period - 20000;
+            pcm[i * channels + ch] = qint16(triangle + noise);
+        }
+    }
+    return QByteArray(reinterpret_cast<const char *>(pcm.constData()), pcm.size() * int(sizeof(qint16)));
+}
+
+static QByteArray md5(const QByteArray &data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex();
+}
+
+void SbcCodecTest::cleanup()
+{
+    bluezqt_resetSbcFilterImplementation();
+}
+
+void SbcCodecTest::configurationTest()
+{
+    SbcEncoder encoder(sbcConfiguration(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_JOINT_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, SBC_ALLOCATION_LOUDNESS, 53));
+    QVERIFY(encoder.isValid());
+    QCOMPARE(encoder.sampleRate(), 44100);
+    QCOMPARE(encoder.channels(), 2);
+    QCOMPARE(encoder.bitpool(), 53);
+    QCOMPARE(encoder.frameLength(), 119);
+    QCOMPARE(encoder.samplesPerFrame(), 128);
+    QCOMPARE(encoder.codeSize(), 512);
+
+    encoder.setBitpool(35);
+    QCOMPARE(encoder.bitpool(), 35);
+    QCOMPARE(encoder.frameLength(), 83);
+    encoder.setBitpool(100);
+    QCOMPARE(encoder.bitpool(), 53);
+
+    // Capabilities with more options selected
+    SbcEncoder capabilities(sbcConfiguration(SBC_SAMPLING_FREQ_44100 | SBC_SAMPLING_FREQ_48000,
+                                             SBC_CHANNEL_MODE_JOINT_STEREO,
+                                             SBC_BLOCK_LENGTH_16,
+                                             SBC_SUBBANDS_8,
+                                             SBC_ALLOCATION_LOUDNESS,
+                                             53));
+    QVERIFY(!capabilities.isValid());
+    QCOMPARE(capabilities.encode(testSignal(1024, 2)), QByteArray());
+
+    SbcEncoder empty(QByteArray{});
+    QVERIFY(!empty.isValid());
+}
+
+void SbcCodecTest::silenceFrameTest()
+{
+    const QByteArray configuration =
+        sbcConfiguration(SBC_SAMPLING_FREQ_16000, SBC_CHANNEL_MODE_MONO, SBC_BLOCK_LENGTH_8, SBC_SUBBANDS_4, SBC_ALLOCATION_LOUDNESS, 20);
+    const uchar reference[] = {0x9c, 0x10, 0x14, 0x53, 0x00, 0x00, 0x7b, 0xde, 0xf7, 0xbd, 0xef, 0x7b, 0xde,
+                               0xf7, 0xbd, 0xef, 0x7b, 0xde, 0xf7, 0xbd, 0xef, 0x7b, 0xde, 0xf7, 0xbd, 0xef};
+
+    SbcEncoder encoder(configuration);
+    const QByteArray frame = encoder.encode(QByteArray(encoder.codeSize(), 0));
+    QCOMPARE(frame, QByteArray(reinterpret_cast<const char *>(reference), sizeof(reference)));
+
+    SbcDecoder decoder(configuration);
+    QCOMPARE(decoder.decode(frame), QByteArray(encoder.codeSize(), 0));
+    QCOMPARE(decoder.crcErrors(), quint64(0));
+}
+
+void SbcCodecTest::bitExactnessTest_data()
+{
+    QTest::addColumn<int>("implementation");
+    QTest::addColumn<QByteArray>("configuration");
+    QTest::addColumn<QByteArray>("encoded");
+    QTest::addColumn<QByteArray>("decoded");
+
+    const QByteArray configurations[] = {
+        sbcConfiguration(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_JOINT_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, SBC_ALLOCATION_LOUDNESS, 53),
+        sbcConfiguration(SBC_SAMPLING_FREQ_48000, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, SBC_ALLOCATION_SNR, 51),
+        sbcConfiguration(SBC_SAMPLING_FREQ_32000, SBC_CHANNEL_MODE_DUAL_CHANNEL, SBC_BLOCK_LENGTH_12, SBC_SUBBANDS_4, SBC_ALLOCATION_LOUDNESS, 30),
+        sbcConfiguration(SBC_SAMPLING_FREQ_16000, SBC_CHANNEL_MODE_MONO, SBC_BLOCK_LENGTH_8, SBC_SUBBANDS_4, SBC_ALLOCATION_LOUDNESS, 20),
+    };
+    const char *names[] = {"44.1kHz joint stereo", "48kHz stereo", "32kHz dual channel", "16kHz mono"};
+
+    // MD5 of encoded test signal and of decoded frames
+    const char *encoded[] = {
+        "e7438e31f4de52cada38e67a2f0021e6",
+        "025816e03cc641706a6aa230a3a90213",
+        "35144364909b79b59833c38981af81c6",
+        "6d6d96e7b9f035bb84fb77deb6e8b819",
+    };
+    const char *decoded[] = {
+        "fda22bded5b91ee537c560421bc17b6e",
+        "c2f37e19cb06ec0eda7c55be01ef6fca",
+        "9a53fd2b4ec63fbd655f441137560a67",
+        "ce736dae5751a9e3366e85521f98591a",
+    };
+
+    for (int implementation = 0; implementation < 4; ++implementation) {
+        for (int i = 0; i < 4; ++i) {
+            QTest::addRow("%s %s", implementations[implementation], names[i])
+                << implementation << configurations[i] << QByteArray(encoded[i]) << QByteArray(decoded[i]);
+        }
+    }
+}
+
+void SbcCodecTest::bitExactnessTest()
+{
+    QFETCH(int, implementation);
+    QFETCH(QByteArray, configuration);
+    QFETCH(QByteArray, encoded);
+    QFETCH(QByteArray, decoded);
+
+    if (!bluezqt_setSbcFilterImplementation(implementation)) {
+        QSKIP("Implementation not supported");
+    }
+
+    SbcEncoder encoder(configuration);
+    SbcDecoder decoder(configuration);
+
+    const QByteArray frames = encoder.encode(testSignal(encoder.samplesPerFrame() * 100, encoder.channels()));
+    QCOMPARE(frames.size(), encoder.frameLength() * 100);
+    QCOMPARE(md5(frames), encoded);
+
+    const QByteArray pcm = decoder.decode(frames);
+    QCOMPARE(pcm.size(), encoder.codeSize() * 100);
+    QCOMPARE(md5(pcm), decoded);
+    QCOMPARE(decoder.crcErrors(), quint64(0));
+}
+
+void SbcCodecTest::referenceVectorTest_data()
+{
+    QTest::addColumn<QByteArray>("frame");
+    QTest::addColumn<QByteArray>("pcm");
+
+    // Frames with random scale factors and samples, built and decoded by an
+    // independent floating-point implementation of A2DP specification,
+    // section 12. Decoded samples are rounded to integers.
+    static const uchar jointStereoFrame[] = {
+        0x9c, 0xbd, 0x23, 0xfc, 0x2e, 0x42, 0x81, 0x77, 0xa1, 0x85, 0x4a, 0x26,
+        0x11, 0x0a, 0x81, 0xd6, 0x37, 0x10, 0x79, 0xb8, 0xc4, 0xf4, 0xf1, 0xa0,
+        0xd5, 0x0c, 0xd5, 0xe4, 0x2f, 0x6b, 0x4e, 0x69, 0xa9, 0x8b, 0x27, 0xb0,
+        0xe6, 0x09, 0x2f, 0x99, 0xa9, 0x51, 0xd5, 0xd0, 0xbd, 0x83, 0x12, 0xd3,
+        0x57, 0xa1, 0x84, 0xdb, 0x93, 0x2e, 0x92, 0xa0, 0x18, 0xe3, 0x42, 0xcc,
+        0xfb, 0x4a, 0xb5, 0x63, 0xa0, 0x3c, 0xdd, 0x66, 0x65, 0x88, 0x6c, 0x1e,
+        0x5e, 0x8d, 0x19, 0xf2, 0x6b, 0x14, 0x66, 0x4a, 0x70, 0x12, 0x2c,
+    };
+    static const qint16 jointStereoPcm[] = {
+        0, 0, 0, -1, 0, 1, -2, 3, 0, 0, 5, -6, -2, -3, 0, 15,
+        2, 14, -8, -10, 0, -15, 4, 2, -1, 10, -1, 9, -3, 13, 11, 5,
+        -1, -45, 8, -46, 6, 28, -53, 58, 0, -8, 60, -74, 3, -13, -33, 55,
+        16, 102, -32, 21, 4, -21, 22, -113, -2, -183, -69, 20, 11, 304, 184, 149,
+        -63, -475, 110, -434, -47, -24, -369, 528, -12, 135, 523, -515, 101, -233, -337, 452,
+        19, 1076, -362, -50, -3, -1186, 297, -375, 113, 1728, -264, 1227, 113, -671, -477, -1788,
+        -26, 520, 1540, 3447, -1536, -862, 222, -1305, 186, -1104, -1091, 156, 2116, 3829, -1255, -2308,
+        760, -1466, -16, 109, -2231, -363, 2252, 2919, -1716, -3025, 1384, 7, 1126, 1848, -2807, -820,
+        2375, 2750, -1879, -3040, 193, 82, 1224, 2503, -1492, -622, 2268, 1963, -1945, -2232, 490, 1046,
+        550, 697, -1256, -1928, 1790, 1661, -1769, -1332, 1300, 1057, -104, -1510, -1013, -2030, 2011, 2919,
+        -2156, -1827, 1354, -785, 56, -1245, -1316, -336, 2009, 2288, -1534, -3128, 971, -398, -367, 103,
+        -651, 3, 1842, 667, -2100, -3206, 1484, 2532, -509, 565, -723, -1667, 1864, 1255, -2232, -491,
+        1583, 2877, -329, -1449, -781, -1421, 1003, 2969, -1192, 798, 1171, -175, -539, -3152, -386, 459,
+        719, 3642, -205, 70, -654, -3450, 533, -1914, 1, 943, -746, 1567, 1598, 1199, -1389, -3913,
+        431, -1749, 726, 710, -1746, 512, 1606, 2468, -1052, -3068, 662, -1713, 667, -38, -1744, 173,
+        1703, 3652, -1457, -2838, 696, -2055, 153, -765, -881, 789, 1611, 3985, -2095, -2580, 1436, -1577,
+    };
+    static const uchar monoFrame[] = {
+        0x9c, 0x12, 0x12, 0x94, 0x12, 0x26, 0xc5, 0x79, 0xee, 0xa2, 0x08, 0x72,
+        0x12, 0x51, 0x37, 0xad, 0x97, 0x34, 0x2c, 0x57, 0x09, 0xcc, 0x68, 0x2e,
+    };
+    static const qint16 monoPcm[] = {
+        0, 0, 0, 0, 1, -1, 1, 1, -3, 3, 0, -3, 7, -1, -10, 24,
+        -34, 14, 6, -37, 88, -95, 96, -74, 22, 26, -54, 99, -105, 116, -115, 95,
+    };
+
+    QTest::newRow("44.1kHz joint stereo") << QByteArray(reinterpret_cast<const char *>(jointStereoFrame), sizeof(jointStereoFrame))
+                                          << QByteArray(reinterpret_cast<const char *>(jointStereoPcm), sizeof(jointStereoPcm));
+    QTest::newRow("16kHz mono SNR") << QByteArray(reinterpret_cast<const char *>(monoFrame), sizeof(monoFrame))
+                                    << QByteArray(reinterpret_cast<const char *>(monoPcm), sizeof(monoPcm));
+}
+
+void SbcCodecTest::referenceVectorTest()
+{
+    QFETCH(QByteArray, frame);
+    QFETCH(QByteArray, pcm);
+
+    SbcDecoder decoder;
+    const QByteArray decoded = decoder.decode(frame);
+    QCOMPARE(decoder.crcErrors(), quint64(0));
+    QCOMPARE(decoded.size(), pcm.size());
+
+    // Fixed-point filterbank differs from floating-point reference in the last bits
+    const qint16 *expected = reinterpret_cast<const qint16 *>(pcm.constData());
+    const qint16 *actual = reinterpret_cast<const qint16 *>(decoded.constData());
+    for (int i = 0; i < pcm.size() / int(sizeof(qint16)); ++i) {
+        QVERIFY2(qAbs(actual[i] - expected[i]) <= 8, qPrintable(QStringLiteral("sample %1: %2, expected %3").arg(i).arg(actual[i]).arg(expected[i])));
+    }
+}
+
+void SbcCodecTest::roundTripTest_data()
+{
+    QTest::addColumn<QByteArray>("configuration");
+    QTest::addColumn<int>("subbands");
+
+    QTest::newRow("44.1kHz joint stereo")
+        << sbcConfiguration(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_JOINT_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, SBC_ALLOCATION_LOUDNESS, 53) << 8;
+    QTest::newRow("48kHz stereo") << sbcConfiguration(SBC_SAMPLING_FREQ_48000, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, SBC_ALLOCATION_SNR, 51)
+                                  << 8;
+    QTest::newRow("32kHz dual channel")
+        << sbcConfiguration(SBC_SAMPLING_FREQ_32000, SBC_CHANNEL_MODE_DUAL_CHANNEL, SBC_BLOCK_LENGTH_12, SBC_SUBBANDS_4, SBC_ALLOCATION_LOUDNESS, 30) << 4;
+    QTest::newRow("16kHz mono") << sbcConfiguration(SBC_SAMPLING_FREQ_16000, SBC_CHANNEL_MODE_MONO, SBC_BLOCK_LENGTH_8, SBC_SUBBANDS_4, SBC_ALLOCATION_LOUDNESS, 20)
+                                << 4;
+}
+
+void SbcCodecTest::roundTripTest()
+{
+    QFETCH(QByteArray, configuration);
+    QFETCH(int, subbands);
+
+    SbcEncoder encoder(configuration);
+    SbcDecoder decoder(configuration);
+    QCOMPARE(decoder.sampleRate(), encoder.sampleRate());
+    QCOMPARE(decoder.channels(), encoder.channels());
+
+    const int channels = encoder.channels();
+    const int samples = encoder.samplesPerFrame() * 100;
+    const QByteArray input = testSignal(samples, channels);
+    const QByteArray output = decoder.decode(encoder.encode(input));
+    QCOMPARE(output.size(), input.size());
+    QCOMPARE(decoder.samplesPerFrame(), encoder.samplesPerFrame());
+
+    // Delay of analysis and synthesis is 9 * subbands + 1 samples
+    const int delay = 9 * subbands + 1;
+
+    const qint16 *in = reinterpret_cast<const qint16 *>(input.constData());
+    const qint16 *out = reinterpret_cast<const qint16 *>(output.constData());
+    double signal = 0;
+    double noise = 0;
+    for (int i = 0; i < (samples - delay) * channels; ++i) {
+        const double difference = double(out[i + delay * channels]) - in[i];
+        signal += double(in[i]) * in[i];
+        noise += difference * difference;
+    }
+
+    const double snr = 10 * std::log10(signal / noise);
+    QVERIFY2(snr > 30, qPrintable(QStringLiteral("SNR %1 dB").arg(snr)));
+}
+
+void SbcCodecTest::crcErrorTest()
+{
+    const QByteArray configuration =
+        sbcConfiguration(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_JOINT_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, SBC_ALLOCATION_LOUDNESS, 53);
+
+    SbcEncoder encoder(configuration);
+    SbcDecoder decoder(configuration);
+
+    QByteArray frames = encoder.encode(testSignal(encoder.samplesPerFrame() * 3, 2));
+    QCOMPARE(frames.size(), 3 * 119);
+
+    // Scale factor of the second frame
+    frames[119 + 6] = char(frames.at(119 + 6) ^ 0x10);
+
+    qint16 pcm[256];
+    QCOMPARE(decoder.decode(frames.constData(), frames.size(), pcm), 119);
+    QCOMPARE(decoder.decode(frames.constData() + 119, frames.size() - 119, pcm), -1);
+    QCOMPARE(decoder.crcErrors(), quint64(1));
+
+    // Incomplete frame
+    QCOMPARE(decoder.decode(frames.constData() + 238, 100, pcm), 0);
+
+    decoder.reset();
+    QCOMPARE(decoder.decode(frames).size(), 2 * encoder.codeSize());
+    QCOMPARE(decoder.crcErrors(), quint64(2));
+}
+
+void SbcCodecTest::configurationMismatchTest()
+{
+    SbcEncoder encoder(sbcConfiguration(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, SBC_ALLOCATION_LOUDNESS, 53));
+    const QByteArray frame = encoder.encode(testSignal(encoder.samplesPerFrame(), 2));
+
+    SbcDecoder mono(sbcConfiguration(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_MONO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, SBC_ALLOCATION_LOUDNESS, 53));
+    QVERIFY(mono.decode(frame).isEmpty());
+
+    SbcDecoder lowBitpool(sbcConfiguration(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, SBC_ALLOCATION_LOUDNESS, 35));
+    QVERIFY(lowBitpool.decode(frame).isEmpty());
+
+    // Without configuration any valid frame is accepted
+    SbcDecoder any;
+    QCOMPARE(any.channels(), 0);
+    QCOMPARE(any.decode(frame).size(), encoder.codeSize());
+    QCOMPARE(any.sampleRate(), 44100);
+    QCOMPARE(any.channels(), 2);
+}
+
+void SbcCodecTest::streamInfoTest()
+{
+    const QByteArray configuration =
+        sbcConfiguration(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_JOINT_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, SBC_ALLOCATION_LOUDNESS, 53);
+
+    SbcStreamInfo info = SbcStreamInfo::fromConfiguration(configuration);
+    QVERIFY(info.isValid());
+    QCOMPARE(info.frameLength, 119);
+    QCOMPARE(info.samplesPerFrame, 128);
+    QCOMPARE(info.bitrate, 327993);
+    QCOMPARE(info.framesPerPacket, 5);
+    QCOMPARE(info.packetLatency, 14512);
+
+    info = SbcStreamInfo::fromConfiguration(configuration, 1000);
+    QCOMPARE(info.framesPerPacket, 8);
+    QCOMPARE(info.packetLatency, 23219);
+
+    // Packet holds at most 15 frames
+    info = SbcStreamInfo::fromConfiguration(sbcConfiguration(SBC_SAMPLING_FREQ_48000, SBC_CHANNEL_MODE_MONO, SBC_BLOCK_LENGTH_4, SBC_SUBBANDS_4, SBC_ALLOCATION_SNR, 8));
+    QCOMPARE(info.frameLength, 10);
+    QCOMPARE(info.bitrate, 240000);
+    QCOMPARE(info.framesPerPacket, 15);
+    QCOMPARE(info.packetLatency, 5000);
+
+    QVERIFY(!SbcStreamInfo::fromConfiguration(QByteArray()).isValid());
+}
+
+void SbcCodecTest::encodeBenchmark_data()
+{
+    QTest::addColumn<int>("implementation");
+    QTest::addColumn<QByteArray>("configuration");
+
+    for (int implementation = 0; implementation < 4; ++implementation) {
+        QTest::addRow("%s 44.1kHz joint stereo", implementations[implementation])
+            << implementation
+            << sbcConfiguration(SBC_SAMPLING_FREQ_44100, SBC_CHANNEL_MODE_JOINT_STEREO, SBC_BLOCK_LENGTH_16, SBC_SUBBANDS_8, SBC_ALLOCATION_LOUDNESS, 53);
+        QTest::addRow("%s 16kHz mono", implementations[implementation])
+            << implementation
+            << sbcConfiguration(SBC_SAMPLING_FREQ_16000, SBC_CHANNEL_MODE_MONO, SBC_BLOCK_LENGTH_8, SBC_SUBBANDS_4, SBC_ALLOCATION_LOUDNESS, 20);
+    }
+}
+
+// Throughput on one core, reported in frames per second
+void SbcCodecTest::encodeBenchmark()
+{
+    QFETCH(int, implementation);
+    QFETCH(QByteArray, configuration);
+
+    if (!bluezqt_setSbcFilterImplementation(implementation)) {
+        QSKIP("Implementation not supported");
+    }
+
+    const int frames = 20000;
+    SbcEncoder encoder(configuration);
+    const QByteArray pcm = testSignal(encoder.samplesPerFrame() * frames, encoder.channels());
+
+    QElapsedTimer timer;
+    timer.start();
+    const QByteArray encoded = encoder.encode(pcm);
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    QCOMPARE(encoded.size(), encoder.frameLength() * frames);
+    QTest::setBenchmarkResult(frames * 1e9 / qMax<qint64>(elapsed, 1), QTest::FramesPerSecond);
+
+}
+
+void SbcCodecTest::decodeBenchmark_data()
+{
+    encodeBenchmark_data();
+}
+
+void SbcCodecTest::decodeBenchmark()
+{
+    QFETCH(int, implementation);
+    QFETCH(QByteArray, configuration);
+
+    if (!bluezqt_setSbcFilterImplementation(implementation)) {
+        QSKIP("Implementation not supported");
+    }
+
+    const int frames = 20000;
+    SbcEncoder encoder(configuration);
+    const QByteArray encoded = encoder.encode(testSignal(encoder.samplesPerFrame() * frames, encoder.channels()));
+
+    SbcDecoder decoder(configuration);
+    QElapsedTimer timer;
+    timer.start();
+    const QByteArray pcm = decoder.decode(encoded);
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    QCOMPARE(pcm.size(), encoder.codeSize() * frames);
+    QTest::setBenchmarkResult(frames * 1e9 / qMax<qint64>(elapsed, 1), QTest::FramesPerSecond);
+
+}
+
+QTEST_MAIN(SbcCodecTest)
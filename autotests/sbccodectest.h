@@ -0,0 +1,35 @@
+/*
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#ifndef SBCCODECTEST_H
+#define SBCCODECTEST_H
+
+#include <QObject>
+
+class SbcCodecTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void cleanup();
+
+    void configurationTest();
+    void silenceFrameTest();
+    void bitExactnessTest_data();
+    void bitExactnessTest();
+    void referenceVectorTest_data();
+    void referenceVectorTest();
+    void roundTripTest_data();
+    void roundTripTest();
+    void crcErrorTest();
+    void configurationMismatchTest();
+    void streamInfoTest();
+
+    void encodeBenchmark_data();
+    void encodeBenchmark();
+    void decodeBenchmark_data();
+    void decodeBenchmark();
+};
+
+#endif // SBCCODECTEST_H
@@ -0,0 +1,83 @@
+/*
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "uuidtest.h"
+#include "services.h"
+#include "uuid.h"
+
+#include <QSet>
+#include <QTest>
+
+using namespace BluezQt;
+
+void UuidTest::parseTest_data()
+{
+    QTest::addColumn<QString>("string");
+    QTest::addColumn<bool>("valid");
+
+    QTest::newRow("full uppercase") << QStringLiteral("04FA28C0-2D0C-11EC-8D3D-0242AC130003") << true;
+    QTest::newRow("full lowercase") << QStringLiteral("04fa28c0-2d0c-11ec-8d3d-0242ac130003") << true;
+    QTest::newRow("16-bit") << QStringLiteral("180d") << true;
+    QTest::newRow("32-bit") << QStringLiteral("0000180D") << true;
+    QTest::newRow("empty") << QString() << false;
+    QTest::newRow("wrong length") << QStringLiteral("04FA28C0-2D0C-11EC-8D3D-0242AC13000") << false;
+    QTest::newRow("missing dash") << QStringLiteral("04FA28C0X2D0C-11EC-8D3D-0242AC130003") << false;
+    QTest::newRow("not hex") << QStringLiteral("04FA28C0-2D0C-11EC-8D3D-0242AC13000G") << false;
+}
+
+void UuidTest::parseTest()
+{
+    QFETCH(QString, string);
+    QFETCH(bool, valid);
+
+    QCOMPARE(Uuid(string).isNull(), !valid);
+}
+
+void UuidTest::shortFormTest()
+{
+    const Uuid heartRate(Services::HeartRate);
+
+    QVERIFY(heartRate.isShort());
+    QCOMPARE(heartRate.toShort(), quint32(0x180d));
+    QCOMPARE(heartRate, Uuid(0x180d));
+    QCOMPARE(heartRate, Uuid(QStringLiteral("180D")));
+    QCOMPARE(Uuid(0x12345678).toString(), QStringLiteral("12345678-0000-1000-8000-00805F9B34FB"));
+
+    const Uuid custom(QStringLiteral("04FA28C0-2D0C-11EC-8D3D-0242AC130003"));
+    QVERIFY(!custom.isShort());
+    QCOMPARE(custom.toShort(), quint32(0));
+}
+
+void UuidTest::toStringTest()
+{
+    const QString lower = QStringLiteral("04fa28c0-2d0c-11ec-8d3d-0242ac130003");
+
+    QCOMPARE(Uuid(lower).toString(), lower.toUpper());
+    QCOMPARE(Uuid(lower), Uuid(lower.toUpper()));
+    QCOMPARE(Uuid().toString(), QString());
+}
+
+void UuidTest::internedStringTest()
+{
+    // Well-known UUIDs return shared strings
+    const QString a = Uuid(Services::GenericAccess).toString();
+    const QString b = Uuid(0x1800).toString();
+
+    QCOMPARE(a, Services::GenericAccess.toUpper());
+    QVERIFY(a.isSharedWith(b));
+}
+
+void UuidTest::hashTest()
+{
+    QSet<Uuid> set;
+    set.insert(Uuid(Services::AudioSink));
+    set.insert(Uuid(Services::AudioSource));
+    set.insert(Uuid(0x110b));
+
+    QCOMPARE(set.count(), 2);
+    QVERIFY(set.contains(Uuid(QStringLiteral("0000110b-0000-1000-8000-00805f9b34fb"))));
+    QVERIFY(!set.contains(Uuid(Services::Headset)));
+}
+
+QTEST_MAIN(UuidTest)
@@ -0,0 +1,23 @@
+/*
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#ifndef UUIDTEST_H
+#define UUIDTEST_H
+
+#include <QObject>
+
+class UuidTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void parseTest_data();
+    void parseTest();
+    void shortFormTest();
+    void toStringTest();
+    void internedStringTest();
+    void hashTest();
+};
+
+#endif // UUIDTEST_H
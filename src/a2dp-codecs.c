@@ -17,6 +17,7 @@ const a2dp_sbc_t sbcCapabilities = {
     SBC_SAMPLING_FREQ_44100 |
     SBC_SAMPLING_FREQ_48000,
     .channel_mode =
+    /* Mono and dual channel are added for the sink role only. */
     /*SBC_CHANNEL_MODE_MONO |
     SBC_CHANNEL_MODE_DUAL_CHANNEL |*/
     SBC_CHANNEL_MODE_STEREO |
@@ -59,5 +60,33 @@ const a2dp_aac_t aacCapabilities = {
     /*AAC_CHANNELS_1 |*/
     AAC_CHANNELS_2,
     .vbr = 1,
-    AAC_INIT_BITRATE(0xFFFF)
+    /* Highest bitrate of selection policies, see a2dpcodec.cpp */
+    AAC_INIT_BITRATE(320000)
+};
+
+const a2dp_aptx_t aptxCapabilities = {
+    .info = A2DP_SET_VENDOR_ID_CODEC_ID(APTX_VENDOR_ID, APTX_CODEC_ID),
+    .channel_mode =
+    /*APTX_CHANNEL_MODE_MONO |*/
+    APTX_CHANNEL_MODE_STEREO,
+    .frequency =
+    /*APTX_SAMPLING_FREQ_16000 |
+    APTX_SAMPLING_FREQ_32000 |*/
+    APTX_SAMPLING_FREQ_44100 |
+    APTX_SAMPLING_FREQ_48000,
+};
+
+const a2dp_ldac_t ldacCapabilities = {
+    .info = A2DP_SET_VENDOR_ID_CODEC_ID(LDAC_VENDOR_ID, LDAC_CODEC_ID),
+    .frequency =
+    LDAC_SAMPLING_FREQ_44100 |
+    LDAC_SAMPLING_FREQ_48000 |
+    LDAC_SAMPLING_FREQ_88200 |
+    LDAC_SAMPLING_FREQ_96000,
+    /*LDAC_SAMPLING_FREQ_176400 |
+    LDAC_SAMPLING_FREQ_192000,*/
+    .channel_mode =
+    LDAC_CHANNEL_MODE_MONO |
+    LDAC_CHANNEL_MODE_DUAL |
+    LDAC_CHANNEL_MODE_STEREO,
 };
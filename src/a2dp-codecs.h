@@ -104,23 +104,23 @@
 
 #define AAC_SET_BITRATE(a, b) \
 	do { \
-		(a).bitrate1 = (b >> 16) & 0x7f; \
-		(a).bitrate2 = (b >> 8) & 0xff; \
-		(a).bitrate3 = b & 0xff; \
+		(a).bitrate1 = ((b) >> 16) & 0x7f; \
+		(a).bitrate2 = ((b) >> 8) & 0xff; \
+		(a).bitrate3 = (b) & 0xff; \
 	} while (0)
 #define AAC_SET_FREQUENCY(a, f) \
 	do { \
-		(a).frequency1 = (f >> 4) & 0xff; \
-		(a).frequency2 = f & 0x0f; \
+		(a).frequency1 = ((f) >> 4) & 0xff; \
+		(a).frequency2 = (f) & 0x0f; \
 	} while (0)
 
 #define AAC_INIT_BITRATE(b) \
-	.bitrate1 = (b >> 16) & 0x7f, \
-	.bitrate2 = (b >> 8) & 0xff, \
-	.bitrate3 = b & 0xff,
+	.bitrate1 = ((b) >> 16) & 0x7f, \
+	.bitrate2 = ((b) >> 8) & 0xff, \
+	.bitrate3 = (b) & 0xff,
 #define AAC_INIT_FREQUENCY(f) \
-	.frequency1 = (f >> 4) & 0xff, \
-	.frequency2 = f & 0x0f,
+	.frequency1 = ((f) >> 4) & 0xff, \
+	.frequency2 = (f) & 0x0f,
 
 #define APTX_VENDOR_ID			0x0000004f
 #define APTX_CODEC_ID			0x0001
@@ -136,6 +136,17 @@
 #define LDAC_VENDOR_ID			0x0000012d
 #define LDAC_CODEC_ID			0x00aa
 
+#define LDAC_SAMPLING_FREQ_44100	0x20
+#define LDAC_SAMPLING_FREQ_48000	0x10
+#define LDAC_SAMPLING_FREQ_88200	0x08
+#define LDAC_SAMPLING_FREQ_96000	0x04
+#define LDAC_SAMPLING_FREQ_176400	0x02
+#define LDAC_SAMPLING_FREQ_192000	0x01
+
+#define LDAC_CHANNEL_MODE_MONO		0x04
+#define LDAC_CHANNEL_MODE_DUAL		0x02
+#define LDAC_CHANNEL_MODE_STEREO	0x01
+
 typedef struct {
 	uint32_t vendor_id;
 	uint16_t codec_id;
@@ -143,6 +154,9 @@ typedef struct {
 
 #if __BYTE_ORDER == __LITTLE_ENDIAN
 
+#define A2DP_CPU_TO_LE32(v) (v)
+#define A2DP_CPU_TO_LE16(v) (v)
+
 typedef struct {
 	uint8_t channel_mode:4;
 	uint8_t frequency:4;
@@ -183,11 +197,21 @@ typedef struct {
 
 typedef struct {
 	a2dp_vendor_codec_t info;
-	uint8_t unknown[2];
+	__extension__ union {
+		uint8_t unknown[2];
+		__extension__ struct {
+			uint8_t frequency;
+			uint8_t channel_mode;
+		};
+	};
 } __attribute__ ((packed)) a2dp_ldac_t;
 
 #elif __BYTE_ORDER == __BIG_ENDIAN
 
+#define A2DP_CPU_TO_LE32(v) ((((v) & 0xff) << 24) | (((v) & 0xff00) << 8) | \
+				(((v) >> 8) & 0xff00) | (((v) >> 24) & 0xff))
+#define A2DP_CPU_TO_LE16(v) ((((v) & 0xff) << 8) | (((v) >> 8) & 0xff))
+
 typedef struct {
 	uint8_t frequency:4;
 	uint8_t channel_mode:4;
@@ -228,13 +252,25 @@ typedef struct {
 
 typedef struct {
 	a2dp_vendor_codec_t info;
-	uint8_t unknown[2];
+	__extension__ union {
+		uint8_t unknown[2];
+		__extension__ struct {
+			uint8_t frequency;
+			uint8_t channel_mode;
+		};
+	};
 } __attribute__ ((packed)) a2dp_ldac_t;
 
 #else
 #error "Unknown byte order"
 #endif
 
+/* Vendor and codec ids are little endian on the air */
+#define A2DP_SET_VENDOR_ID_CODEC_ID(v, c) { \
+		.vendor_id = A2DP_CPU_TO_LE32(v), \
+		.codec_id = A2DP_CPU_TO_LE16(c), \
+	}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -243,6 +279,8 @@ extern "C" {
 
 BLUEZQT_EXPORT extern const a2dp_sbc_t sbcCapabilities;
 BLUEZQT_EXPORT extern const a2dp_aac_t aacCapabilities;
+BLUEZQT_EXPORT extern const a2dp_aptx_t aptxCapabilities;
+BLUEZQT_EXPORT extern const a2dp_ldac_t ldacCapabilities;
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,510 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "a2dpcodec_p.h"
+#include "a2dp-codecs.h"
+#include "sbcframe_p.h"
+#include "sbcstreaminfo.h"
+
+#include <QtEndian>
+
+namespace BluezQt
+{
+// Option of codec specific field, value is sample rate or number of channels
+struct Option {
+    quint32 flag;
+    int value;
+};
+
+// Options are in order of preference
+static constexpr Option sbcFrequencies[] = {
+    {SBC_SAMPLING_FREQ_44100, 44100},
+    {SBC_SAMPLING_FREQ_48000, 48000},
+    {SBC_SAMPLING_FREQ_32000, 32000},
+    {SBC_SAMPLING_FREQ_16000, 16000},
+};
+
+static constexpr Option sbcChannelModes[] = {
+    {SBC_CHANNEL_MODE_STEREO, 2},
+    {SBC_CHANNEL_MODE_JOINT_STEREO, 2},
+    {SBC_CHANNEL_MODE_DUAL_CHANNEL, 2},
+    {SBC_CHANNEL_MODE_MONO, 1},
+};
+
+// Recommended by A2DP specification for high quality joint stereo at 44.1 kHz
+static const int sbcDefaultBitpool = 53;
+
+static constexpr Option sbcBlockLengths[] = {
+    {SBC_BLOCK_LENGTH_16, 16},
+    {SBC_BLOCK_LENGTH_12, 12},
+    {SBC_BLOCK_LENGTH_8, 8},
+    {SBC_BLOCK_LENGTH_4, 4},
+};
+
+static constexpr Option sbcSubbands[] = {
+    {SBC_SUBBANDS_8, 8},
+    {SBC_SUBBANDS_4, 4},
+};
+
+static constexpr Option sbcAllocationMethods[] = {
+    {SBC_ALLOCATION_LOUDNESS, 0},
+    {SBC_ALLOCATION_SNR, 0},
+};
+
+// MPEG-2 AAC LC is mandatory for A2DP sinks
+static constexpr Option aacObjectTypes[] = {
+    {AAC_OBJECT_TYPE_MPEG2_AAC_LC, 0},
+    {AAC_OBJECT_TYPE_MPEG4_AAC_LC, 0},
+    {AAC_OBJECT_TYPE_MPEG4_AAC_LTP, 0},
+    {AAC_OBJECT_TYPE_MPEG4_AAC_SCA, 0},
+};
+
+// Higher sample rate gives shorter frames of 1024 samples
+static constexpr Option aacFrequencies[] = {
+    {AAC_SAMPLING_FREQ_96000, 96000},
+    {AAC_SAMPLING_FREQ_88200, 88200},
+    {AAC_SAMPLING_FREQ_64000, 64000},
+    {AAC_SAMPLING_FREQ_48000, 48000},
+    {AAC_SAMPLING_FREQ_44100, 44100},
+    {AAC_SAMPLING_FREQ_32000, 32000},
+    {AAC_SAMPLING_FREQ_24000, 24000},
+    {AAC_SAMPLING_FREQ_22050, 22050},
+    {AAC_SAMPLING_FREQ_16000, 16000},
+    {AAC_SAMPLING_FREQ_12000, 12000},
+    {AAC_SAMPLING_FREQ_11025, 11025},
+    {AAC_SAMPLING_FREQ_8000, 8000},
+};
+
+static constexpr Option aacChannels[] = {
+    {AAC_CHANNELS_2, 2},
+    {AAC_CHANNELS_1, 1},
+};
+
+struct AacPolicy {
+    MediaEndpoint::Preference preference;
+    quint32 maxBitrate;
+    bool vbr;
+};
+
+// 192 kb/s keeps frames at 44.1 kHz and above within one 2-DH5 packet (679 bytes)
+static constexpr AacPolicy aacPolicies[] = {
+    {MediaEndpoint::Preference::HighestBitrate, 320000, true},
+    {MediaEndpoint::Preference::LowestLatency, 192000, false},
+};
+
+static constexpr Option aptxFrequencies[] = {
+    {APTX_SAMPLING_FREQ_48000, 48000},
+    {APTX_SAMPLING_FREQ_44100, 44100},
+    {APTX_SAMPLING_FREQ_32000, 32000},
+    {APTX_SAMPLING_FREQ_16000, 16000},
+};
+
+static constexpr Option aptxChannelModes[] = {
+    {APTX_CHANNEL_MODE_STEREO, 2},
+    {APTX_CHANNEL_MODE_MONO, 1},
+};
+
+static constexpr Option ldacFrequencies[] = {
+    {LDAC_SAMPLING_FREQ_192000, 192000},
+    {LDAC_SAMPLING_FREQ_176400, 176400},
+    {LDAC_SAMPLING_FREQ_96000, 96000},
+    {LDAC_SAMPLING_FREQ_88200, 88200},
+    {LDAC_SAMPLING_FREQ_48000, 48000},
+    {LDAC_SAMPLING_FREQ_44100, 44100},
+};
+
+static constexpr Option ldacChannelModes[] = {
+    {LDAC_CHANNEL_MODE_STEREO, 2},
+    {LDAC_CHANNEL_MODE_DUAL, 2},
+    {LDAC_CHANNEL_MODE_MONO, 1},
+};
+
+static constexpr struct {
+    int sampleRate;
+    AudioSampleRate audioSampleRate;
+} audioSampleRates[] = {
+    {8000, AudioSampleRate::Rate8000},
+    {11025, AudioSampleRate::Rate11025},
+    {12000, AudioSampleRate::Rate12000},
+    {16000, AudioSampleRate::Rate16000},
+    {22050, AudioSampleRate::Rate22050},
+    {24000, AudioSampleRate::Rate24000},
+    {32000, AudioSampleRate::Rate32000},
+    {44100, AudioSampleRate::Rate44100},
+    {48000, AudioSampleRate::Rate48000},
+    {64000, AudioSampleRate::Rate64000},
+    {88200, AudioSampleRate::Rate88200},
+    {96000, AudioSampleRate::Rate96000},
+};
+
+template<size_t N>
+static const Option *firstCommon(const Option (&options)[N], quint32 remote, quint32 local)
+{
+    for (const Option &option : options) {
+        if ((remote & option.flag) && (local & option.flag)) {
+            return &option;
+        }
+    }
+    return nullptr;
+}
+
+// Value of configuration field, exactly one option must be set
+template<size_t N>
+static int valueOf(const Option (&options)[N], quint32 flag)
+{
+    for (const Option &option : options) {
+        if (option.flag == flag) {
+            return option.value;
+        }
+    }
+    return 0;
+}
+
+template<typename T>
+static T fromByteArray(const QByteArray &data)
+{
+    return *reinterpret_cast<const T *>(data.constData());
+}
+
+template<typename T>
+static QByteArray toByteArray(const T &value)
+{
+    return QByteArray(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+// Highest bitpool of range with bitrate not exceeding the target
+static int sbcBitpool(SbcFrameHeader header, int bitrate, int minBitpool, int maxBitpool)
+{
+    if (bitrate <= 0) {
+        return qBound(minBitpool, sbcDefaultBitpool, maxBitpool);
+    }
+
+    for (header.bitpool = maxBitpool; header.bitpool > minBitpool; --header.bitpool) {
+        if (header.bitrate() <= bitrate) {
+            break;
+        }
+    }
+    return header.bitpool;
+}
+
+static quint32 sbcChannelModeFlag(MediaEndpoint::ChannelMode mode)
+{
+    switch (mode) {
+    case MediaEndpoint::ChannelMode::Mono:
+        return SBC_CHANNEL_MODE_MONO;
+    case MediaEndpoint::ChannelMode::DualChannel:
+        return SBC_CHANNEL_MODE_DUAL_CHANNEL;
+    case MediaEndpoint::ChannelMode::Stereo:
+        return SBC_CHANNEL_MODE_STEREO;
+    case MediaEndpoint::ChannelMode::JointStereo:
+        return SBC_CHANNEL_MODE_JOINT_STEREO;
+    }
+    return SBC_CHANNEL_MODE_STEREO;
+}
+
+// Mono and dual channel streams are only accepted, never sent
+static a2dp_sbc_t sbcOwnCapabilities(const A2dpPolicy &policy)
+{
+    a2dp_sbc_t sbc = sbcCapabilities;
+    if (policy.role == MediaEndpoint::Role::AudioSink) {
+        sbc.channel_mode |= SBC_CHANNEL_MODE_MONO | SBC_CHANNEL_MODE_DUAL_CHANNEL;
+    }
+    return sbc;
+}
+
+static QByteArray selectSbcConfiguration(const QByteArray &capabilities, const A2dpPolicy &policy)
+{
+    const a2dp_sbc_t caps = fromByteArray<a2dp_sbc_t>(capabilities);
+    const a2dp_sbc_t own = sbcOwnCapabilities(policy);
+
+    const Option *frequency = firstCommon(sbcFrequencies, caps.frequency, own.frequency);
+    const Option *channelMode = firstCommon(sbcChannelModes, caps.channel_mode, own.channel_mode);
+    const Option *allocationMethod = firstCommon(sbcAllocationMethods, caps.allocation_method, own.allocation_method);
+    if (!frequency || !channelMode || !allocationMethod) {
+        return QByteArray();
+    }
+
+    const quint32 preferredChannelMode = sbcChannelModeFlag(policy.channelMode);
+
+    a2dp_sbc_t sbc = a2dp_sbc_t();
+    sbc.frequency = frequency->flag;
+    sbc.channel_mode = (caps.channel_mode & own.channel_mode & preferredChannelMode) ? preferredChannelMode : channelMode->flag;
+    sbc.allocation_method = allocationMethod->flag;
+    sbc.min_bitpool = qMax<int>(caps.min_bitpool, own.min_bitpool);
+    sbc.max_bitpool = qMin<int>(caps.max_bitpool, own.max_bitpool);
+
+    // Frames get shorter in order of preference, lowest latency is used if none fits the budget
+    QByteArray lowestLatency;
+    int lowestPacketLatency = 0;
+
+    for (const Option &blockLength : sbcBlockLengths) {
+        for (const Option &subbands : sbcSubbands) {
+            if (!(caps.block_length & own.block_length & blockLength.flag) || !(caps.subbands & own.subbands & subbands.flag)) {
+                continue;
+            }
+
+            a2dp_sbc_t candidate = sbc;
+            candidate.block_length = blockLength.flag;
+            candidate.subbands = subbands.flag;
+
+            SbcFrameHeader header;
+            int minBitpool;
+            int maxBitpool;
+            if (!header.parseConfiguration(toByteArray(candidate), &minBitpool, &maxBitpool)) {
+                continue;
+            }
+
+            header.bitpool = sbcBitpool(header, policy.bitrate, minBitpool, maxBitpool);
+            candidate.max_bitpool = header.bitpool;
+
+            const int packetLatency = header.packetLatency(SbcStreamInfo::defaultMtu);
+            if (policy.packetLatency <= 0 || packetLatency <= policy.packetLatency) {
+                return toByteArray(candidate);
+            }
+
+            if (lowestLatency.isEmpty() || packetLatency < lowestPacketLatency) {
+                lowestLatency = toByteArray(candidate);
+                lowestPacketLatency = packetLatency;
+            }
+        }
+    }
+    return lowestLatency;
+}
+
+static int sbcSampleRate(const QByteArray &configuration)
+{
+    return valueOf(sbcFrequencies, fromByteArray<a2dp_sbc_t>(configuration).frequency);
+}
+
+static int sbcChannels(const QByteArray &configuration)
+{
+    return valueOf(sbcChannelModes, fromByteArray<a2dp_sbc_t>(configuration).channel_mode);
+}
+
+static const AacPolicy &aacPolicy(MediaEndpoint::Preference preference)
+{
+    for (const AacPolicy &candidate : aacPolicies) {
+        if (candidate.preference == preference) {
+            return candidate;
+        }
+    }
+    return aacPolicies[0];
+}
+
+// Advertised bitrate does not exceed the one we would select
+static a2dp_aac_t aacOwnCapabilities(const A2dpPolicy &policy)
+{
+    a2dp_aac_t aac = aacCapabilities;
+    const quint32 bitrate = qMin<quint32>(AAC_GET_BITRATE(aac), aacPolicy(policy.preference).maxBitrate);
+    AAC_SET_BITRATE(aac, bitrate);
+    return aac;
+}
+
+static QByteArray selectAacConfiguration(const QByteArray &capabilities, const A2dpPolicy &policy)
+{
+    const a2dp_aac_t caps = fromByteArray<a2dp_aac_t>(capabilities);
+    const a2dp_aac_t own = aacOwnCapabilities(policy);
+
+    const Option *objectType = firstCommon(aacObjectTypes, caps.object_type, own.object_type);
+    const Option *frequency = firstCommon(aacFrequencies, AAC_GET_FREQUENCY(caps), AAC_GET_FREQUENCY(own));
+    const Option *channels = firstCommon(aacChannels, caps.channels, own.channels);
+    if (!objectType || !frequency || !channels) {
+        return QByteArray();
+    }
+
+    // Zero bitrate means the remote endpoint does not limit it
+    quint32 bitrate = AAC_GET_BITRATE(caps);
+    if (bitrate == 0 || bitrate > AAC_GET_BITRATE(own)) {
+        bitrate = AAC_GET_BITRATE(own);
+    }
+
+    a2dp_aac_t aac = a2dp_aac_t();
+    aac.object_type = objectType->flag;
+    AAC_SET_FREQUENCY(aac, frequency->flag);
+    aac.channels = channels->flag;
+    aac.vbr = aacPolicy(policy.preference).vbr && caps.vbr && own.vbr;
+    AAC_SET_BITRATE(aac, bitrate);
+    return toByteArray(aac);
+}
+
+static int aacSampleRate(const QByteArray &configuration)
+{
+    return valueOf(aacFrequencies, AAC_GET_FREQUENCY(fromByteArray<a2dp_aac_t>(configuration)));
+}
+
+static int aacChannelCount(const QByteArray &configuration)
+{
+    return valueOf(aacChannels, fromByteArray<a2dp_aac_t>(configuration).channels);
+}
+
+static QByteArray selectAptxConfiguration(const QByteArray &capabilities, const A2dpPolicy &)
+{
+    const a2dp_aptx_t caps = fromByteArray<a2dp_aptx_t>(capabilities);
+
+    const Option *frequency = firstCommon(aptxFrequencies, caps.frequency, aptxCapabilities.frequency);
+    const Option *channelMode = firstCommon(aptxChannelModes, caps.channel_mode, aptxCapabilities.channel_mode);
+    if (!frequency || !channelMode) {
+        return QByteArray();
+    }
+
+    a2dp_aptx_t configuration = a2dp_aptx_t();
+    configuration.info = caps.info;
+    configuration.frequency = frequency->flag;
+    configuration.channel_mode = channelMode->flag;
+    return toByteArray(configuration);
+}
+
+static int aptxSampleRate(const QByteArray &configuration)
+{
+    return valueOf(aptxFrequencies, fromByteArray<a2dp_aptx_t>(configuration).frequency);
+}
+
+static int aptxChannels(const QByteArray &configuration)
+{
+    return valueOf(aptxChannelModes, fromByteArray<a2dp_aptx_t>(configuration).channel_mode);
+}
+
+static QByteArray selectLdacConfiguration(const QByteArray &capabilities, const A2dpPolicy &)
+{
+    const a2dp_ldac_t caps = fromByteArray<a2dp_ldac_t>(capabilities);
+
+    const Option *frequency = firstCommon(ldacFrequencies, caps.frequency, ldacCapabilities.frequency);
+    const Option *channelMode = firstCommon(ldacChannelModes, caps.channel_mode, ldacCapabilities.channel_mode);
+    if (!frequency || !channelMode) {
+        return QByteArray();
+    }
+
+    a2dp_ldac_t configuration = a2dp_ldac_t();
+    configuration.info = caps.info;
+    configuration.frequency = frequency->flag;
+    configuration.channel_mode = channelMode->flag;
+    return toByteArray(configuration);
+}
+
+static int ldacSampleRate(const QByteArray &configuration)
+{
+    return valueOf(ldacFrequencies, fromByteArray<a2dp_ldac_t>(configuration).frequency);
+}
+
+static int ldacChannels(const QByteArray &configuration)
+{
+    return valueOf(ldacChannelModes, fromByteArray<a2dp_ldac_t>(configuration).channel_mode);
+}
+
+static const A2dpCodec codecs[] = {
+    {MediaEndpoint::Codec::Sbc,
+     AudioCodec::Sbc,
+     A2DP_CODEC_SBC,
+     0,
+     0,
+     "Sbc",
+     &sbcCapabilities,
+     sizeof(a2dp_sbc_t),
+     selectSbcConfiguration,
+     sbcSampleRate,
+     sbcChannels},
+    {MediaEndpoint::Codec::Aac,
+     AudioCodec::Aac,
+     A2DP_CODEC_MPEG24,
+     0,
+     0,
+     "Aac",
+     &aacCapabilities,
+     sizeof(a2dp_aac_t),
+     selectAacConfiguration,
+     aacSampleRate,
+     aacChannelCount},
+    {MediaEndpoint::Codec::AptX,
+     AudioCodec::AptX,
+     A2DP_CODEC_VENDOR,
+     APTX_VENDOR_ID,
+     APTX_CODEC_ID,
+     "AptX",
+     &aptxCapabilities,
+     sizeof(a2dp_aptx_t),
+     selectAptxConfiguration,
+     aptxSampleRate,
+     aptxChannels},
+    {MediaEndpoint::Codec::Ldac,
+     AudioCodec::Ldac,
+     A2DP_CODEC_VENDOR,
+     LDAC_VENDOR_ID,
+     LDAC_CODEC_ID,
+     "Ldac",
+     &ldacCapabilities,
+     sizeof(a2dp_ldac_t),
+     selectLdacConfiguration,
+     ldacSampleRate,
+     ldacChannels},
+};
+
+static bool matchesVendor(const A2dpCodec &codec, const QByteArray &data)
+{
+    if (data.size() < int(sizeof(a2dp_vendor_codec_t))) {
+        return false;
+    }
+
+    const a2dp_vendor_codec_t info = fromByteArray<a2dp_vendor_codec_t>(data);
+    return qFromLittleEndian(info.vendor_id) == codec.vendorId && qFromLittleEndian(info.codec_id) == codec.vendorCodecId;
+}
+
+bool A2dpCodec::matches(const QByteArray &data) const
+{
+    if (data.size() != size) {
+        return false;
+    }
+    return id != A2DP_CODEC_VENDOR || matchesVendor(*this, data);
+}
+
+QByteArray A2dpCodec::ownCapabilities(const A2dpPolicy &policy) const
+{
+    switch (codec) {
+    case AudioCodec::Sbc:
+        return toByteArray(sbcOwnCapabilities(policy));
+    case AudioCodec::Aac:
+        return toByteArray(aacOwnCapabilities(policy));
+    default:
+        break;
+    }
+    return QByteArray(static_cast<const char *>(capabilities), size);
+}
+
+AudioSampleRate A2dpCodec::audioSampleRate(const QByteArray &configuration) const
+{
+    if (!matches(configuration)) {
+        return AudioSampleRate::Invalid;
+    }
+
+    const int rate = sampleRate(configuration);
+    for (const auto &entry : audioSampleRates) {
+        if (entry.sampleRate == rate) {
+            return entry.audioSampleRate;
+        }
+    }
+    return AudioSampleRate::Invalid;
+}
+
+const A2dpCodec *A2dpCodec::find(MediaEndpoint::Codec codec)
+{
+    for (const A2dpCodec &candidate : codecs) {
+        if (candidate.endpointCodec == codec) {
+            return &candidate;
+        }
+    }
+    return nullptr;
+}
+
+const A2dpCodec *A2dpCodec::find(quint8 id, const QByteArray &configuration)
+{
+    for (const A2dpCodec &candidate : codecs) {
+        if (candidate.id == id && (id != A2DP_CODEC_VENDOR || matchesVendor(candidate, configuration))) {
+            return &candidate;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace BluezQt
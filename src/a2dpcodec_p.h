@@ -0,0 +1,63 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include "mediaendpoint.h"
+#include "mediatypes.h"
+
+namespace BluezQt
+{
+// Policy of configuration selection, see MediaEndpoint
+struct A2dpPolicy {
+    MediaEndpoint::Role role = MediaEndpoint::Role::AudioSource;
+    MediaEndpoint::Preference preference = MediaEndpoint::Preference::HighestBitrate;
+    int bitrate = 0;
+    int packetLatency = 0;
+    MediaEndpoint::ChannelMode channelMode = MediaEndpoint::ChannelMode::Stereo;
+};
+
+// Descriptor of A2DP codec, capabilities and configurations are the codec
+// specific information elements defined in A2DP specification, section 4
+struct A2dpCodec {
+    MediaEndpoint::Codec endpointCodec;
+    AudioCodec codec;
+    quint8 id;
+
+    // Only used for A2DP_CODEC_VENDOR, information element starts with these ids
+    quint32 vendorId;
+    quint16 vendorCodecId;
+
+    // Last element of endpoint object path
+    const char *name;
+
+    // Our capabilities and size of the information element
+    const void *capabilities;
+    int size;
+
+    // Selects configuration from capabilities of remote endpoint, returns empty array if there is none
+    QByteArray (*selectConfiguration)(const QByteArray &capabilities, const A2dpPolicy &policy);
+
+    // Sample rate in Hz and number of channels of configuration, 0 if not valid
+    int (*sampleRate)(const QByteArray &configuration);
+    int (*channels)(const QByteArray &configuration);
+
+    // Checks size and vendor ids of capabilities or configuration
+    bool matches(const QByteArray &data) const;
+
+    // Capabilities limited by the policy
+    QByteArray ownCapabilities(const A2dpPolicy &policy) const;
+    AudioSampleRate audioSampleRate(const QByteArray &configuration) const;
+
+    static const A2dpCodec *find(MediaEndpoint::Codec codec);
+
+    // Vendor codecs are found by ids at start of configuration
+    static const A2dpCodec *find(quint8 id, const QByteArray &configuration);
+};
+
+} // namespace BluezQt
@@ -31,7 +31,7 @@ AdapterPtr Adapter::toSharedPtr() const
 
 QString Adapter::ubi() const
 {
-    return d->m_bluezAdapter->path();
+    return d->m_path;
 }
 
 QString Adapter::address() const
@@ -119,6 +119,11 @@ QStringList Adapter::uuids() const
     return d->m_uuids;
 }
 
+QVector<Uuid> Adapter::uuidValues() const
+{
+    return d->m_uuidValues;
+}
+
 QString Adapter::modalias() const
 {
     return d->m_modalias;
@@ -144,6 +149,13 @@ QList<DevicePtr> Adapter::devices() const
     return d->m_devices;
 }
 
+void Adapter::forEachDevice(const std::function<void(const DevicePtr &)> &callback) const
+{
+    for (const DevicePtr &device : std::as_const(d->m_devices)) {
+        callback(device);
+    }
+}
+
 DevicePtr Adapter::deviceForAddress(const QString &address) const
 {
     for (DevicePtr device : std::as_const(d->m_devices)) {
@@ -156,27 +168,27 @@ DevicePtr Adapter::deviceForAddress(const QString &address) const
 
 PendingCall *Adapter::startDiscovery()
 {
-    return new PendingCall(d->m_bluezAdapter->StartDiscovery(), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezAdapter()->StartDiscovery(), PendingCall::ReturnVoid, this);
 }
 
 PendingCall *Adapter::stopDiscovery()
 {
-    return new PendingCall(d->m_bluezAdapter->StopDiscovery(), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezAdapter()->StopDiscovery(), PendingCall::ReturnVoid, this);
 }
 
 PendingCall *Adapter::removeDevice(DevicePtr device)
 {
-    return new PendingCall(d->m_bluezAdapter->RemoveDevice(QDBusObjectPath(device->ubi())), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezAdapter()->RemoveDevice(QDBusObjectPath(device->ubi())), PendingCall::ReturnVoid, this);
 }
 
 PendingCall* Adapter::setDiscoveryFilter(const QVariantMap& filter)
 {
-    return new PendingCall(d->m_bluezAdapter->SetDiscoveryFilter(filter), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezAdapter()->SetDiscoveryFilter(filter), PendingCall::ReturnVoid, this);
 }
 
 PendingCall* Adapter::getDiscoveryFilters()
 {
-    return new PendingCall(d->m_bluezAdapter->GetDiscoveryFilters(), PendingCall::ReturnStringList, this);
+    return new PendingCall(d->bluezAdapter()->GetDiscoveryFilters(), PendingCall::ReturnStringList, this);
 }
 
 } // namespace BluezQt
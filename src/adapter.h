@@ -12,11 +12,15 @@
 #include <QList>
 #include <QObject>
 #include <QStringList>
+#include <QVector>
+
+#include <functional>
 
 #include "bluezqt_export.h"
 #include "device.h"
 #include "leadvertisingmanager.h"
 #include "media.h"
+#include "uuid.h"
 
 namespace BluezQt
 {
@@ -211,6 +215,16 @@ public:
      */
     QStringList uuids() const;
 
+    /**
+     * Returns UUIDs of supported services by the adapter.
+     *
+     * This is the same list as uuids(), but UUIDs are returned
+     * as values that are compared as integers.
+     *
+     * @return UUIDs of supported services
+     */
+    QVector<Uuid> uuidValues() const;
+
     /**
      * Returns local device ID in modalias format.
      *
@@ -246,6 +260,15 @@ public:
      */
     QList<DevicePtr> devices() const;
 
+    /**
+     * Calls the callback for each device known by the adapter.
+     *
+     * Devices must not be added or removed from the callback.
+     *
+     * @param callback function called with each device
+     */
+    void forEachDevice(const std::function<void(const DevicePtr &)> &callback) const;
+
     /**
      * Returns a device for specified address.
      *
@@ -14,12 +14,15 @@
 #include "macros.h"
 #include "media.h"
 #include "media_p.h"
+#include "orderedlist_p.h"
 #include "utils.h"
 
 namespace BluezQt
 {
 AdapterPrivate::AdapterPrivate(const QString &path, const QVariantMap &properties)
     : QObject()
+    , m_path(path)
+    , m_bluezAdapter(nullptr)
     , m_dbusProperties(nullptr)
     , m_adapterClass(0)
     , m_powered(0)
@@ -28,15 +31,11 @@ AdapterPrivate::AdapterPrivate(const QString &path, const QVariantMap &propertie
     , m_pairable(false)
     , m_pairableTimeout(0)
 {
-    m_bluezAdapter = new BluezAdapter(Strings::orgBluez(), path, DBusConnection::orgBluez(), this);
-
     init(properties);
 }
 
 void AdapterPrivate::init(const QVariantMap &properties)
 {
-    m_dbusProperties = new DBusProperties(Strings::orgBluez(), m_bluezAdapter->path(), DBusConnection::orgBluez(), this);
-
     // Init properties
     m_address = properties.value(QStringLiteral("Address")).toString();
     m_name = properties.value(QStringLiteral("Name")).toString();
@@ -48,7 +47,7 @@ void AdapterPrivate::init(const QVariantMap &properties)
     m_pairable = properties.value(QStringLiteral("Pairable")).toBool();
     m_pairableTimeout = properties.value(QStringLiteral("PairableTimeout")).toUInt();
     m_discovering = properties.value(QStringLiteral("Discovering")).toBool();
-    m_uuids = stringListToUpper(properties.value(QStringLiteral("UUIDs")).toStringList());
+    m_uuids = uuidListToUpper(properties.value(QStringLiteral("UUIDs")).toStringList(), &m_uuidValues);
     m_modalias = properties.value(QStringLiteral("Modalias")).toString();
 }
 
@@ -100,7 +99,7 @@ void AdapterPrivate::interfacesRemoved(const QString &path, const QStringList &i
 
 void AdapterPrivate::addDevice(const DevicePtr &device)
 {
-    m_devices.append(device);
+    appendToList(m_devices, m_deviceKeys, device);
     Q_EMIT q.lock()->deviceAdded(device);
 
     connect(device.data(), &Device::deviceChanged, q.lock().data(), &Adapter::deviceChanged);
@@ -108,16 +107,45 @@ void AdapterPrivate::addDevice(const DevicePtr &device)
 
 void AdapterPrivate::removeDevice(const DevicePtr &device)
 {
-    m_devices.removeOne(device);
+    removeFromList(m_devices, m_deviceKeys, device);
     Q_EMIT device->deviceRemoved(device);
     Q_EMIT q.lock()->deviceRemoved(device);
 
     disconnect(device.data(), &Device::deviceChanged, q.lock().data(), &Adapter::deviceChanged);
 }
 
+BluezAdapter *AdapterPrivate::bluezAdapter()
+{
+    if (!m_bluezAdapter) {
+        m_bluezAdapter = new BluezAdapter(Strings::orgBluez(), m_path, DBusConnection::orgBluez(), this);
+    }
+    return m_bluezAdapter;
+}
+
+DBusProperties *AdapterPrivate::dbusProperties()
+{
+    if (!m_dbusProperties) {
+        m_dbusProperties = new DBusProperties(Strings::orgBluez(), m_path, DBusConnection::orgBluez(), this);
+    }
+    return m_dbusProperties;
+}
+
 QDBusPendingReply<> AdapterPrivate::setDBusProperty(const QString &name, const QVariant &value)
 {
-    return m_dbusProperties->Set(Strings::orgBluezAdapter1(), name, QDBusVariant(value));
+    return dbusProperties()->Set(Strings::orgBluezAdapter1(), name, QDBusVariant(value));
+}
+
+void AdapterPrivate::uuidsPropertyChanged(const QStringList &value)
+{
+    QVector<Uuid> uuids;
+    const QStringList strings = uuidListToUpper(value, &uuids);
+
+    // Strings only need comparing when some of them are not valid UUIDs
+    if (m_uuidValues != uuids || (uuids.contains(Uuid()) && m_uuids != strings)) {
+        m_uuidValues = uuids;
+        m_uuids = strings;
+        Q_EMIT q.lock()->uuidsChanged(m_uuids);
+    }
 }
 
 void AdapterPrivate::propertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
@@ -152,7 +180,7 @@ void AdapterPrivate::propertiesChanged(const QString &interface, const QVariantM
         } else if (property == QLatin1String("Modalias")) {
             PROPERTY_CHANGED(m_modalias, toString, modaliasChanged);
         } else if (property == QLatin1String("UUIDs")) {
-            PROPERTY_CHANGED2(m_uuids, stringListToUpper(value.toStringList()), uuidsChanged);
+            uuidsPropertyChanged(value.toStringList());
         }
     }
 
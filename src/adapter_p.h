@@ -9,13 +9,16 @@
 #ifndef BLUEZQT_ADAPTER_P_H
 #define BLUEZQT_ADAPTER_P_H
 
+#include <QHash>
 #include <QObject>
 #include <QStringList>
+#include <QVector>
 
 #include "bluezadapter1.h"
 #include "bluezqt_dbustypes.h"
 #include "dbusproperties.h"
 #include "types.h"
+#include "uuid.h"
 
 namespace BluezQt
 {
@@ -37,10 +40,15 @@ public:
     void addDevice(const DevicePtr &device);
     void removeDevice(const DevicePtr &device);
 
+    BluezAdapter *bluezAdapter();
+    DBusProperties *dbusProperties();
+
     QDBusPendingReply<> setDBusProperty(const QString &name, const QVariant &value);
+    void uuidsPropertyChanged(const QStringList &value);
     void propertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
 
     QWeakPointer<Adapter> q;
+    QString m_path;
     BluezAdapter *m_bluezAdapter;
     DBusProperties *m_dbusProperties;
 
@@ -55,7 +63,9 @@ public:
     quint32 m_pairableTimeout;
     bool m_discovering;
     QStringList m_uuids;
+    QVector<Uuid> m_uuidValues;
     QList<DevicePtr> m_devices;
+    QHash<Device *, qint64> m_deviceKeys;
     QString m_modalias;
     MediaPtr m_media;
     GattManagerPtr m_gattManager;
@@ -31,7 +31,7 @@ DevicePtr Device::toSharedPtr() const
 
 QString Device::ubi() const
 {
-    return d->m_bluezDevice->path();
+    return d->m_path;
 }
 
 QString Device::address() const
@@ -131,6 +131,21 @@ qint16 Device::rssi() const
     return d->m_rssi;
 }
 
+qint16 Device::rawRssi() const
+{
+    return d->m_rawRssi;
+}
+
+Device::UpdatePolicy Device::updatePolicy() const
+{
+    return d->m_updatePolicy;
+}
+
+void Device::setUpdatePolicy(const UpdatePolicy &policy)
+{
+    d->setUpdatePolicy(policy);
+}
+
 ManData Device::manufacturerData() const
 {
     return d->m_manufacturerData;
@@ -151,6 +166,11 @@ QStringList Device::uuids() const
     return d->m_uuids;
 }
 
+QVector<Uuid> Device::uuidValues() const
+{
+    return d->m_uuidValues;
+}
+
 QString Device::modalias() const
 {
     return d->m_modalias;
@@ -191,6 +211,55 @@ QList<GattServiceRemotePtr> Device::gattServices() const
     return d->m_services;
 }
 
+GattDatabase Device::gattDatabase() const
+{
+    return d->gattDatabase();
+}
+
+GattServiceRemotePtr Device::findService(const Uuid &uuid) const
+{
+    d->ensureGattIndex();
+
+    GattServiceRemotePtr found;
+    for (auto it = d->m_servicesByUuid.constFind(uuid); it != d->m_servicesByUuid.constEnd() && it.key() == uuid; ++it) {
+        if (!found || it.value()->handle() < found->handle()) {
+            found = it.value();
+        }
+    }
+    return found;
+}
+
+GattCharacteristicRemotePtr Device::findCharacteristic(const Uuid &serviceUuid, const Uuid &characteristicUuid) const
+{
+    d->ensureGattIndex();
+
+    GattCharacteristicRemotePtr found;
+    for (auto it = d->m_servicesByUuid.constFind(serviceUuid); it != d->m_servicesByUuid.constEnd() && it.key() == serviceUuid; ++it) {
+        const GattCharacteristicRemotePtr characteristic = it.value()->findCharacteristic(characteristicUuid);
+        if (characteristic && (!found || characteristic->handle() < found->handle())) {
+            found = characteristic;
+        }
+    }
+    return found;
+}
+
+GattCharacteristicRemotePtr Device::findByHandle(quint16 handle) const
+{
+    d->ensureGattIndex();
+
+    return d->m_characteristicsByHandle.value(handle);
+}
+
+GattReadJob *Device::readCharacteristics(const QList<GattCharacteristicRemotePtr> &characteristics, const QVariantMap &options)
+{
+    return new GattReadJob(characteristics, options, this);
+}
+
+GattDatabase Device::cachedGattDatabase() const
+{
+    return GattDatabase::loadCache(d->m_address);
+}
+
 QString Device::typeToString(Device::Type type)
 {
     switch (type) {
@@ -279,32 +348,32 @@ Device::Type Device::stringToType(const QString &typeString)
 
 PendingCall *Device::connectToDevice()
 {
-    return new PendingCall(d->m_bluezDevice->Connect(), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezDevice()->Connect(), PendingCall::ReturnVoid, this);
 }
 
 PendingCall *Device::disconnectFromDevice()
 {
-    return new PendingCall(d->m_bluezDevice->Disconnect(), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezDevice()->Disconnect(), PendingCall::ReturnVoid, this);
 }
 
 PendingCall *Device::connectProfile(const QString &uuid)
 {
-    return new PendingCall(d->m_bluezDevice->ConnectProfile(uuid), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezDevice()->ConnectProfile(uuid), PendingCall::ReturnVoid, this);
 }
 
 PendingCall *Device::disconnectProfile(const QString &uuid)
 {
-    return new PendingCall(d->m_bluezDevice->DisconnectProfile(uuid), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezDevice()->DisconnectProfile(uuid), PendingCall::ReturnVoid, this);
 }
 
 PendingCall *Device::pair()
 {
-    return new PendingCall(d->m_bluezDevice->Pair(), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezDevice()->Pair(), PendingCall::ReturnVoid, this);
 }
 
 PendingCall *Device::cancelPairing()
 {
-    return new PendingCall(d->m_bluezDevice->CancelPairing(), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezDevice()->CancelPairing(), PendingCall::ReturnVoid, this);
 }
 
 } // namespace BluezQt
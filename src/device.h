@@ -10,12 +10,16 @@
 #define BLUEZQT_DEVICE_H
 
 #include <QObject>
+#include <QVector>
 
 #include "bluezqt_export.h"
+#include "gattdatabase.h"
+#include "gattreadjob.h"
 #include "gattserviceremote.h"
 #include "input.h"
 #include "mediaplayer.h"
 #include "mediatransport.h"
+#include "uuid.h"
 namespace BluezQt
 {
 class Adapter;
@@ -104,6 +108,22 @@ public:
     };
     Q_ENUM(Type)
 
+    /**
+     * Throttling policy of advertisement updates.
+     *
+     * The policy limits how often rssiChanged(), manufacturerDataChanged()
+     * and serviceDataChanged() signals are emitted during discovery.
+     * Default constructed policy doesn't throttle anything.
+     */
+    struct UpdatePolicy {
+        /** Maximum number of advertisement updates emitted per second, 0 means unlimited. */
+        int maxUpdatesPerSecond = 0;
+        /** Minimal change of RSSI (in dBm) that is reported, 0 means any change. */
+        int rssiThreshold = 0;
+        /** Weight (0..1] of new sample in exponential moving average of RSSI, 0 disables smoothing. */
+        qreal rssiSmoothing = 0;
+    };
+
     /**
      * Destroys a Device object.
      */
@@ -261,10 +281,41 @@ public:
      *
      * @note RSSI is only updated during discovery.
      *
+     * @note With update policy set, this is the smoothed RSSI last reported
+     *       with rssiChanged() signal.
+     *
      * @return RSSI of device
+     * @see rawRssi()
      */
     qint16 rssi() const;
 
+    /**
+     * Returns last Received Signal Strength Indicator received from the device.
+     *
+     * Unlike rssi(), this value is not affected by update policy.
+     *
+     * @return raw RSSI of device
+     */
+    qint16 rawRssi() const;
+
+    /**
+     * Returns update policy of the device.
+     *
+     * @return update policy
+     */
+    UpdatePolicy updatePolicy() const;
+
+    /**
+     * Sets update policy of the device.
+     *
+     * Manufacturer and service data are always up to date, the policy only
+     * throttles their change signals.
+     *
+     * @param policy update policy
+     * @see Manager::setDeviceUpdatePolicy()
+     */
+    void setUpdatePolicy(const UpdatePolicy &policy);
+
     /**
      * Returns manufacturer specific advertisement data.
      *
@@ -298,6 +349,16 @@ public:
      */
     QStringList uuids() const;
 
+    /**
+     * Returns UUIDs of supported services by the device.
+     *
+     * This is the same list as uuids(), but UUIDs are returned
+     * as values that are compared as integers.
+     *
+     * @return UUIDs of supported services
+     */
+    QVector<Uuid> uuidValues() const;
+
     /**
      * Returns remote device ID in modalias format.
      *
@@ -363,6 +424,74 @@ public:
      * @return list of services
      */
     QList<GattServiceRemotePtr> gattServices() const;
+
+    /**
+     * Returns a snapshot of the device's GATT database.
+     *
+     * The snapshot is collected in one pass over all known services,
+     * characteristics and descriptors. It is complete once
+     * gattDatabaseResolved() was emitted.
+     *
+     * @return GATT database snapshot
+     * @see GattDatabase::saveCache()
+     */
+    GattDatabase gattDatabase() const;
+
+    /**
+     * Returns a service with given UUID.
+     *
+     * Lookup is done in per-device index, without scanning all services.
+     * If there are more services with the same UUID, the one with the
+     * lowest handle is returned.
+     *
+     * @param uuid service UUID
+     * @return null if there is no such service
+     */
+    GattServiceRemotePtr findService(const Uuid &uuid) const;
+
+    /**
+     * Returns a characteristic with given UUID in service with given UUID.
+     *
+     * Lookup is done in per-device and per-service indexes, without
+     * scanning all services and characteristics. If there are more such
+     * characteristics, the one with the lowest handle is returned.
+     *
+     * @param serviceUuid service UUID
+     * @param characteristicUuid characteristic UUID
+     * @return null if there is no such characteristic
+     */
+    GattCharacteristicRemotePtr findCharacteristic(const Uuid &serviceUuid, const Uuid &characteristicUuid) const;
+
+    /**
+     * Returns a characteristic with given handle.
+     *
+     * @param handle characteristic handle
+     * @return null if there is no characteristic with such handle
+     */
+    GattCharacteristicRemotePtr findByHandle(quint16 handle) const;
+
+    /**
+     * Reads values of several characteristics.
+     *
+     * Reads are dispatched concurrently, limited by GattReadJob::maxInFlight(),
+     * and their results are collected into one map of UUIDs to values
+     * or errors. The returned job must be started with Job::start().
+     *
+     * @param characteristics characteristics to read
+     * @param options read options passed to each ReadValue call
+     * @return read job
+     */
+    GattReadJob *readCharacteristics(const QList<GattCharacteristicRemotePtr> &characteristics, const QVariantMap &options = QVariantMap());
+
+    /**
+     * Returns a cached GATT database of the device.
+     *
+     * This is the database last saved with GattDatabase::saveCache(),
+     * it is not updated by the library.
+     *
+     * @return cached database, invalid if there is no cache
+     */
+    GattDatabase cachedGattDatabase() const;
     /**
      * Returns a string for device type.
      *
@@ -479,6 +608,14 @@ Q_SIGNALS:
      */
     void gattServiceChanged(GattServiceRemotePtr service);
 
+    /**
+     * Indicates that all device's GATT services have been resolved.
+     *
+     * Emitted once per resolve, after all services, characteristics
+     * and descriptors are known.
+     */
+    void gattDatabaseResolved(const GattDatabase &database);
+
     /**
      * Indicates that device's name have changed.
      */
@@ -601,6 +738,9 @@ private:
     class DevicePrivate *const d;
 
     friend class DevicePrivate;
+    friend class DevicesModelPrivate;
+    friend class GattServiceRemote;
+    friend class GattServiceRemotePrivate;
     friend class ManagerPrivate;
     friend class Adapter;
 };
@@ -8,6 +8,9 @@
 
 #include "device_p.h"
 #include "device.h"
+#include "gattcharacteristicremote.h"
+#include "gattdatabase_p.h"
+#include "gattdescriptorremote.h"
 #include "gattserviceremote_p.h"
 #include "gattserviceremote.h"
 #include "adapter.h"
@@ -23,12 +26,31 @@
 #include "mediatransport_p.h"
 #include "utils.h"
 
+#include <algorithm>
+
+// PROPERTY_CHANGED and PROPERTY_INVALIDATED also recording the property for DevicesModel
+#define DEVICE_PROPERTY_CHANGED(var, type_cast, signal, property) \
+    if (var != value.type_cast()) { \
+        var = value.type_cast(); \
+        m_changedProperties |= property; \
+        Q_EMIT q.lock()->signal(var); \
+    }
+
+#define DEVICE_PROPERTY_INVALIDATED(var, empty, signal, property) \
+    if (var != empty) { \
+        var = empty; \
+        m_changedProperties |= property; \
+        Q_EMIT q.lock()->signal(var); \
+    }
+
 namespace BluezQt
 {
 static const qint16 INVALID_RSSI = -32768; // qint16 minimum
 
 DevicePrivate::DevicePrivate(const QString &path, const QVariantMap &properties, const AdapterPtr &adapter)
     : QObject()
+    , m_path(path)
+    , m_bluezDevice(nullptr)
     , m_dbusProperties(nullptr)
     , m_deviceClass(0)
     , m_appearance(0)
@@ -41,36 +63,19 @@ DevicePrivate::DevicePrivate(const QString &path, const QVariantMap &properties,
     , m_servicesResolved(false)
     , m_connected(false)
     , m_adapter(adapter)
+    , m_gattIndexDirty(false)
+    , m_rawRssi(INVALID_RSSI)
+    , m_pendingRssi(INVALID_RSSI)
+    , m_smoothedRssi(INVALID_RSSI)
+    , m_pendingUpdates(0)
+    , m_updateTimer(nullptr)
+    , m_changedProperties(0)
 {
-    m_bluezDevice = new BluezDevice(Strings::orgBluez(), path, DBusConnection::orgBluez(), this);
-
     init(properties);
 }
 
-static QHash<QString, QByteArray> toByteArrayHash(const QDBusArgument &arg)
-{
-    if (arg.currentType() != QDBusArgument::MapType) {
-        return {};
-    }
-
-    QHash<QString, QByteArray> result;
-    arg.beginMap();
-    while (!arg.atEnd()) {
-        arg.beginMapEntry();
-        QString key;
-        QDBusVariant value;
-        arg >> key >> value;
-        result.insert(key.toUpper(), value.variant().toByteArray());
-        arg.endMapEntry();
-    }
-    arg.endMap();
-    return result;
-}
-
 void DevicePrivate::init(const QVariantMap &properties)
 {
-    m_dbusProperties = new DBusProperties(Strings::orgBluez(), m_bluezDevice->path(), DBusConnection::orgBluez(), this);
-
     // Init properties
     m_address = properties.value(QStringLiteral("Address")).toString();
     m_name = properties.value(QStringLiteral("Name")).toString();
@@ -86,17 +91,22 @@ void DevicePrivate::init(const QVariantMap &properties)
     m_manufacturerData = variantToManData(properties.value(QStringLiteral("ManufacturerData")));
     m_servicesResolved = properties.value(QStringLiteral("ServicesResolved")).toBool();
     m_connected = properties.value(QStringLiteral("Connected")).toBool();
-    m_uuids = stringListToUpper(properties.value(QStringLiteral("UUIDs")).toStringList());
+    m_uuids = uuidListToUpper(properties.value(QStringLiteral("UUIDs")).toStringList(), &m_uuidValues);
     m_modalias = properties.value(QStringLiteral("Modalias")).toString();
-    m_serviceData = toByteArrayHash(properties.value(QStringLiteral("ServiceData")).value<QDBusArgument>());
+    m_serviceData = variantToServiceData(properties.value(QStringLiteral("ServiceData")));
 
     if (!m_rssi) {
         m_rssi = INVALID_RSSI;
     }
+    m_rawRssi = m_rssi;
+    m_pendingRssi = m_rssi;
+    m_smoothedRssi = m_rssi;
 }
 
 void DevicePrivate::interfacesAdded(const QString &path, const QVariantMapMap &interfaces)
 {
+    // DevicesModel shows none of the child objects
+    m_changedProperties = OtherProperty;
     bool changed = false;
     QVariantMapMap::const_iterator it;
 
@@ -127,11 +137,9 @@ void DevicePrivate::interfacesAdded(const QString &path, const QVariantMapMap &i
         }
     }
 
-    for (auto& service : m_services) {
-        if (path.startsWith(service->ubi())) {
-            service->d->interfacesAdded(path, interfaces);
-            changed = true;
-        }
+    if (GattServiceRemotePtr service = m_servicesByPath.value(childObjectPath(m_path, path))) {
+        service->d->interfacesAdded(path, interfaces);
+        changed = true;
     }
 
     if (changed) {
@@ -141,6 +149,7 @@ void DevicePrivate::interfacesAdded(const QString &path, const QVariantMapMap &i
 
 void DevicePrivate::interfacesRemoved(const QString &path, const QStringList &interfaces)
 {
+    m_changedProperties = OtherProperty;
     bool changed = false;
 
     for (const QString &interface : interfaces) {
@@ -166,11 +175,9 @@ void DevicePrivate::interfacesRemoved(const QString &path, const QStringList &in
         }
     }
 
-    for (auto& service : m_services) {
-        if (path.startsWith(service->ubi())) {
-            service->d->interfacesRemoved(path,interfaces);
-            changed = true;
-        }
+    if (GattServiceRemotePtr service = m_servicesByPath.value(childObjectPath(m_path, path))) {
+        service->d->interfacesRemoved(path, interfaces);
+        changed = true;
     }
 
     if (changed) {
@@ -181,7 +188,7 @@ void DevicePrivate::interfacesRemoved(const QString &path, const QStringList &in
 void DevicePrivate::addGattService(const QString &gattServicePath, const QVariantMap &properties)
 {
     // Check if we have the right path
-    if (m_bluezDevice->path() != properties.value(QStringLiteral("Device")).value<QDBusObjectPath>().path()) {
+    if (m_path != properties.value(QStringLiteral("Device")).value<QDBusObjectPath>().path()) {
         return;
     }
 
@@ -194,12 +201,74 @@ void DevicePrivate::addGattService(const QString &gattServicePath, const QVarian
     GattServiceRemotePtr gattService = GattServiceRemotePtr(new GattServiceRemote(gattServicePath, properties, device));
     gattService->d->q = gattService.toWeakRef();
     m_services.append(gattService);
+    m_servicesByPath.insert(gattServicePath, gattService);
+    m_servicesByUuid.insert(gattService->uuidValue(), gattService);
 
     Q_EMIT device->gattServiceAdded(gattService);
     Q_EMIT device->gattServicesChanged(m_services);
 
     // Connections
     connect(gattService.data(),&GattServiceRemote::serviceChanged,q.lock().data(),&Device::gattServiceChanged);
+    connect(gattService.data(), &GattServiceRemote::uuidChanged, this, &DevicePrivate::invalidateGattIndex);
+}
+
+GattDatabase DevicePrivate::gattDatabase() const
+{
+    // Database Hash characteristic of Generic Attribute service
+    static const Uuid databaseHashUuid(quint32(0x2B2A));
+
+    GattDatabase database;
+    database.d->m_valid = true;
+    database.d->m_address = m_address;
+
+    QVector<GattDatabase::Attribute> &attributes = database.d->m_attributes;
+    QByteArray remoteHash;
+
+    for (const GattServiceRemotePtr &service : m_services) {
+        GattDatabase::Attribute serviceAttribute;
+        serviceAttribute.type = GattDatabase::Attribute::Service;
+        serviceAttribute.handle = service->handle();
+        serviceAttribute.uuid = service->uuidValue();
+        serviceAttribute.path = service->ubi();
+        if (service->isPrimary()) {
+            serviceAttribute.flags.append(QStringLiteral("primary"));
+        }
+        attributes.append(serviceAttribute);
+
+        const QList<GattCharacteristicRemotePtr> characteristics = service->characteristics();
+        for (const GattCharacteristicRemotePtr &characteristic : characteristics) {
+            GattDatabase::Attribute characteristicAttribute;
+            characteristicAttribute.type = GattDatabase::Attribute::Characteristic;
+            characteristicAttribute.handle = characteristic->handle();
+            characteristicAttribute.uuid = characteristic->uuidValue();
+            characteristicAttribute.path = characteristic->ubi();
+            characteristicAttribute.flags = characteristic->flags();
+            attributes.append(characteristicAttribute);
+
+            if (characteristicAttribute.uuid == databaseHashUuid) {
+                remoteHash = characteristic->value();
+            }
+
+            const QList<GattDescriptorRemotePtr> descriptors = characteristic->descriptors();
+            for (const GattDescriptorRemotePtr &descriptor : descriptors) {
+                GattDatabase::Attribute descriptorAttribute;
+                descriptorAttribute.type = GattDatabase::Attribute::Descriptor;
+                descriptorAttribute.handle = descriptor->handle();
+                descriptorAttribute.uuid = descriptor->uuidValue();
+                descriptorAttribute.path = descriptor->ubi();
+                descriptorAttribute.flags = descriptor->flags();
+                attributes.append(descriptorAttribute);
+            }
+        }
+    }
+
+    // Services are known in the order they were announced, the layout is the same in handle order
+    std::stable_sort(attributes.begin(), attributes.end(), [](const GattDatabase::Attribute &a, const GattDatabase::Attribute &b) {
+        return a.handle < b.handle;
+    });
+
+    database.d->m_hash = remoteHash.isEmpty() ? GattDatabasePrivate::layoutHash(attributes) : remoteHash;
+    return database;
 }
 
 void DevicePrivate::removeGattService(const QString &gattServicePath)
@@ -210,29 +279,105 @@ void DevicePrivate::removeGattService(const QString &gattServicePath)
         return;
     }
 
-    GattServiceRemotePtr gattService = nullptr;
-    for (int i=0; i < device->gattServices().size(); ++i) {
-        if (device->gattServices().at(i)->ubi() == gattServicePath) {
-            gattService = device->gattServices().at(i);
-        }
-    }
-
-    if (gattService == nullptr) {
+    GattServiceRemotePtr gattService = m_servicesByPath.take(gattServicePath);
+    if (!gattService) {
         return;
     }
 
     m_services.removeOne(gattService);
+    m_servicesByUuid.remove(gattService->uuidValue(), gattService);
+    for (const GattCharacteristicRemotePtr &characteristic : std::as_const(gattService->d->m_characteristics)) {
+        unindexGattCharacteristic(characteristic);
+    }
 
     Q_EMIT device->gattServiceRemoved(gattService);
     Q_EMIT device->gattServicesChanged(m_services);
 
     // Connections
     disconnect(gattService.data(),&GattServiceRemote::serviceChanged,q.lock().data(),&Device::gattServiceChanged);
+    disconnect(gattService.data(), &GattServiceRemote::uuidChanged, this, &DevicePrivate::invalidateGattIndex);
+}
+
+void DevicePrivate::indexGattCharacteristic(const GattCharacteristicRemotePtr &characteristic)
+{
+    m_characteristicsByHandle.insert(characteristic->handle(), characteristic);
+
+    connect(characteristic.data(), &GattCharacteristicRemote::uuidChanged, this, &DevicePrivate::invalidateGattIndex);
+    connect(characteristic.data(), &GattCharacteristicRemote::handleChanged, this, &DevicePrivate::invalidateGattIndex);
+}
+
+void DevicePrivate::unindexGattCharacteristic(const GattCharacteristicRemotePtr &characteristic)
+{
+    auto it = m_characteristicsByHandle.find(characteristic->handle());
+    if (it != m_characteristicsByHandle.end() && it.value() == characteristic) {
+        m_characteristicsByHandle.erase(it);
+    }
+
+    disconnect(characteristic.data(), nullptr, this, nullptr);
+}
+
+void DevicePrivate::invalidateGattIndex()
+{
+    m_gattIndexDirty = true;
+}
+
+// Indexes are kept in sync on add/remove, only UUID or handle changes
+// of already known objects require a rebuild
+void DevicePrivate::ensureGattIndex()
+{
+    if (!m_gattIndexDirty) {
+        return;
+    }
+
+    m_servicesByUuid.clear();
+    m_characteristicsByHandle.clear();
+
+    for (const GattServiceRemotePtr &service : std::as_const(m_services)) {
+        m_servicesByUuid.insert(service->uuidValue(), service);
+        service->d->rebuildCharacteristicsIndex();
+
+        for (const GattCharacteristicRemotePtr &characteristic : std::as_const(service->d->m_characteristics)) {
+            m_characteristicsByHandle.insert(characteristic->handle(), characteristic);
+        }
+    }
+
+    m_gattIndexDirty = false;
+}
+
+// D-Bus interfaces are only needed for method calls, create them on first use
+BluezDevice *DevicePrivate::bluezDevice()
+{
+    if (!m_bluezDevice) {
+        m_bluezDevice = new BluezDevice(Strings::orgBluez(), m_path, DBusConnection::orgBluez(), this);
+    }
+    return m_bluezDevice;
+}
+
+DBusProperties *DevicePrivate::dbusProperties()
+{
+    if (!m_dbusProperties) {
+        m_dbusProperties = new DBusProperties(Strings::orgBluez(), m_path, DBusConnection::orgBluez(), this);
+    }
+    return m_dbusProperties;
 }
 
 QDBusPendingReply<> DevicePrivate::setDBusProperty(const QString &name, const QVariant &value)
 {
-    return m_dbusProperties->Set(Strings::orgBluezDevice1(), name, QDBusVariant(value));
+    return dbusProperties()->Set(Strings::orgBluezDevice1(), name, QDBusVariant(value));
+}
+
+void DevicePrivate::uuidsPropertyChanged(const QStringList &value)
+{
+    QVector<Uuid> uuids;
+    const QStringList strings = uuidListToUpper(value, &uuids);
+
+    // Strings only need comparing when some of them are not valid UUIDs
+    if (m_uuidValues != uuids || (uuids.contains(Uuid()) && m_uuids != strings)) {
+        m_uuidValues = uuids;
+        m_uuids = strings;
+        m_changedProperties |= UuidsProperty;
+        Q_EMIT q.lock()->uuidsChanged(m_uuids);
+    }
 }
 
 void DevicePrivate::propertiesChanged(const QString &path, const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
@@ -244,21 +389,37 @@ void DevicePrivate::propertiesChanged(const QString &path, const QString &interf
     } else if (interface == Strings::orgBluezMediaPlayer1() && m_mediaPlayer) {
         m_mediaPlayer->d->propertiesChanged(interface, changed, invalidated);
     } else if ((interface == Strings::orgBluezGattService1()) || (interface == Strings::orgBluezGattCharacteristic1()) || (interface == Strings::orgBluezGattDescriptor1())) {
-        for (GattServiceRemotePtr service : m_services) {
-            if (path.startsWith(service->ubi())) {
-                service->d->propertiesChanged(path, interface, changed, invalidated);
-                return;
-            }
+        if (GattServiceRemotePtr service = m_servicesByPath.value(childObjectPath(m_path, path))) {
+            service->d->propertiesChanged(path, interface, changed, invalidated);
         }
+        return;
     } else if (interface != Strings::orgBluezDevice1()) {
         return;
     }
 
+    m_changedProperties = 0;
+
+    // Don't emit deviceChanged when all changes were deferred by update policy
+    bool deferred = !changed.isEmpty() && invalidated.isEmpty();
+
     QVariantMap::const_iterator i;
     for (i = changed.constBegin(); i != changed.constEnd(); ++i) {
         const QVariant &value = i.value();
         const QString &property = i.key();
 
+        if (property == QLatin1String("RSSI")) {
+            deferred &= rssiPropertyChanged(value.toInt());
+            continue;
+        } else if (property == QLatin1String("ManufacturerData")) {
+            deferred &= manufacturerDataPropertyChanged(variantToManData(value));
+            continue;
+        } else if (property == QLatin1String("ServiceData")) {
+            deferred &= serviceDataPropertyChanged(variantToServiceData(value));
+            continue;
+        }
+
+        deferred = false;
+
         if (property == QLatin1String("Name")) {
             namePropertyChanged(value.toString());
         } else if (property == QLatin1String("Address")) {
@@ -268,31 +429,31 @@ void DevicePrivate::propertiesChanged(const QString &path, const QString &interf
         } else if (property == QLatin1String("Class")) {
             classPropertyChanged(value.toUInt());
         } else if (property == QLatin1String("Appearance")) {
-            PROPERTY_CHANGED(m_appearance, toUInt, appearanceChanged);
+            DEVICE_PROPERTY_CHANGED(m_appearance, toUInt, appearanceChanged, AppearanceProperty);
         } else if (property == QLatin1String("Icon")) {
-            PROPERTY_CHANGED(m_icon, toString, iconChanged);
+            DEVICE_PROPERTY_CHANGED(m_icon, toString, iconChanged, IconProperty);
         } else if (property == QLatin1String("Paired")) {
-            PROPERTY_CHANGED(m_paired, toBool, pairedChanged);
+            DEVICE_PROPERTY_CHANGED(m_paired, toBool, pairedChanged, PairedProperty);
         } else if (property == QLatin1String("Trusted")) {
-            PROPERTY_CHANGED(m_trusted, toBool, trustedChanged);
+            DEVICE_PROPERTY_CHANGED(m_trusted, toBool, trustedChanged, TrustedProperty);
         } else if (property == QLatin1String("Blocked")) {
-            PROPERTY_CHANGED(m_blocked, toBool, blockedChanged);
+            DEVICE_PROPERTY_CHANGED(m_blocked, toBool, blockedChanged, BlockedProperty);
         } else if (property == QLatin1String("LegacyPairing")) {
-            PROPERTY_CHANGED(m_legacyPairing, toBool, legacyPairingChanged);
-        } else if (property == QLatin1String("RSSI")) {
-            PROPERTY_CHANGED(m_rssi, toInt, rssiChanged);
-        } else if (property == QLatin1String("ManufacturerData")) {
-            PROPERTY_CHANGED2(m_manufacturerData, variantToManData(value), manufacturerDataChanged);
+            DEVICE_PROPERTY_CHANGED(m_legacyPairing, toBool, legacyPairingChanged, LegacyPairingProperty);
         } else if (property == QLatin1String("ServicesResolved")) {
-            PROPERTY_CHANGED(m_servicesResolved, toBool, servicesResolvedChanged);
+            const bool wasResolved = m_servicesResolved;
+            DEVICE_PROPERTY_CHANGED(m_servicesResolved, toBool, servicesResolvedChanged, OtherProperty);
+            if (!wasResolved && m_servicesResolved) {
+                Q_EMIT q.lock()->gattDatabaseResolved(gattDatabase());
+            }
         } else if (property == QLatin1String("Connected")) {
-            PROPERTY_CHANGED(m_connected, toBool, connectedChanged);
+            DEVICE_PROPERTY_CHANGED(m_connected, toBool, connectedChanged, ConnectedProperty);
         } else if (property == QLatin1String("Modalias")) {
-            PROPERTY_CHANGED(m_modalias, toString, modaliasChanged);
+            DEVICE_PROPERTY_CHANGED(m_modalias, toString, modaliasChanged, ModaliasProperty);
         } else if (property == QLatin1String("UUIDs")) {
-            PROPERTY_CHANGED2(m_uuids, stringListToUpper(value.toStringList()), uuidsChanged);
-        } else if (property == QLatin1String("ServiceData")) {
-            PROPERTY_CHANGED2(m_serviceData, toByteArrayHash(value.value<QDBusArgument>()), serviceDataChanged);
+            uuidsPropertyChanged(value.toStringList());
+        } else {
+            m_changedProperties |= OtherProperty;
         }
     }
 
@@ -302,32 +463,159 @@ void DevicePrivate::propertiesChanged(const QString &path, const QString &interf
         } else if (property == QLatin1String("Class")) {
             classPropertyChanged(0);
         } else if (property == QLatin1String("Appearance")) {
-            PROPERTY_INVALIDATED(m_appearance, 0, appearanceChanged);
+            DEVICE_PROPERTY_INVALIDATED(m_appearance, 0, appearanceChanged, AppearanceProperty);
         } else if (property == QLatin1String("Icon")) {
-            PROPERTY_INVALIDATED(m_icon, QString(), iconChanged);
+            DEVICE_PROPERTY_INVALIDATED(m_icon, QString(), iconChanged, IconProperty);
         } else if (property == QLatin1String("RSSI")) {
-            PROPERTY_INVALIDATED(m_rssi, INVALID_RSSI, rssiChanged);
+            m_rawRssi = INVALID_RSSI;
+            m_pendingRssi = INVALID_RSSI;
+            m_smoothedRssi = INVALID_RSSI;
+            m_pendingUpdates &= ~RssiUpdate;
+            DEVICE_PROPERTY_INVALIDATED(m_rssi, INVALID_RSSI, rssiChanged, RssiProperty);
         } else if (property == QLatin1String("ManufacturerData")) {
             QMap<uint16_t,QByteArray> map;
-            PROPERTY_INVALIDATED(m_manufacturerData, map, manufacturerDataChanged);
+            DEVICE_PROPERTY_INVALIDATED(m_manufacturerData, map, manufacturerDataChanged, OtherProperty);
         } else if (property == QLatin1String("ServicesResolved")) {
-            PROPERTY_INVALIDATED(m_servicesResolved, false, servicesResolvedChanged);
+            DEVICE_PROPERTY_INVALIDATED(m_servicesResolved, false, servicesResolvedChanged, OtherProperty);
         } else if (property == QLatin1String("Modalias")) {
-            PROPERTY_INVALIDATED(m_modalias, QString(), modaliasChanged);
+            DEVICE_PROPERTY_INVALIDATED(m_modalias, QString(), modaliasChanged, ModaliasProperty);
         } else if (property == QLatin1String("UUIDs")) {
-            PROPERTY_INVALIDATED(m_uuids, QStringList(), uuidsChanged);
+            uuidsPropertyChanged(QStringList());
         } else if (property == QLatin1String("ServiceData")) {
-            PROPERTY_INVALIDATED(m_serviceData, (QHash<QString, QByteArray>()), serviceDataChanged);
+            DEVICE_PROPERTY_INVALIDATED(m_serviceData, (QHash<QString, QByteArray>()), serviceDataChanged, OtherProperty);
         }
     }
 
-    Q_EMIT q.lock()->deviceChanged(q.toStrongRef());
+    if (!deferred) {
+        Q_EMIT q.lock()->deviceChanged(q.toStrongRef());
+    }
+}
+
+// Returns true when the change was not reported yet
+bool DevicePrivate::rssiPropertyChanged(qint16 value)
+{
+    m_rawRssi = value;
+
+    qint16 rssi = value;
+    if (m_updatePolicy.rssiSmoothing > 0 && m_smoothedRssi != INVALID_RSSI && value != INVALID_RSSI) {
+        m_smoothedRssi = m_updatePolicy.rssiSmoothing * value + (1 - m_updatePolicy.rssiSmoothing) * m_smoothedRssi;
+        rssi = static_cast<qint16>(qRound(m_smoothedRssi));
+    } else {
+        m_smoothedRssi = value;
+    }
+
+    if (m_pendingRssi == rssi) {
+        return m_pendingUpdates & RssiUpdate;
+    }
+
+    if (m_updatePolicy.rssiThreshold > 0 && m_rssi != INVALID_RSSI && qAbs(rssi - m_rssi) < m_updatePolicy.rssiThreshold) {
+        // Newer sample supersedes the deferred one
+        m_pendingRssi = m_rssi;
+        m_pendingUpdates &= ~RssiUpdate;
+        return true;
+    }
+
+    m_pendingRssi = rssi;
+    return scheduleAdvertisementUpdate(RssiUpdate);
+}
+
+bool DevicePrivate::manufacturerDataPropertyChanged(const ManData &value)
+{
+    if (m_manufacturerData == value) {
+        return false;
+    }
+
+    m_manufacturerData = value;
+    return scheduleAdvertisementUpdate(ManufacturerDataUpdate);
+}
+
+bool DevicePrivate::serviceDataPropertyChanged(const QHash<QString, QByteArray> &value)
+{
+    if (m_serviceData == value) {
+        return false;
+    }
+
+    m_serviceData = value;
+    return scheduleAdvertisementUpdate(ServiceDataUpdate);
+}
+
+bool DevicePrivate::scheduleAdvertisementUpdate(int update)
+{
+    m_pendingUpdates |= update;
+
+    const int maxUpdates = m_updatePolicy.maxUpdatesPerSecond;
+    const qint64 interval = maxUpdates > 0 ? 1000 / maxUpdates : 0;
+
+    if (!m_lastUpdate.isValid() || m_lastUpdate.elapsed() >= interval) {
+        flushAdvertisementUpdates(false);
+        return false;
+    }
+
+    if (!m_updateTimer) {
+        m_updateTimer = new QTimer(this);
+        m_updateTimer->setSingleShot(true);
+        connect(m_updateTimer, &QTimer::timeout, this, [this]() {
+            flushAdvertisementUpdates(true);
+        });
+    }
+
+    if (!m_updateTimer->isActive()) {
+        m_updateTimer->start(interval - m_lastUpdate.elapsed());
+    }
+    return true;
+}
+
+void DevicePrivate::flushAdvertisementUpdates(bool emitDeviceChanged)
+{
+    const int updates = m_pendingUpdates;
+    m_pendingUpdates = 0;
+
+    if (!updates) {
+        return;
+    }
+
+    m_lastUpdate.start();
+
+    if (emitDeviceChanged) {
+        m_changedProperties = 0;
+    }
+
+    if (updates & RssiUpdate && m_rssi != m_pendingRssi) {
+        m_rssi = m_pendingRssi;
+        m_changedProperties |= RssiProperty;
+        Q_EMIT q.lock()->rssiChanged(m_rssi);
+    }
+    if (updates & ManufacturerDataUpdate) {
+        m_changedProperties |= OtherProperty;
+        Q_EMIT q.lock()->manufacturerDataChanged(m_manufacturerData);
+    }
+    if (updates & ServiceDataUpdate) {
+        m_changedProperties |= OtherProperty;
+        Q_EMIT q.lock()->serviceDataChanged(m_serviceData);
+    }
+
+    if (emitDeviceChanged) {
+        Q_EMIT q.lock()->deviceChanged(q.toStrongRef());
+    }
+}
+
+void DevicePrivate::setUpdatePolicy(const Device::UpdatePolicy &policy)
+{
+    m_updatePolicy = policy;
+    m_smoothedRssi = m_rawRssi;
+
+    // Deliver updates held back by previous policy
+    if (m_updateTimer && m_updateTimer->isActive()) {
+        m_updateTimer->stop();
+        flushAdvertisementUpdates(true);
+    }
 }
 
 void DevicePrivate::namePropertyChanged(const QString &value)
 {
     if (m_name != value) {
         m_name = value;
+        m_changedProperties |= RemoteNameProperty;
         Q_EMIT q.lock()->remoteNameChanged(m_name);
         Q_EMIT q.lock()->friendlyNameChanged(q.lock()->friendlyName());
     }
@@ -337,6 +625,7 @@ void DevicePrivate::addressPropertyChanged(const QString &value)
 {
     if (m_address != value) {
         m_address = value;
+        m_changedProperties |= AddressProperty;
         Q_EMIT q.lock()->addressChanged(m_address);
     }
 }
@@ -345,6 +634,7 @@ void DevicePrivate::aliasPropertyChanged(const QString &value)
 {
     if (m_alias != value) {
         m_alias = value;
+        m_changedProperties |= NameProperty;
         Q_EMIT q.lock()->nameChanged(m_alias);
         Q_EMIT q.lock()->friendlyNameChanged(q.lock()->friendlyName());
     }
@@ -354,6 +644,7 @@ void DevicePrivate::classPropertyChanged(quint32 value)
 {
     if (m_deviceClass != value) {
         m_deviceClass = value;
+        m_changedProperties |= ClassProperty;
         Q_EMIT q.lock()->deviceClassChanged(m_deviceClass);
         Q_EMIT q.lock()->typeChanged(q.lock()->type());
     }
@@ -367,4 +658,15 @@ void DevicePrivate::serviceDataChanged(const QHash<QString, QByteArray> &value)
     }
 }
 
+DevicePrivate *DevicePrivate::get(Device *device)
+{
+    return device->d;
+}
+
+// For autotests, delivers changed Device1 properties without D-Bus signal
+BLUEZQT_EXPORT void bluezqt_devicePropertiesChanged(Device *device, const QVariantMap &changed)
+{
+    DevicePrivate::get(device)->propertiesChanged(device->ubi(), Strings::orgBluezDevice1(), changed, QStringList());
+}
+
 } // namespace BluezQt
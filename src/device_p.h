@@ -9,13 +9,19 @@
 #ifndef BLUEZQT_DEVICE_P_H
 #define BLUEZQT_DEVICE_P_H
 
+#include <QElapsedTimer>
+#include <QHash>
 #include <QObject>
 #include <QStringList>
+#include <QVector>
+#include <QTimer>
 
 #include "bluezdevice1.h"
 #include "bluezqt_dbustypes.h"
 #include "dbusproperties.h"
+#include "device.h"
 #include "types.h"
+#include "uuid.h"
 
 namespace BluezQt
 {
@@ -31,13 +37,25 @@ public:
 
     void init(const QVariantMap &properties);
 
+    static DevicePrivate *get(Device *device);
+
     void interfacesAdded(const QString &path, const QVariantMapMap &interfaces);
     void interfacesRemoved(const QString &path, const QStringList &interfaces);
 
     void addGattService(const QString &gattServicePath, const QVariantMap &properties);
     void removeGattService(const QString &gattServicePath);
+    GattDatabase gattDatabase() const;
+
+    void indexGattCharacteristic(const GattCharacteristicRemotePtr &characteristic);
+    void unindexGattCharacteristic(const GattCharacteristicRemotePtr &characteristic);
+    void invalidateGattIndex();
+    void ensureGattIndex();
+
+    BluezDevice *bluezDevice();
+    DBusProperties *dbusProperties();
 
     QDBusPendingReply<> setDBusProperty(const QString &name, const QVariant &value);
+    void uuidsPropertyChanged(const QStringList &value);
     void propertiesChanged(const QString &path, const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
     void namePropertyChanged(const QString &value);
     void aliasPropertyChanged(const QString &value);
@@ -45,7 +63,41 @@ public:
     void classPropertyChanged(quint32 value);
     void serviceDataChanged(const QHash<QString, QByteArray> &value);
 
+    bool rssiPropertyChanged(qint16 value);
+    bool manufacturerDataPropertyChanged(const ManData &value);
+    bool serviceDataPropertyChanged(const QHash<QString, QByteArray> &value);
+    bool scheduleAdvertisementUpdate(int update);
+    void flushAdvertisementUpdates(bool emitDeviceChanged);
+    void setUpdatePolicy(const Device::UpdatePolicy &policy);
+
+    // Properties changed by the last deviceChanged() emission, used by DevicesModel
+    enum ChangedProperty {
+        AddressProperty = 1 << 0,
+        NameProperty = 1 << 1,
+        RemoteNameProperty = 1 << 2,
+        ClassProperty = 1 << 3,
+        AppearanceProperty = 1 << 4,
+        IconProperty = 1 << 5,
+        PairedProperty = 1 << 6,
+        TrustedProperty = 1 << 7,
+        BlockedProperty = 1 << 8,
+        LegacyPairingProperty = 1 << 9,
+        RssiProperty = 1 << 10,
+        ConnectedProperty = 1 << 11,
+        UuidsProperty = 1 << 12,
+        ModaliasProperty = 1 << 13,
+        OtherProperty = 1 << 14,
+        AllProperties = -1,
+    };
+
+    enum AdvertisementUpdate {
+        RssiUpdate = 1 << 0,
+        ManufacturerDataUpdate = 1 << 1,
+        ServiceDataUpdate = 1 << 2,
+    };
+
     QWeakPointer<Device> q;
+    QString m_path;
     BluezDevice *m_bluezDevice;
     DBusProperties *m_dbusProperties;
 
@@ -64,6 +116,7 @@ public:
     bool m_servicesResolved;
     bool m_connected;
     QStringList m_uuids;
+    QVector<Uuid> m_uuidValues;
     QString m_modalias;
     QHash<QString, QByteArray> m_serviceData;
     BatteryPtr m_battery;
@@ -71,7 +124,20 @@ public:
     MediaPlayerPtr m_mediaPlayer;
     MediaTransportPtr m_mediaTransport;
     QList<GattServiceRemotePtr> m_services;
+    QHash<QString, GattServiceRemotePtr> m_servicesByPath;
+    QMultiHash<Uuid, GattServiceRemotePtr> m_servicesByUuid;
+    QHash<quint16, GattCharacteristicRemotePtr> m_characteristicsByHandle;
+    bool m_gattIndexDirty;
     AdapterPtr m_adapter;
+
+    Device::UpdatePolicy m_updatePolicy;
+    qint16 m_rawRssi;
+    qint16 m_pendingRssi;
+    qreal m_smoothedRssi;
+    int m_pendingUpdates;
+    QElapsedTimer m_lastUpdate;
+    QTimer *m_updateTimer;
+    int m_changedProperties;
 };
 
 } // namespace BluezQt
@@ -9,10 +9,18 @@
 #include "devicesmodel.h"
 #include "adapter.h"
 #include "device.h"
+#include "device_p.h"
 #include "manager.h"
 
+#include <QTimer>
+
+#include <algorithm>
+
 namespace BluezQt
 {
+// Bursts with more added and removed devices reset the whole model
+static const int s_resetThreshold = 500;
+
 class DevicesModelPrivate : public QObject
 {
 public:
@@ -24,10 +32,19 @@ public:
     void deviceRemoved(DevicePtr device);
     void deviceChanged(DevicePtr device);
     void adapterChanged(AdapterPtr adapter);
+    void flushPendingDevices();
+
+    static QVector<int> changedRoles(int changedProperties);
+    int rowOf(const DevicePtr &device) const;
+    void updateRows(int first);
 
     DevicesModel *q;
     Manager *m_manager;
     QList<DevicePtr> m_devices;
+    QHash<Device *, int> m_rows;
+    QList<DevicePtr> m_pendingAdded;
+    QList<DevicePtr> m_pendingRemoved;
+    QTimer *m_flushTimer;
 };
 
 DevicesModelPrivate::DevicesModelPrivate(DevicesModel *qq)
@@ -35,11 +52,17 @@ DevicesModelPrivate::DevicesModelPrivate(DevicesModel *qq)
     , q(qq)
     , m_manager(nullptr)
 {
+    // Devices added and removed in one event loop pass are applied together
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(0);
+    connect(m_flushTimer, &QTimer::timeout, this, &DevicesModelPrivate::flushPendingDevices);
 }
 
 void DevicesModelPrivate::init()
 {
     m_devices = m_manager->devices();
+    updateRows(0);
 
     connect(m_manager, &Manager::deviceAdded, this, &DevicesModelPrivate::deviceAdded);
     connect(m_manager, &Manager::deviceRemoved, this, &DevicesModelPrivate::deviceRemoved);
@@ -49,36 +72,187 @@ void DevicesModelPrivate::init()
 
 void DevicesModelPrivate::deviceAdded(DevicePtr device)
 {
-    q->beginInsertRows(QModelIndex(), m_devices.size(), m_devices.size());
-    m_devices.append(device);
-    q->endInsertRows();
+    m_pendingAdded.append(device);
+    m_flushTimer->start();
 }
 
 void DevicesModelPrivate::deviceRemoved(DevicePtr device)
 {
-    int offset = m_devices.indexOf(device);
-    Q_ASSERT(offset >= 0);
+    if (m_pendingAdded.removeOne(device)) {
+        return;
+    }
 
-    q->beginRemoveRows(QModelIndex(), offset, offset);
-    m_devices.removeAt(offset);
-    q->endRemoveRows();
+    Q_ASSERT(rowOf(device) >= 0);
+    m_pendingRemoved.append(device);
+    m_flushTimer->start();
 }
 
 void DevicesModelPrivate::deviceChanged(DevicePtr device)
 {
-    int offset = m_devices.indexOf(device);
-    Q_ASSERT(offset >= 0);
+    // Device is not yet inserted into the model
+    int offset = rowOf(device);
+    if (offset < 0) {
+        return;
+    }
 
     QModelIndex idx = q->createIndex(offset, 0);
-    Q_EMIT q->dataChanged(idx, idx);
+
+    const int changedProperties = device->d->m_changedProperties;
+    if (changedProperties == DevicePrivate::AllProperties) {
+        Q_EMIT q->dataChanged(idx, idx);
+        return;
+    }
+
+    const QVector<int> roles = changedRoles(changedProperties);
+    if (!roles.isEmpty()) {
+        Q_EMIT q->dataChanged(idx, idx, roles);
+    }
 }
 
 void DevicesModelPrivate::adapterChanged(AdapterPtr adapter)
 {
+    const QVector<int> roles = {
+        DevicesModel::AdapterNameRole,
+        DevicesModel::AdapterAddressRole,
+        DevicesModel::AdapterPoweredRole,
+        DevicesModel::AdapterDiscoverableRole,
+        DevicesModel::AdapterPairableRole,
+        DevicesModel::AdapterDiscoveringRole,
+        DevicesModel::AdapterUuidsRole,
+    };
+
     const auto devices = adapter->devices();
     for (const DevicePtr &device : devices) {
-        deviceChanged(device);
+        int offset = rowOf(device);
+        if (offset < 0) {
+            continue;
+        }
+
+        QModelIndex idx = q->createIndex(offset, 0);
+        Q_EMIT q->dataChanged(idx, idx, roles);
+    }
+}
+
+void DevicesModelPrivate::flushPendingDevices()
+{
+    const int changes = m_pendingAdded.size() + m_pendingRemoved.size();
+    if (!changes) {
+        return;
+    }
+
+    QVector<int> removedRows;
+    removedRows.reserve(m_pendingRemoved.size());
+    for (const DevicePtr &device : std::as_const(m_pendingRemoved)) {
+        removedRows.append(m_rows.take(device.data()));
+    }
+    std::sort(removedRows.begin(), removedRows.end());
+    m_pendingRemoved.clear();
+
+    const QList<DevicePtr> added = m_pendingAdded;
+    m_pendingAdded.clear();
+
+    if (changes > s_resetThreshold) {
+        q->beginResetModel();
+        for (auto it = removedRows.crbegin(); it != removedRows.crend(); ++it) {
+            m_devices.removeAt(*it);
+        }
+        m_devices.append(added);
+        m_rows.clear();
+        updateRows(0);
+        q->endResetModel();
+        return;
+    }
+
+    // Remove contiguous ranges of rows, starting from the end to keep rows of remaining ranges valid
+    int last = removedRows.size() - 1;
+    while (last >= 0) {
+        int first = last;
+        while (first > 0 && removedRows.at(first - 1) == removedRows.at(first) - 1) {
+            --first;
+        }
+
+        q->beginRemoveRows(QModelIndex(), removedRows.at(first), removedRows.at(last));
+        m_devices.erase(m_devices.begin() + removedRows.at(first), m_devices.begin() + removedRows.at(last) + 1);
+        q->endRemoveRows();
+
+        last = first - 1;
+    }
+
+    if (!removedRows.isEmpty()) {
+        updateRows(removedRows.first());
+    }
+
+    if (!added.isEmpty()) {
+        q->beginInsertRows(QModelIndex(), m_devices.size(), m_devices.size() + added.size() - 1);
+        for (const DevicePtr &device : added) {
+            m_rows.insert(device.data(), m_devices.size());
+            m_devices.append(device);
+        }
+        q->endInsertRows();
+    }
+}
+
+int DevicesModelPrivate::rowOf(const DevicePtr &device) const
+{
+    return m_rows.value(device.data(), -1);
+}
+
+// Rows of devices after removed rows are shifted
+void DevicesModelPrivate::updateRows(int first)
+{
+    for (int i = first; i < m_devices.size(); ++i) {
+        m_rows[m_devices.at(i).data()] = i;
+    }
+}
+
+QVector<int> DevicesModelPrivate::changedRoles(int changedProperties)
+{
+    QVector<int> roles;
+
+    if (changedProperties & DevicePrivate::AddressProperty) {
+        roles << DevicesModel::AddressRole;
+    }
+    if (changedProperties & DevicePrivate::NameProperty) {
+        roles << Qt::DisplayRole << DevicesModel::NameRole << DevicesModel::FriendlyNameRole;
     }
+    if (changedProperties & DevicePrivate::RemoteNameProperty) {
+        roles << DevicesModel::RemoteNameRole << DevicesModel::FriendlyNameRole;
+    }
+    if (changedProperties & DevicePrivate::ClassProperty) {
+        roles << DevicesModel::ClassRole << DevicesModel::TypeRole;
+    }
+    if (changedProperties & DevicePrivate::AppearanceProperty) {
+        roles << DevicesModel::AppearanceRole << DevicesModel::TypeRole;
+    }
+    if (changedProperties & DevicePrivate::IconProperty) {
+        roles << DevicesModel::IconRole;
+    }
+    if (changedProperties & DevicePrivate::PairedProperty) {
+        roles << DevicesModel::PairedRole;
+    }
+    if (changedProperties & DevicePrivate::TrustedProperty) {
+        roles << DevicesModel::TrustedRole;
+    }
+    if (changedProperties & DevicePrivate::BlockedProperty) {
+        roles << DevicesModel::BlockedRole;
+    }
+    if (changedProperties & DevicePrivate::LegacyPairingProperty) {
+        roles << DevicesModel::LegacyPairingRole;
+    }
+    if (changedProperties & DevicePrivate::RssiProperty) {
+        roles << DevicesModel::RssiRole;
+    }
+    if (changedProperties & DevicePrivate::ConnectedProperty) {
+        roles << DevicesModel::ConnectedRole;
+    }
+    if (changedProperties & DevicePrivate::UuidsProperty) {
+        roles << DevicesModel::UuidsRole;
+    }
+    if (changedProperties & DevicePrivate::ModaliasProperty) {
+        roles << DevicesModel::ModaliasRole;
+    }
+
+    return roles;
 }
 
 DevicesModel::DevicesModel(Manager *manager, QObject *parent)
@@ -10,10 +10,10 @@
 
 #include "gattapplication_p.h"
 #include "gattcharacteristic.h"
-#include "gattcharacteristicadaptor.h"
+#include "gattdescriptor.h"
 #include "gattservice.h"
-#include "gattserviceadaptor.h"
 
+#include <QDBusAbstractAdaptor>
 #include <QDBusObjectPath>
 #include <QMetaProperty>
 
@@ -37,38 +37,62 @@ GattApplication::~GattApplication()
 
 DBusManagerStruct GattApplicationPrivate::getManagedObjects() const
 {
-    DBusManagerStruct objects;
+    if (!m_managedObjectsValid) {
+        buildManagedObjects();
+    }
 
-    const auto serviceAdaptors = q->findChildren<GattServiceAdaptor *>();
-    const auto charcAdaptors = q->findChildren<GattCharacteristicAdaptor *>();
+    DBusManagerStruct objects;
 
-    for (const GattServiceAdaptor *serviceAdaptor : serviceAdaptors) {
-        QVariantMap properties;
-        for (int i = serviceAdaptor->metaObject()->propertyOffset(); i < serviceAdaptor->metaObject()->propertyCount(); ++i) {
-            auto propertyName = serviceAdaptor->metaObject()->property(i).name();
-            properties.insert(QString::fromLatin1(propertyName), serviceAdaptor->property(propertyName));
+    for (const ManagedObject &object : qAsConst(m_managedObjects)) {
+        // Adaptor is deleted together with its object, the tree has changed
+        if (!object.adaptor) {
+            m_managedObjectsValid = false;
+            return getManagedObjects();
         }
 
-        GattService *service = qobject_cast<GattService *>(serviceAdaptor->parent());
-        if (service) {
-            objects[service->objectPath()].insert(QStringLiteral("org.bluez.GattService1"), properties);
+        QVariantMap properties;
+        for (const QMetaProperty &property : object.properties) {
+            properties.insert(QString::fromLatin1(property.name()), property.read(object.adaptor));
         }
+        objects[object.path].insert(object.interface, properties);
     }
 
-    for (const GattCharacteristicAdaptor *charcAdaptor : charcAdaptors) {
-        QVariantMap properties;
-        for (int i = charcAdaptor->metaObject()->propertyOffset(); i < charcAdaptor->metaObject()->propertyCount(); ++i) {
-            auto propertyName = charcAdaptor->metaObject()->property(i).name();
-            properties.insert(QString::fromLatin1(propertyName), charcAdaptor->property(propertyName));
+    return objects;
+}
+
+void GattApplicationPrivate::buildManagedObjects() const
+{
+    m_managedObjects.clear();
+
+    const auto adaptors = q->findChildren<QDBusAbstractAdaptor *>();
+    for (QDBusAbstractAdaptor *adaptor : adaptors) {
+        ManagedObject object;
+
+        if (GattService *service = qobject_cast<GattService *>(adaptor->parent())) {
+            object.path = service->objectPath();
+        } else if (GattCharacteristic *charc = qobject_cast<GattCharacteristic *>(adaptor->parent())) {
+            object.path = charc->objectPath();
+        } else if (GattDescriptor *descriptor = qobject_cast<GattDescriptor *>(adaptor->parent())) {
+            object.path = descriptor->objectPath();
+        } else {
+            continue;
         }
 
-        GattCharacteristic *charc = qobject_cast<GattCharacteristic *>(charcAdaptor->parent());
-        if (charc) {
-            objects[charc->objectPath()].insert(QStringLiteral("org.bluez.GattCharacteristic1"), properties);
+        const QMetaObject *metaObject = adaptor->metaObject();
+        object.interface = QString::fromLatin1(metaObject->classInfo(metaObject->indexOfClassInfo("D-Bus Interface")).value());
+        object.adaptor = adaptor;
+        for (int i = metaObject->propertyOffset(); i < metaObject->propertyCount(); ++i) {
+            object.properties.append(metaObject->property(i));
         }
+        m_managedObjects.append(object);
     }
 
-    return objects;
+    m_managedObjectsValid = true;
+}
+
+void GattApplicationPrivate::invalidateManagedObjects()
+{
+    m_managedObjectsValid = false;
 }
 
 QDBusObjectPath GattApplication::objectPath() const
@@ -11,6 +11,11 @@
 #include "bluezqt_dbustypes.h"
 
 #include <QDBusObjectPath>
+#include <QMetaProperty>
+#include <QPointer>
+#include <QVector>
+
+class QDBusAbstractAdaptor;
 
 namespace BluezQt
 {
@@ -22,9 +27,21 @@ public:
     GattApplicationPrivate(const QString &objectPathPrefix, GattApplication *q_ptr);
 
     DBusManagerStruct getManagedObjects() const;
+    void buildManagedObjects() const;
+    void invalidateManagedObjects();
 
     GattApplication *q;
     QDBusObjectPath m_objectPath;
+
+    // Object tree is collected once, only property values are read on each call
+    struct ManagedObject {
+        QDBusObjectPath path;
+        QString interface;
+        QPointer<QDBusAbstractAdaptor> adaptor;
+        QVector<QMetaProperty> properties;
+    };
+    mutable QVector<ManagedObject> m_managedObjects;
+    mutable bool m_managedObjectsValid = false;
 };
 
 } // namespace BluezQt
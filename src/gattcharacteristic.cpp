@@ -9,12 +9,15 @@
 #include "gattcharacteristic.h"
 #include "gattcharacteristic_p.h"
 #include "gattservice.h"
+#include "gattsocketdevice_p.h"
+
+#include <QTimer>
 
 namespace BluezQt
 {
 GattCharacteristic::GattCharacteristic(const QString &uuid, GattService *service)
     : QObject(service)
-    , d(new GattCharacterisiticPrivate(uuid, service))
+    , d(new GattCharacterisiticPrivate(uuid, service, this))
 {
 }
 
@@ -58,4 +61,65 @@ void GattCharacteristic::setReadCallback(ReadCallback callback)
     d->m_readCallback = callback;
 }
 
+bool GattCharacteristic::notify(const QByteArray &value)
+{
+    d->m_value = value;
+
+    if (!d->m_notifying || !d->canNotify()) {
+        return false;
+    }
+
+    // Acquired socket has no D-Bus overhead, no need to coalesce
+    if (d->m_notifyDevice) {
+        return d->m_notifyDevice->write(value) == value.size();
+    }
+
+    if (d->m_notifyTimer->isActive()) {
+        d->m_mergedNotificationsCount++;
+        return true;
+    }
+    d->m_notifyTimer->start();
+    return true;
+}
+
+bool GattCharacteristic::isNotifying() const
+{
+    return d->m_notifying;
+}
+
+int GattCharacteristic::notifyLatency() const
+{
+    return d->m_notifyTimer->interval();
+}
+
+void GattCharacteristic::setNotifyLatency(int msec)
+{
+    d->m_notifyTimer->setInterval(qMax(0, msec));
+}
+
+quint64 GattCharacteristic::mergedNotificationsCount() const
+{
+    return d->m_mergedNotificationsCount;
+}
+
+QStringList GattCharacteristic::flags() const
+{
+    return d->m_flags;
+}
+
+void GattCharacteristic::setFlags(const QStringList &flags)
+{
+    d->m_flags = flags;
+}
+
+QIODevice *GattCharacteristic::writeDevice() const
+{
+    return d->m_writeDevice;
+}
+
+QIODevice *GattCharacteristic::notifyDevice() const
+{
+    return d->m_notifyDevice;
+}
+
 } // namespace BluezQt
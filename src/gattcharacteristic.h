@@ -11,6 +11,8 @@
 #include "bluezqt_export.h"
 
 #include <QDBusObjectPath>
+#include <QIODevice>
+#include <QStringList>
 
 namespace BluezQt
 {
@@ -49,6 +51,99 @@ public:
     using ReadCallback = std::function<QByteArray()>;
     void setReadCallback(ReadCallback callback);
 
+    /**
+     * Notifies subscribed clients about new value of the characteristic.
+     *
+     * The value is sent only while a client is subscribed (see isNotifying()),
+     * otherwise it is just stored as the current value. Values notified
+     * within notifyLatency() are coalesced and only the latest one is sent.
+     *
+     * The characteristic must have "notify" or "indicate" flag set, otherwise
+     * clients cannot subscribe and the value is only stored.
+     *
+     * When the notify socket is acquired, the value is queued if the socket
+     * is full. Values larger than MTU minus the 3 byte ATT header are not sent.
+     *
+     * @param value new value
+     * @return true if the notification was sent or queued
+     */
+    bool notify(const QByteArray &value);
+
+    /**
+     * Returns whether a client is subscribed to notifications.
+     *
+     * @return true if notifying
+     */
+    bool isNotifying() const;
+
+    /**
+     * Returns the maximum latency of notifications.
+     *
+     * Default value is 0, which sends the notification in the next event loop pass.
+     *
+     * @return maximum latency in milliseconds
+     */
+    int notifyLatency() const;
+
+    /**
+     * Sets the maximum latency of notifications.
+     *
+     * Higher latency allows more rapid updates to be coalesced into one
+     * notification, at the cost of delayed delivery.
+     *
+     * @param msec maximum latency in milliseconds
+     */
+    void setNotifyLatency(int msec);
+
+    /**
+     * Returns number of notified values that were replaced by a newer value
+     * before they were sent.
+     *
+     * @return number of coalesced values
+     */
+    quint64 mergedNotificationsCount() const;
+
+    /**
+     * Flags defining how the characteristic value can be used.
+     *
+     * Default flags are "read" and "write".
+     *
+     * @return flags of characteristic
+     */
+    QStringList flags() const;
+
+    /**
+     * Sets flags of the characteristic.
+     *
+     * Flags must be set before the application is registered.
+     *
+     * @param flags flags of characteristic
+     */
+    void setFlags(const QStringList &flags);
+
+    /**
+     * Returns the device receiving values written by clients.
+     *
+     * When BlueZ acquires the write socket (AcquireWrite), values written
+     * by clients without response are delivered through this device instead
+     * of valueWritten(). Each read returns one written value.
+     *
+     * @return write device or nullptr if not acquired
+     */
+    QIODevice *writeDevice() const;
+
+    /**
+     * Returns the device sending notifications to clients.
+     *
+     * When BlueZ acquires the notify socket (AcquireNotify), notify() writes
+     * the values directly to this device. Each write sends one notification
+     * and must fit into MTU - 3, writes are queued while the socket is full
+     * (see QIODevice::bytesToWrite()).
+     *
+     * @return notify device or nullptr if not acquired
+     */
+    QIODevice *notifyDevice() const;
+
     /**
      * 128-bit GATT characteristic UUID.
      *
@@ -69,6 +164,27 @@ Q_SIGNALS:
      */
     void valueWritten(const QByteArray &value);
 
+    /**
+     * Indicates that a client subscribed or unsubscribed to notifications.
+     */
+    void notifyingChanged(bool notifying);
+
+    /**
+     * Indicates that BlueZ acquired the write socket.
+     *
+     * A previously acquired device is closed (QIODevice::aboutToClose())
+     * and deleted later.
+     */
+    void writeAcquired(QIODevice *device);
+
+    /**
+     * Indicates that BlueZ acquired the notify socket.
+     *
+     * A previously acquired device is closed (QIODevice::aboutToClose())
+     * and deleted later.
+     */
+    void notifyAcquired(QIODevice *device);
+
 protected:
     /**
      * D-Bus object path of the GattCharacteristic.
@@ -86,6 +202,8 @@ private:
 
     friend class GattApplicationPrivate;
     friend class GattCharacteristicAdaptor;
+    friend class GattDescriptorPrivate;
+    friend class GattDescriptorAdaptor;
     friend class GattManager;
 };
 
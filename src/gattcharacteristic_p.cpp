@@ -8,15 +8,164 @@
 
 #include "gattcharacteristic_p.h"
 #include "gattservice.h"
+#include "debug.h"
+#include "gattsocketdevice_p.h"
+#include "utils.h"
+
+#ifdef Q_OS_LINUX
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QTimer>
 
 namespace BluezQt
 {
-GattCharacterisiticPrivate::GattCharacterisiticPrivate(const QString &uuid, const GattService *service)
-    : m_uuid(uuid)
+GattCharacterisiticPrivate::GattCharacterisiticPrivate(const QString &uuid, const GattService *service, GattCharacteristic *q)
+    : q(q)
+    , m_uuid(uuid)
     , m_service(service)
+    , m_flags({QStringLiteral("read"), QStringLiteral("write")})
+    , m_notifying(false)
+    , m_mergedNotificationsCount(0)
+    , m_writeDevice(nullptr)
+    , m_notifyDevice(nullptr)
 {
     static uint8_t charcNumber = 0;
     m_objectPath.setPath(m_service->objectPath().path() + QStringLiteral("/char") + QString::number(charcNumber++));
+
+    m_notifyTimer = new QTimer(q);
+    m_notifyTimer->setSingleShot(true);
+    m_notifyTimer->setInterval(0);
+    QObject::connect(m_notifyTimer, &QTimer::timeout, q, [this]() {
+        sendNotification();
+    });
+}
+
+bool GattCharacterisiticPrivate::canNotify() const
+{
+    return m_flags.contains(QLatin1String("notify")) || m_flags.contains(QLatin1String("indicate"));
+}
+
+void GattCharacterisiticPrivate::setNotifying(bool notifying)
+{
+    if (m_notifying == notifying) {
+        return;
+    }
+
+    m_notifying = notifying;
+    if (!m_notifying) {
+        m_notifyTimer->stop();
+    }
+
+    emitPropertiesChanged({{QStringLiteral("Notifying"), m_notifying}});
+    Q_EMIT q->notifyingChanged(m_notifying);
+}
+
+void GattCharacterisiticPrivate::sendNotification()
+{
+    if (!m_notifying) {
+        return;
+    }
+
+    // BlueZ sends notification or indication to subscribed clients on Value change
+    emitPropertiesChanged({{QStringLiteral("Value"), m_value}});
+}
+
+// Adaptor properties are not announced by QtDBus, the signal is sent on its behalf
+void GattCharacterisiticPrivate::emitPropertiesChanged(const QVariantMap &changed)
+{
+    QDBusMessage signal = QDBusMessage::createSignal(m_objectPath.path(), Strings::orgFreedesktopDBusProperties(), QStringLiteral("PropertiesChanged"));
+    signal << Strings::orgBluezGattCharacteristic1() << changed << QStringList();
+    DBusConnection::orgBluez().send(signal);
+}
+
+QDBusUnixFileDescriptor GattCharacterisiticPrivate::acquireWrite(const QVariantMap &options, quint16 &mtu)
+{
+    QDBusUnixFileDescriptor fd;
+
+    releaseSocketDevice(m_writeDevice);
+    m_writeDevice = createSocketDevice(options, QIODevice::ReadOnly, &fd);
+    if (!m_writeDevice) {
+        return fd;
+    }
+
+    QObject::connect(m_writeDevice, &GattSocketDevice::hangup, q, [this]() {
+        m_writeDevice->deleteLater();
+        m_writeDevice = nullptr;
+    });
+
+    mtu = m_writeDevice->mtu();
+    Q_EMIT q->writeAcquired(m_writeDevice);
+    return fd;
+}
+
+QDBusUnixFileDescriptor GattCharacterisiticPrivate::acquireNotify(const QVariantMap &options, quint16 &mtu)
+{
+    QDBusUnixFileDescriptor fd;
+
+    releaseSocketDevice(m_notifyDevice);
+    m_notifyDevice = createSocketDevice(options, QIODevice::WriteOnly, &fd);
+    if (!m_notifyDevice) {
+        return fd;
+    }
+
+    // BlueZ closes the socket when the last client unsubscribes
+    QObject::connect(m_notifyDevice, &GattSocketDevice::hangup, q, [this]() {
+        m_notifyDevice->deleteLater();
+        m_notifyDevice = nullptr;
+        setNotifying(false);
+    });
+
+    mtu = m_notifyDevice->mtu();
+    Q_EMIT q->notifyAcquired(m_notifyDevice);
+    setNotifying(true);
+    return fd;
+}
+
+// The application may still hold the device, it learns about it from aboutToClose()
+void GattCharacterisiticPrivate::releaseSocketDevice(GattSocketDevice *&device)
+{
+    if (!device) {
+        return;
+    }
+
+    QObject::disconnect(device, nullptr, q, nullptr);
+    device->close();
+    device->deleteLater();
+    device = nullptr;
+}
+
+GattSocketDevice *GattCharacterisiticPrivate::createSocketDevice(const QVariantMap &options, QIODevice::OpenMode mode, QDBusUnixFileDescriptor *fd)
+{
+#ifdef Q_OS_LINUX
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) < 0) {
+        qCWarning(BLUEZQT) << "Cannot create socket for" << m_objectPath.path();
+        return nullptr;
+    }
+
+    // Default ATT_MTU if BlueZ doesn't provide one
+    quint16 mtu = options.value(QStringLiteral("mtu")).value<quint16>();
+    if (mtu == 0) {
+        mtu = 23;
+    }
+
+    GattSocketDevice *device = new GattSocketDevice(fds[0], mtu, q);
+    device->open(mode | QIODevice::Unbuffered);
+
+    // QDBusUnixFileDescriptor holds its own duplicate
+    fd->setFileDescriptor(fds[1]);
+    ::close(fds[1]);
+    return device;
+#else
+    Q_UNUSED(options)
+    Q_UNUSED(mode)
+    Q_UNUSED(fd)
+    return nullptr;
+#endif
 }
 
 } // namespace BluezQt
@@ -10,20 +10,44 @@
 
 #include "gattcharacteristic.h"
 
+#include <QDBusUnixFileDescriptor>
+#include <QStringList>
+
+class QTimer;
+
 namespace BluezQt
 {
 class GattServicePrivate;
+class GattSocketDevice;
 
 class GattCharacterisiticPrivate
 {
 public:
-    GattCharacterisiticPrivate(const QString &uuid, const GattService *service);
+    GattCharacterisiticPrivate(const QString &uuid, const GattService *service, GattCharacteristic *q);
+
+    bool canNotify() const;
+    void setNotifying(bool notifying);
+    void sendNotification();
+    void emitPropertiesChanged(const QVariantMap &changed);
+
+    QDBusUnixFileDescriptor acquireWrite(const QVariantMap &options, quint16 &mtu);
+    QDBusUnixFileDescriptor acquireNotify(const QVariantMap &options, quint16 &mtu);
+    void releaseSocketDevice(GattSocketDevice *&device);
+    GattSocketDevice *createSocketDevice(const QVariantMap &options, QIODevice::OpenMode mode, QDBusUnixFileDescriptor *fd);
+
+    GattCharacteristic *q;
 
     QString m_uuid;
     const GattService *m_service;
     QDBusObjectPath m_objectPath;
     QByteArray m_value;
     GattCharacteristic::ReadCallback m_readCallback = nullptr;
+    QStringList m_flags;
+    bool m_notifying;
+    QTimer *m_notifyTimer;
+    quint64 m_mergedNotificationsCount;
+    GattSocketDevice *m_writeDevice;
+    GattSocketDevice *m_notifyDevice;
 };
 
 } // namespace BluezQt
@@ -8,7 +8,12 @@
 
 #include "gattcharacteristicadaptor.h"
 #include "gattcharacteristic.h"
+#include "gattcharacteristic_p.h"
 #include "gattservice.h"
+#include "utils.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
 
 namespace BluezQt
 {
@@ -30,8 +35,27 @@ QDBusObjectPath GattCharacteristicAdaptor::service() const
 
 QStringList GattCharacteristicAdaptor::flags() const
 {
-    // TODO: implement flags
-    return {QStringLiteral("read"), QStringLiteral("write")};
+    return m_gattCharacteristic->flags();
+}
+
+QByteArray GattCharacteristicAdaptor::value() const
+{
+    return m_gattCharacteristic->d->m_value;
+}
+
+bool GattCharacteristicAdaptor::notifying() const
+{
+    return m_gattCharacteristic->isNotifying();
+}
+
+bool GattCharacteristicAdaptor::writeAcquired() const
+{
+    return m_gattCharacteristic->writeDevice();
+}
+
+bool GattCharacteristicAdaptor::notifyAcquired() const
+{
+    return m_gattCharacteristic->notifyDevice();
 }
 
 QByteArray GattCharacteristicAdaptor::ReadValue(const QVariantMap & /*options*/)
@@ -44,14 +68,36 @@ void GattCharacteristicAdaptor::WriteValue(const QByteArray &value, const QVaria
     m_gattCharacteristic->writeValue(value);
 }
 
-void GattCharacteristicAdaptor::StartNotify()
+void GattCharacteristicAdaptor::StartNotify(const QDBusMessage &msg)
 {
-    // TODO: implement
+    if (!m_gattCharacteristic->d->canNotify()) {
+        msg.setDelayedReply(true);
+        DBusConnection::orgBluez().send(msg.createErrorReply(QStringLiteral("org.bluez.Error.NotSupported"), QStringLiteral("Notifications not supported")));
+        return;
+    }
+
+    m_gattCharacteristic->d->setNotifying(true);
 }
 
 void GattCharacteristicAdaptor::StopNotify()
 {
-    // TODO: implement
+    m_gattCharacteristic->d->setNotifying(false);
+}
+
+QDBusUnixFileDescriptor GattCharacteristicAdaptor::AcquireWrite(const QVariantMap &options, quint16 &mtu)
+{
+    return m_gattCharacteristic->d->acquireWrite(options, mtu);
+}
+
+QDBusUnixFileDescriptor GattCharacteristicAdaptor::AcquireNotify(const QVariantMap &options, const QDBusMessage &msg, quint16 &mtu)
+{
+    if (!m_gattCharacteristic->d->canNotify()) {
+        msg.setDelayedReply(true);
+        DBusConnection::orgBluez().send(msg.createErrorReply(QStringLiteral("org.bluez.Error.NotSupported"), QStringLiteral("Notifications not supported")));
+        return QDBusUnixFileDescriptor();
+    }
+
+    return m_gattCharacteristic->d->acquireNotify(options, mtu);
 }
 
 } // namespace BluezQt
@@ -9,7 +9,9 @@
 #pragma once
 
 #include <QDBusAbstractAdaptor>
+#include <QDBusUnixFileDescriptor>
 
+class QDBusMessage;
 class QDBusObjectPath;
 
 namespace BluezQt
@@ -23,6 +25,10 @@ class GattCharacteristicAdaptor : public QDBusAbstractAdaptor
     Q_PROPERTY(QString UUID READ uuid)
     Q_PROPERTY(QDBusObjectPath Service READ service)
     Q_PROPERTY(QStringList Flags READ flags)
+    Q_PROPERTY(QByteArray Value READ value)
+    Q_PROPERTY(bool Notifying READ notifying)
+    Q_PROPERTY(bool WriteAcquired READ writeAcquired)
+    Q_PROPERTY(bool NotifyAcquired READ notifyAcquired)
 
 public:
     explicit GattCharacteristicAdaptor(GattCharacteristic *parent);
@@ -33,11 +39,21 @@ public:
 
     QStringList flags() const;
 
+    QByteArray value() const;
+
+    bool notifying() const;
+
+    bool writeAcquired() const;
+
+    bool notifyAcquired() const;
+
 public Q_SLOTS:
     QByteArray ReadValue(const QVariantMap &options);
     void WriteValue(const QByteArray &value, const QVariantMap &options);
-    void StartNotify();
+    void StartNotify(const QDBusMessage &msg);
     void StopNotify();
+    QDBusUnixFileDescriptor AcquireWrite(const QVariantMap &options, quint16 &mtu);
+    QDBusUnixFileDescriptor AcquireNotify(const QVariantMap &options, const QDBusMessage &msg, quint16 &mtu);
 
 private:
     GattCharacteristic *m_gattCharacteristic;
@@ -8,6 +8,7 @@
 
 #include "gattcharacteristicremote.h"
 #include "gattcharacteristicremote_p.h"
+#include "gattwritejob.h"
 #include "pendingcall.h"
 #include "utils.h"
 
@@ -31,7 +32,7 @@ GattCharacteristicRemotePtr GattCharacteristicRemote::toSharedPtr() const
 
 QString GattCharacteristicRemote::ubi() const
 {
-    return d->m_bluezGattCharacteristic->path();
+    return d->m_path;
 }
 
 QString GattCharacteristicRemote::uuid() const
@@ -39,6 +40,11 @@ QString GattCharacteristicRemote::uuid() const
     return d->m_uuid;
 }
 
+Uuid GattCharacteristicRemote::uuidValue() const
+{
+    return d->m_uuidValue;
+}
+
 QByteArray GattCharacteristicRemote::value() const
 {
     return d->m_value;
@@ -74,6 +80,31 @@ QList<GattDescriptorRemotePtr> GattCharacteristicRemote::descriptors() const
     return d->m_descriptors;
 }
 
+int GattCharacteristicRemote::notificationBufferSize() const
+{
+    return d->m_notifications.size();
+}
+
+void GattCharacteristicRemote::setNotificationBufferSize(int size)
+{
+    d->setNotificationBufferSize(size);
+}
+
+int GattCharacteristicRemote::notificationsPending() const
+{
+    return d->m_notificationCount;
+}
+
+quint64 GattCharacteristicRemote::droppedNotifications() const
+{
+    return d->m_droppedNotifications;
+}
+
+QVector<GattCharacteristicRemote::Notification> GattCharacteristicRemote::takeNotifications(int maxCount)
+{
+    return d->takeNotifications(maxCount);
+}
+
 quint16 GattCharacteristicRemote::handle() const
 {
     return d->m_handle;
@@ -91,27 +122,66 @@ quint16 GattCharacteristicRemote::MTU() const
 
 PendingCall *GattCharacteristicRemote::readValue(const QVariantMap &options)
 {
-    return new PendingCall(d->m_bluezGattCharacteristic->ReadValue(options), PendingCall::ReturnByteArray, this);
+    return new PendingCall(d->bluezGattCharacteristic()->ReadValue(options), PendingCall::ReturnByteArray, this);
 }
 
 PendingCall *GattCharacteristicRemote::writeValue(const QByteArray &value, const QVariantMap &options)
 {
-    return new PendingCall(d->m_bluezGattCharacteristic->WriteValue(value,options), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezGattCharacteristic()->WriteValue(value,options), PendingCall::ReturnVoid, this);
+}
+
+GattWriteJob *GattCharacteristicRemote::writeValueStream(const QByteArray &value, const QVariantMap &options)
+{
+    return new GattWriteJob(this, value, options);
+}
+
+GattWriteJob *GattCharacteristicRemote::writeValueStream(QIODevice *device, const QVariantMap &options)
+{
+    return new GattWriteJob(this, device, options);
 }
 
 PendingCall *GattCharacteristicRemote::startNotify()
 {
-    return new PendingCall(d->m_bluezGattCharacteristic->StartNotify(), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezGattCharacteristic()->StartNotify(), PendingCall::ReturnVoid, this);
 }
 
 PendingCall *GattCharacteristicRemote::stopNotify()
 {
-    return new PendingCall(d->m_bluezGattCharacteristic->StopNotify(), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezGattCharacteristic()->StopNotify(), PendingCall::ReturnVoid, this);
 }
 
 PendingCall *GattCharacteristicRemote::confirm()
 {
-    return new PendingCall(d->m_bluezGattCharacteristic->Confirm(), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezGattCharacteristic()->Confirm(), PendingCall::ReturnVoid, this);
+}
+
+TPendingCall<QDBusUnixFileDescriptor, uint16_t> *GattCharacteristicRemote::acquireWrite(const QVariantMap &options)
+{
+    const QDBusPendingCall call = d->bluezGattCharacteristic()->AcquireWrite(options);
+    d->watchAcquireWrite(call);
+    return new TPendingCall<QDBusUnixFileDescriptor, uint16_t>(call, this);
+}
+
+TPendingCall<QDBusUnixFileDescriptor, uint16_t> *GattCharacteristicRemote::acquireNotify(const QVariantMap &options)
+{
+    const QDBusPendingCall call = d->bluezGattCharacteristic()->AcquireNotify(options);
+    d->watchAcquireNotify(call);
+    return new TPendingCall<QDBusUnixFileDescriptor, uint16_t>(call, this);
+}
+
+bool GattCharacteristicRemote::sendValue(const QByteArray &value)
+{
+    return d->sendValue(value);
+}
+
+void GattCharacteristicRemote::releaseWrite()
+{
+    d->closeWriteSocket();
+}
+
+void GattCharacteristicRemote::releaseNotify()
+{
+    d->closeNotifySocket();
 }
 
 } // namespace BluezQt
@@ -11,14 +11,22 @@
 
 #include "bluezqt_export.h"
 #include "gattdescriptorremote.h"
+#include "tpendingcall.h"
 #include "types.h"
+#include "uuid.h"
 #include <QList>
 #include <QMap>
+#include <QDBusUnixFileDescriptor>
 #include <QObject>
+#include <QVector>
+
+class QIODevice;
+
 namespace BluezQt
 {
 
 class GattServiceRemote;
+class GattWriteJob;
 class PendingCall;
 
 /**
@@ -45,6 +53,16 @@ class BLUEZQT_EXPORT GattCharacteristicRemote : public QObject
 
 
 public:
+    /**
+     * Notification received from the characteristic.
+     */
+    struct Notification {
+        /** Value of the notification */
+        QByteArray value;
+        /** Time of reception in milliseconds since epoch */
+        qint64 timestamp;
+    };
+
     /**
      * Destroys a GattCharacteristic object.
      */
@@ -73,6 +91,13 @@ public:
      */
     QString uuid() const;
 
+    /**
+     * Returns an uuid of the characteristic as value that is compared as integers.
+     *
+     * @return uuid of the characteristic
+     */
+    Uuid uuidValue() const;
+
     /**
      * Returns an value of the characteristic.
      *
@@ -145,6 +170,55 @@ public:
      */
     QList<GattDescriptorRemotePtr> descriptors() const;
 
+    /**
+     * Returns capacity of the notification buffer.
+     *
+     * @return capacity of the buffer, 0 if buffering is disabled
+     */
+    int notificationBufferSize() const;
+
+    /**
+     * Sets capacity of the notification buffer.
+     *
+     * When the buffer is enabled, every received notification is stored
+     * in the buffer with its timestamp. Instead of one valueChanged() per
+     * notification, notificationsAvailable(), valueChanged() with the latest
+     * value and characteristicChanged() are emitted once per batch of
+     * notifications received together, both from D-Bus and from the socket.
+     *
+     * When the buffer is full, the oldest notifications are dropped.
+     * Shrinking the buffer drops the oldest notifications that no longer fit,
+     * setting size to 0 disables the buffer and drops all of them.
+     *
+     * @param size maximum number of buffered notifications
+     */
+    void setNotificationBufferSize(int size);
+
+    /**
+     * Returns the number of notifications in the buffer.
+     *
+     * @return number of buffered notifications
+     */
+    int notificationsPending() const;
+
+    /**
+     * Returns the number of notifications dropped because the buffer was full
+     * or was shrunk.
+     *
+     * @return number of dropped notifications
+     */
+    quint64 droppedNotifications() const;
+
+    /**
+     * Removes notifications from the buffer and returns them.
+     *
+     * Notifications are returned from the oldest.
+     *
+     * @param maxCount maximum number of notifications to take, -1 for all
+     * @return buffered notifications
+     */
+    QVector<Notification> takeNotifications(int maxCount = -1);
+
 public Q_SLOTS:
     /**
      * Read the value of the GATT characteristic.
@@ -171,6 +245,32 @@ public Q_SLOTS:
      */
     PendingCall *writeValue(const QByteArray &value, const QVariantMap &options);
 
+    /**
+     * Write a large value to the GATT characteristic.
+     *
+     * The value is split into MTU sized chunks that are written in order
+     * with several writes in flight at once. The returned job must be
+     * started with Job::start().
+     *
+     * @param value value to write
+     * @param options write options, "type" is chosen from flags() if not set
+     * @return write job
+     */
+    GattWriteJob *writeValueStream(const QByteArray &value, const QVariantMap &options);
+
+    /**
+     * Write the content of device to the GATT characteristic.
+     *
+     * The device is read in MTU sized chunks as the writes are acknowledged.
+     * Sequential devices are read as data arrives, until the read channel
+     * is finished or the device is closed.
+     *
+     * @param device opened device to read from
+     * @param options write options, "type" is chosen from flags() if not set
+     * @return write job
+     */
+    GattWriteJob *writeValueStream(QIODevice *device, const QVariantMap &options);
+
     /**
      * Start notifying the value of the GATT characteristic.
      *
@@ -211,6 +311,63 @@ public Q_SLOTS:
      */
     PendingCall *confirm();
 
+    /**
+     * Acquire file descriptor for writing the value of the characteristic.
+     *
+     * Writes to the returned socket are done without response and bypass
+     * D-Bus, which makes it suitable for high rate writes. Each write
+     * must fit into MTU minus the 3 byte ATT header.
+     *
+     * The characteristic keeps its own copy of the socket that is used by
+     * sendValue(). The returned file descriptor can be used directly instead.
+     *
+     * Possible errors: PendingCall::Failed, PendingCall::NotSupported,
+     *                  PendingCall::NotPermitted
+     *
+     * @return <fd, uint16> pending call with socket and MTU
+     */
+    TPendingCall<QDBusUnixFileDescriptor, uint16_t> *acquireWrite(const QVariantMap &options);
+
+    /**
+     * Acquire file descriptor for receiving notifications of the characteristic.
+     *
+     * Notifications are read from the socket as they arrive and reported
+     * with valueChanged() without going through D-Bus. Notifications stop
+     * when the socket is closed by releaseNotify() or by the remote side.
+     *
+     * The returned file descriptor is a copy of the socket that is being read
+     * by the characteristic, it should not be read from.
+     *
+     * Possible errors: PendingCall::Failed, PendingCall::NotSupported,
+     *                  PendingCall::NotPermitted, PendingCall::InProgress
+     *
+     * @return <fd, uint16> pending call with socket and MTU
+     */
+    TPendingCall<QDBusUnixFileDescriptor, uint16_t> *acquireNotify(const QVariantMap &options);
+
+    /**
+     * Writes the value through the socket acquired with acquireWrite().
+     *
+     * Values larger than MTU returned by acquireWrite() minus the 3 byte
+     * ATT header are not written, use writeValue() or writeValueStream() for them.
+     *
+     * @param value value to write, must fit into MTU - 3
+     * @return true if the value was written
+     */
+    bool sendValue(const QByteArray &value);
+
+    /**
+     * Closes the socket acquired with acquireWrite().
+     */
+    void releaseWrite();
+
+    /**
+     * Closes the socket acquired with acquireNotify().
+     *
+     * Notifications are stopped once all copies of the file descriptor are closed.
+     */
+    void releaseNotify();
+
 Q_SIGNALS:
     /**
      * Indicates that at least one of the characteristic's properties have changed.
@@ -247,6 +404,13 @@ Q_SIGNALS:
      */
     void valueChanged(const QByteArray value);
 
+    /**
+     * Indicates that new notifications were stored in the notification buffer.
+     *
+     * @param count number of notifications in the buffer
+     */
+    void notificationsAvailable(int count);
+
     /**
      * Indicates that characteristic's writeAcquired state have changed.
      */
@@ -291,4 +455,6 @@ private:
 
 } // namespace BluezQt
 
+Q_DECLARE_TYPEINFO(BluezQt::GattCharacteristicRemote::Notification, Q_MOVABLE_TYPE);
+
 #endif // BLUEZQT_GATTCHARACTERISTICREMOTE_H
@@ -20,11 +20,23 @@
 #include "utils.h"
 #include "macros.h"
 
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <QDateTime>
+#include <QDBusPendingCallWatcher>
+#include <QDBusUnixFileDescriptor>
+
 namespace BluezQt
 {
 
 GattCharacteristicRemotePrivate::GattCharacteristicRemotePrivate(const QString &path, const QVariantMap &properties, const GattServiceRemotePtr &service)
     : QObject()
+    , m_path(path)
+    , m_bluezGattCharacteristic(nullptr)
     , m_dbusProperties(nullptr)
     , m_writeAcquired(false)
     , m_notifyAcquired(false)
@@ -32,19 +44,30 @@ GattCharacteristicRemotePrivate::GattCharacteristicRemotePrivate(const QString &
     , m_handle()
     , m_MTU()
     , m_service(service)
+    , m_writeSocket(-1)
+    , m_writeMtu(0)
+    , m_notifySocket(-1)
+    , m_notifyMtu(0)
+    , m_notifyNotifier(nullptr)
+    , m_notificationHead(0)
+    , m_notificationCount(0)
+    , m_droppedNotifications(0)
+    , m_notificationsAvailablePending(false)
 {
-    m_bluezGattCharacteristic = new BluezGattCharacteristic(Strings::orgBluez(), path, DBusConnection::orgBluez(), this);
-
     init(properties);
 }
 
-void GattCharacteristicRemotePrivate::init(const QVariantMap &properties)
+GattCharacteristicRemotePrivate::~GattCharacteristicRemotePrivate()
 {
-    m_dbusProperties = new DBusProperties(Strings::orgBluez(), m_bluezGattCharacteristic->path(),
-                                          DBusConnection::orgBluez(), this);
+    closeWriteSocket();
+    closeNotifySocket();
+}
 
+void GattCharacteristicRemotePrivate::init(const QVariantMap &properties)
+{
     // Init properties
     m_uuid = properties.value(QStringLiteral("UUID")).toString();
+    m_uuidValue = Uuid(m_uuid);
     m_value = properties.value(QStringLiteral("Value")).toByteArray();
     m_writeAcquired = properties.value(QStringLiteral("WriteAcquired")).toBool();
     m_notifyAcquired = properties.value(QStringLiteral("NotifyAcquired")).toBool();
@@ -91,7 +114,7 @@ void GattCharacteristicRemotePrivate::interfacesRemoved(const QString &path, con
 void GattCharacteristicRemotePrivate::addGattDescriptor(const QString &gattDescriptorPath, const QVariantMap &properties)
 {
     // Check if we have the right path
-    if (m_bluezGattCharacteristic->path() != properties.value(QStringLiteral("Characteristic")).value<QDBusObjectPath>().path()) {
+    if (m_path != properties.value(QStringLiteral("Characteristic")).value<QDBusObjectPath>().path()) {
         return;
     }
 
@@ -104,6 +127,7 @@ void GattCharacteristicRemotePrivate::addGattDescriptor(const QString &gattDescr
     GattDescriptorRemotePtr gattDescriptor = GattDescriptorRemotePtr(new GattDescriptorRemote(gattDescriptorPath, properties, characteristic));
     gattDescriptor->d->q = gattDescriptor.toWeakRef();
     m_descriptors.append(gattDescriptor);
+    m_descriptorsByPath.insert(gattDescriptorPath, gattDescriptor);
 
     Q_EMIT characteristic->gattDescriptorAdded(gattDescriptor);
     Q_EMIT characteristic->descriptorsChanged(m_descriptors);
@@ -120,14 +144,8 @@ void GattCharacteristicRemotePrivate::removeGattDescriptor(const QString &gattDe
         return;
     }
 
-    GattDescriptorRemotePtr gattDescriptor = nullptr;
-    for (int i=0; i < characteristic->descriptors().size(); ++i) {
-        if (characteristic->descriptors().at(i)->ubi() == gattDescriptorPath) {
-            gattDescriptor = characteristic->descriptors().at(i);
-        }
-    }
-
-    if (gattDescriptor == nullptr) {
+    GattDescriptorRemotePtr gattDescriptor = m_descriptorsByPath.take(gattDescriptorPath);
+    if (!gattDescriptor) {
         return;
     }
 
@@ -140,9 +158,25 @@ void GattCharacteristicRemotePrivate::removeGattDescriptor(const QString &gattDe
     disconnect(gattDescriptor.data(),&GattDescriptorRemote::descriptorChanged,q.lock().data(),&GattCharacteristicRemote::gattDescriptorChanged);
 }
 
+BluezGattCharacteristic *GattCharacteristicRemotePrivate::bluezGattCharacteristic()
+{
+    if (!m_bluezGattCharacteristic) {
+        m_bluezGattCharacteristic = new BluezGattCharacteristic(Strings::orgBluez(), m_path, DBusConnection::orgBluez(), this);
+    }
+    return m_bluezGattCharacteristic;
+}
+
+DBusProperties *GattCharacteristicRemotePrivate::dbusProperties()
+{
+    if (!m_dbusProperties) {
+        m_dbusProperties = new DBusProperties(Strings::orgBluez(), m_path, DBusConnection::orgBluez(), this);
+    }
+    return m_dbusProperties;
+}
+
 QDBusPendingReply<> GattCharacteristicRemotePrivate::setDBusProperty(const QString &name, const QVariant &value)
 {
-    return m_dbusProperties->Set(Strings::orgBluezGattCharacteristic1(), name, QDBusVariant(value));
+    return dbusProperties()->Set(Strings::orgBluezGattCharacteristic1(), name, QDBusVariant(value));
 }
 
 void GattCharacteristicRemotePrivate::propertiesChanged(const QString &path, const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
@@ -150,29 +184,43 @@ void GattCharacteristicRemotePrivate::propertiesChanged(const QString &path, con
     Q_UNUSED(path)
 
     if (interface == Strings::orgBluezGattDescriptor1()) {
-        for (GattDescriptorRemotePtr descriptor : m_descriptors) {
-            if (path.startsWith(descriptor->ubi())) {
-                descriptor->d->propertiesChanged(path, interface, changed, invalidated);
-                return;
-            }
+        if (GattDescriptorRemotePtr descriptor = m_descriptorsByPath.value(path)) {
+            descriptor->d->propertiesChanged(path, interface, changed, invalidated);
         }
+        return;
     } else if (interface != Strings::orgBluezGattCharacteristic1()) {
         return;
     }
 
+    // Buffered notifications report characteristicChanged with the batch
+    bool buffered = !changed.isEmpty() && invalidated.isEmpty();
+
     QVariantMap::const_iterator i;
     for (i = changed.constBegin(); i != changed.constEnd(); ++i) {
         const QVariant &value = i.value();
         const QString &property = i.key();
 
+        if (property == QLatin1String("Value") && !m_notifications.isEmpty()) {
+            m_value = value.toByteArray();
+            bufferNotification(m_value);
+            if (!m_notificationsAvailablePending) {
+                m_notificationsAvailablePending = true;
+                QMetaObject::invokeMethod(this, &GattCharacteristicRemotePrivate::emitNotificationsAvailable, Qt::QueuedConnection);
+            }
+            continue;
+        }
+
+        buffered = false;
+
         if (property == QLatin1String("UUID")) {
+            m_uuidValue = Uuid(value.toString());
             PROPERTY_CHANGED(m_uuid, toString, uuidChanged);
         } else if (property == QLatin1String("Value")) {
             PROPERTY_CHANGED(m_value, toByteArray, valueChanged);
         } else if (property == QLatin1String("WriteAcquired")) {
             PROPERTY_CHANGED(m_writeAcquired, toBool, writeAcquiredChanged);
         } else if (property == QLatin1String("NotifyAcquired")) {
-            PROPERTY_CHANGED(m_writeAcquired, toBool, writeAcquiredChanged);
+            PROPERTY_CHANGED(m_notifyAcquired, toBool, notifyAcquiredChanged);
         } else if (property == QLatin1String("Notifying")) {
             PROPERTY_CHANGED(m_notifying, toBool, notifyingChanged);
         } else if (property == QLatin1String("Flags")) {
@@ -186,13 +234,14 @@ void GattCharacteristicRemotePrivate::propertiesChanged(const QString &path, con
 
     for (auto& property : invalidated) {
         if (property == QLatin1String("UUID")) {
+            m_uuidValue = Uuid();
             PROPERTY_INVALIDATED(m_uuid, QString(), uuidChanged);
         } else if (property == QLatin1String("Value")) {
             PROPERTY_INVALIDATED(m_value, QByteArray(), valueChanged);
         } else if (property == QLatin1String("WriteAcquired")) {
             PROPERTY_INVALIDATED(m_writeAcquired, false, writeAcquiredChanged);
         } else if (property == QLatin1String("NotifyAcquired")) {
-            PROPERTY_INVALIDATED(m_writeAcquired, false, writeAcquiredChanged);
+            PROPERTY_INVALIDATED(m_notifyAcquired, false, notifyAcquiredChanged);
         } else if (property == QLatin1String("Notifying")) {
             PROPERTY_INVALIDATED(m_notifying, false, notifyingChanged);
         } else if (property == QLatin1String("Flags")) {
@@ -204,7 +253,208 @@ void GattCharacteristicRemotePrivate::propertiesChanged(const QString &path, con
         }
     }
 
-    q.lock().data()->characteristicChanged(q.toStrongRef());
+    if (!buffered) {
+        q.lock().data()->characteristicChanged(q.toStrongRef());
+    }
+}
+
+// The watchers are created before the returned TPendingCall, so the socket
+// is already set up when the caller gets the result
+void GattCharacteristicRemotePrivate::watchAcquireWrite(const QDBusPendingCall &call)
+{
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
+        const QDBusPendingReply<QDBusUnixFileDescriptor, quint16> reply = *watcher;
+        watcher->deleteLater();
+
+        if (reply.isError() || !reply.argumentAt<0>().isValid()) {
+            return;
+        }
+
+#ifdef Q_OS_LINUX
+        closeWriteSocket();
+        m_writeSocket = ::dup(reply.argumentAt<0>().fileDescriptor());
+        m_writeMtu = reply.argumentAt<1>();
+#endif
+    });
+}
+
+void GattCharacteristicRemotePrivate::watchAcquireNotify(const QDBusPendingCall &call)
+{
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
+        const QDBusPendingReply<QDBusUnixFileDescriptor, quint16> reply = *watcher;
+        watcher->deleteLater();
+
+        if (reply.isError() || !reply.argumentAt<0>().isValid()) {
+            return;
+        }
+
+#ifdef Q_OS_LINUX
+        closeNotifySocket();
+        m_notifySocket = ::dup(reply.argumentAt<0>().fileDescriptor());
+        if (m_notifySocket < 0) {
+            return;
+        }
+
+        m_notifyMtu = reply.argumentAt<1>();
+        m_notifyNotifier = new QSocketNotifier(m_notifySocket, QSocketNotifier::Read, this);
+        connect(m_notifyNotifier, &QSocketNotifier::activated, this, &GattCharacteristicRemotePrivate::notifySocketActivated);
+#endif
+    });
+}
+
+bool GattCharacteristicRemotePrivate::sendValue(const QByteArray &value)
+{
+#ifdef Q_OS_LINUX
+    // Each packet is one write, it would be truncated by the remote side.
+    // MTU returned by AcquireWrite is ATT MTU, which includes the 3 byte header.
+    if (m_writeSocket < 0 || value.size() > m_writeMtu - 3) {
+        return false;
+    }
+
+    const ssize_t written = ::send(m_writeSocket, value.constData(), value.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (written < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        closeWriteSocket();
+    }
+    return written == value.size();
+#else
+    Q_UNUSED(value)
+    return false;
+#endif
+}
+
+void GattCharacteristicRemotePrivate::notifySocketActivated()
+{
+#ifdef Q_OS_LINUX
+    // Each packet on the socket is one notification
+    const int bufferSize = qMax<int>(m_notifyMtu, 23);
+    bool received = false;
+
+    while (m_notifySocket >= 0) {
+        QByteArray value(bufferSize, Qt::Uninitialized);
+        const ssize_t size = ::recv(m_notifySocket, value.data(), value.size(), MSG_DONTWAIT);
+        if (size < 0 && errno == EINTR) {
+            continue;
+        } else if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else if (size <= 0) {
+            // Remote side closed the socket, notifications have stopped
+            closeNotifySocket();
+            break;
+        }
+
+        value.resize(size);
+        m_value = value;
+        received = true;
+        if (m_notifications.isEmpty()) {
+            Q_EMIT q.lock()->valueChanged(m_value);
+        } else {
+            bufferNotification(m_value);
+        }
+    }
+
+    if (received) {
+        if (m_notifications.isEmpty()) {
+            Q_EMIT q.lock()->characteristicChanged(q.toStrongRef());
+        } else {
+            emitNotificationsAvailable();
+        }
+    }
+#endif
+}
+
+void GattCharacteristicRemotePrivate::closeWriteSocket()
+{
+#ifdef Q_OS_LINUX
+    if (m_writeSocket >= 0) {
+        ::close(m_writeSocket);
+        m_writeSocket = -1;
+    }
+#endif
+}
+
+void GattCharacteristicRemotePrivate::closeNotifySocket()
+{
+    // May be called from the notifier's own activated signal
+    if (m_notifyNotifier) {
+        m_notifyNotifier->setEnabled(false);
+        m_notifyNotifier->deleteLater();
+        m_notifyNotifier = nullptr;
+    }
+
+#ifdef Q_OS_LINUX
+    if (m_notifySocket >= 0) {
+        ::close(m_notifySocket);
+        m_notifySocket = -1;
+    }
+#endif
+}
+
+void GattCharacteristicRemotePrivate::setNotificationBufferSize(int size)
+{
+    const QVector<GattCharacteristicRemote::Notification> pending = takeNotifications(-1);
+
+    m_notifications.clear();
+    m_notifications.resize(qMax(0, size));
+    m_notificationHead = 0;
+    m_notificationCount = 0;
+
+    // Keep the newest notifications that fit into the new buffer
+    const int dropped = qMax(0, pending.size() - m_notifications.size());
+    for (int i = dropped; i < pending.size(); ++i) {
+        m_notifications[m_notificationCount++] = pending.at(i);
+    }
+    m_droppedNotifications += dropped;
+}
+
+void GattCharacteristicRemotePrivate::bufferNotification(const QByteArray &value)
+{
+    const int capacity = m_notifications.size();
+    int index = m_notificationHead + m_notificationCount;
+
+    if (m_notificationCount == capacity) {
+        // Overwrite the oldest one
+        index = m_notificationHead;
+        m_notificationHead = (m_notificationHead + 1) % capacity;
+        m_droppedNotifications++;
+    } else {
+        m_notificationCount++;
+    }
+
+    GattCharacteristicRemote::Notification &notification = m_notifications[index % capacity];
+    notification.value = value;
+    notification.timestamp = QDateTime::currentMSecsSinceEpoch();
+}
+
+void GattCharacteristicRemotePrivate::emitNotificationsAvailable()
+{
+    m_notificationsAvailablePending = false;
+
+    if (m_notificationCount == 0) {
+        return;
+    }
+
+    Q_EMIT q.lock()->notificationsAvailable(m_notificationCount);
+    Q_EMIT q.lock()->valueChanged(m_value);
+    Q_EMIT q.lock()->characteristicChanged(q.toStrongRef());
+}
+
+QVector<GattCharacteristicRemote::Notification> GattCharacteristicRemotePrivate::takeNotifications(int maxCount)
+{
+    const int count = maxCount < 0 ? m_notificationCount : qMin(maxCount, m_notificationCount);
+    QVector<GattCharacteristicRemote::Notification> notifications;
+    notifications.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        GattCharacteristicRemote::Notification &notification = m_notifications[m_notificationHead];
+        notifications.append({std::move(notification.value), notification.timestamp});
+        notification.value = QByteArray();
+        m_notificationHead = (m_notificationHead + 1) % m_notifications.size();
+    }
+    m_notificationCount -= count;
+
+    return notifications;
 }
 
 } // namespace BluezQt
@@ -9,10 +9,15 @@
 #ifndef BLUEZQT_GATTCHARACTERISTIC_P_H
 #define BLUEZQT_GATTCHARACTERISTIC_P_H
 
+#include <QHash>
 #include <QObject>
+#include <QSocketNotifier>
 #include <QStringList>
+#include <QVector>
 
+#include "gattcharacteristicremote.h"
 #include "types.h"
+#include "uuid.h"
 #include "bluezgattcharacteristic1.h"
 #include "dbusproperties.h"
 #include "bluezqt_dbustypes.h"
@@ -29,6 +34,7 @@ class GattCharacteristicRemotePrivate : public QObject
 
 public:
     explicit GattCharacteristicRemotePrivate(const QString &path, const QVariantMap &properties, const GattServiceRemotePtr &service);
+    ~GattCharacteristicRemotePrivate() override;
 
     void init(const QVariantMap &properties);
 
@@ -38,14 +44,31 @@ public:
     void addGattDescriptor(const QString &gattDescriptorPath, const QVariantMap &properties);
     void removeGattDescriptor(const QString &gattDescriptorPath);
 
+    BluezGattCharacteristic *bluezGattCharacteristic();
+    DBusProperties *dbusProperties();
+
     QDBusPendingReply<> setDBusProperty(const QString &name, const QVariant &value);
     void propertiesChanged(const QString &path, const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
 
+    void watchAcquireWrite(const QDBusPendingCall &call);
+    void watchAcquireNotify(const QDBusPendingCall &call);
+    bool sendValue(const QByteArray &value);
+    void notifySocketActivated();
+    void closeWriteSocket();
+    void closeNotifySocket();
+
+    void setNotificationBufferSize(int size);
+    void bufferNotification(const QByteArray &value);
+    void emitNotificationsAvailable();
+    QVector<GattCharacteristicRemote::Notification> takeNotifications(int maxCount);
+
     QWeakPointer<GattCharacteristicRemote> q;
+    QString m_path;
     BluezGattCharacteristic *m_bluezGattCharacteristic;
     DBusProperties *m_dbusProperties;
 
     QString m_uuid;
+    Uuid m_uuidValue;
     QByteArray m_value;
     bool m_writeAcquired;
     bool m_notifyAcquired;
@@ -55,6 +78,20 @@ public:
     quint16 m_MTU;
     const GattServiceRemotePtr m_service;
     QList<GattDescriptorRemotePtr> m_descriptors;
+    QHash<QString, GattDescriptorRemotePtr> m_descriptorsByPath;
+
+    int m_writeSocket;
+    quint16 m_writeMtu;
+    int m_notifySocket;
+    quint16 m_notifyMtu;
+    QSocketNotifier *m_notifyNotifier;
+
+    // Ring buffer of notifications, capacity is the size of the vector
+    QVector<GattCharacteristicRemote::Notification> m_notifications;
+    int m_notificationHead;
+    int m_notificationCount;
+    quint64 m_droppedNotifications;
+    bool m_notificationsAvailablePending;
 };
 
 } // namespace BluezQt
@@ -0,0 +1,178 @@
+/*
+ * BluezQt - Asynchronous Bluez wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "gattdatabase.h"
+#include "gattdatabase_p.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace BluezQt
+{
+static const quint32 CACHE_MAGIC = 0x42514744; // "BQGD"
+static const quint8 CACHE_VERSION = 1;
+
+QByteArray GattDatabasePrivate::layoutHash(const QVector<GattDatabase::Attribute> &attributes)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (const GattDatabase::Attribute &attribute : attributes) {
+        const char header[3] = {char(attribute.type), char(attribute.handle >> 8), char(attribute.handle & 0xFF)};
+        hash.addData(header, sizeof(header));
+        hash.addData(attribute.uuid.toString().toLatin1());
+    }
+    return hash.result();
+}
+
+GattDatabase::GattDatabase()
+    : d(new GattDatabasePrivate)
+{
+}
+
+GattDatabase::~GattDatabase()
+{
+}
+
+GattDatabase::GattDatabase(const GattDatabase &other)
+    : d(other.d)
+{
+}
+
+GattDatabase &GattDatabase::operator=(const GattDatabase &other)
+{
+    if (d != other.d) {
+        d = other.d;
+    }
+    return *this;
+}
+
+bool GattDatabase::isValid() const
+{
+    return d->m_valid;
+}
+
+QString GattDatabase::address() const
+{
+    return d->m_address;
+}
+
+QByteArray GattDatabase::hash() const
+{
+    return d->m_hash;
+}
+
+QVector<GattDatabase::Attribute> GattDatabase::attributes() const
+{
+    return d->m_attributes;
+}
+
+int GattDatabase::servicesCount() const
+{
+    int count = 0;
+    for (const Attribute &attribute : std::as_const(d->m_attributes)) {
+        if (attribute.type == Attribute::Service) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+bool GattDatabase::save(const QString &fileName) const
+{
+    if (!d->m_valid) {
+        return false;
+    }
+
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream << CACHE_MAGIC << CACHE_VERSION << d->m_address << d->m_hash << quint32(d->m_attributes.size());
+    for (const Attribute &attribute : std::as_const(d->m_attributes)) {
+        stream << quint8(attribute.type) << attribute.handle << attribute.uuid.toString() << attribute.path << attribute.flags;
+    }
+
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+bool GattDatabase::saveCache() const
+{
+    return save(cacheFileName(d->m_address));
+}
+
+GattDatabase GattDatabase::load(const QString &fileName)
+{
+    GattDatabase database;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return database;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic;
+    quint8 version;
+    quint32 count;
+    stream >> magic >> version;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION) {
+        return database;
+    }
+
+    QString address;
+    QByteArray hash;
+    stream >> address >> hash >> count;
+
+    QVector<Attribute> attributes;
+    attributes.reserve(int(qMin<quint32>(count, 0xFFFF)));
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        quint8 type;
+        QString uuid;
+        Attribute attribute;
+        stream >> type >> attribute.handle >> uuid >> attribute.path >> attribute.flags;
+        if (type > Attribute::Descriptor) {
+            return database;
+        }
+        attribute.type = Attribute::Type(type);
+        attribute.uuid = Uuid(uuid);
+        attributes.append(attribute);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        return database;
+    }
+
+    database.d->m_valid = true;
+    database.d->m_address = address;
+    database.d->m_hash = hash;
+    database.d->m_attributes = attributes;
+    return database;
+}
+
+GattDatabase GattDatabase::loadCache(const QString &address, const QByteArray &hash)
+{
+    const GattDatabase database = load(cacheFileName(address));
+    if (!database.isValid() || database.address() != address || (!hash.isEmpty() && database.hash() != hash)) {
+        return GattDatabase();
+    }
+    return database;
+}
+
+QString GattDatabase::cacheFileName(const QString &address)
+{
+    QString name = address.toUpper();
+    name.replace(QLatin1Char(':'), QLatin1Char('_'));
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1String("/bluezqt/gatt/") + name;
+}
+
+} // namespace BluezQt
@@ -0,0 +1,184 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#ifndef BLUEZQT_GATTDATABASE_H
+#define BLUEZQT_GATTDATABASE_H
+
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+
+#include "bluezqt_export.h"
+#include "uuid.h"
+
+namespace BluezQt
+{
+/**
+ * @class BluezQt::GattDatabase gattdatabase.h <BluezQt/GattDatabase>
+ *
+ * Snapshot of remote GATT database.
+ *
+ * This class represents the attribute layout (services, characteristics
+ * and descriptors with their handles and UUIDs) of a remote device,
+ * collected in one pass once the device's services are resolved.
+ *
+ * The layout can be saved to a cache file keyed by device address and
+ * loaded again later, for example to check with hash() whether the
+ * database of a known device has changed. The cache is only saved and
+ * loaded on request of the application.
+ *
+ * @see Device::gattDatabase()
+ */
+class BLUEZQT_EXPORT GattDatabase
+{
+public:
+    /**
+     * Single attribute in the database.
+     */
+    struct Attribute {
+        /** Attribute type. */
+        enum Type {
+            /** Service declaration. */
+            Service,
+            /** Characteristic declaration. */
+            Characteristic,
+            /** Characteristic descriptor. */
+            Descriptor,
+        };
+
+        /** Type of the attribute. */
+        Type type = Service;
+        /** Attribute handle. */
+        quint16 handle = 0;
+        /** UUID of the attribute. */
+        Uuid uuid;
+        /** D-Bus object path of the attribute. */
+        QString path;
+        /** Characteristic or descriptor flags, primary state for services. */
+        QStringList flags;
+    };
+
+    /**
+     * Creates a new invalid GattDatabase object.
+     */
+    explicit GattDatabase();
+
+    /**
+     * Destroys a GattDatabase object.
+     */
+    virtual ~GattDatabase();
+
+    /**
+     * Copy constructor.
+     *
+     * @param other
+     */
+    GattDatabase(const GattDatabase &other);
+
+    /**
+     * Copy assignment operator.
+     *
+     * @param other
+     */
+    GattDatabase &operator=(const GattDatabase &other);
+
+    /**
+     * Returns whether the database is valid.
+     *
+     * @return true if database is valid
+     */
+    bool isValid() const;
+
+    /**
+     * Returns an address of the device.
+     *
+     * @return address of device
+     */
+    QString address() const;
+
+    /**
+     * Returns a hash of the database.
+     *
+     * This is the value of Database Hash characteristic (0x2B2A) when
+     * the device exposes it and its value is known, otherwise it is
+     * computed from the attribute handles and UUIDs.
+     *
+     * @return database hash
+     */
+    QByteArray hash() const;
+
+    /**
+     * Returns all attributes of the database.
+     *
+     * Attributes are ordered by handle, so each service is followed by
+     * its characteristics, each followed by its descriptors.
+     *
+     * @return list of attributes
+     */
+    QVector<Attribute> attributes() const;
+
+    /**
+     * Returns number of services in the database.
+     *
+     * @return number of services
+     */
+    int servicesCount() const;
+
+    /**
+     * Saves the database to file.
+     *
+     * @param fileName file name
+     * @return true if database was saved
+     */
+    bool save(const QString &fileName) const;
+
+    /**
+     * Saves the database to cache file of the device.
+     *
+     * @return true if database was saved
+     * @see cacheFileName()
+     */
+    bool saveCache() const;
+
+    /**
+     * Loads a database from file.
+     *
+     * @param fileName file name
+     * @return loaded database, invalid on error
+     */
+    static GattDatabase load(const QString &fileName);
+
+    /**
+     * Loads a database from cache file of the device.
+     *
+     * If hash is not empty, the cached database is only returned
+     * when its hash matches.
+     *
+     * @param address address of device
+     * @param hash expected database hash
+     * @return cached database, invalid if there is no matching cache
+     */
+    static GattDatabase loadCache(const QString &address, const QByteArray &hash = QByteArray());
+
+    /**
+     * Returns a cache file name for device.
+     *
+     * @param address address of device
+     * @return cache file name
+     */
+    static QString cacheFileName(const QString &address);
+
+private:
+    QSharedPointer<class GattDatabasePrivate> d;
+
+    friend class DevicePrivate;
+};
+
+} // namespace BluezQt
+
+Q_DECLARE_METATYPE(BluezQt::GattDatabase)
+
+#endif // BLUEZQT_GATTDATABASE_H
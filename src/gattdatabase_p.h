@@ -0,0 +1,27 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#ifndef BLUEZQT_GATTDATABASE_P_H
+#define BLUEZQT_GATTDATABASE_P_H
+
+#include "gattdatabase.h"
+
+namespace BluezQt
+{
+class GattDatabasePrivate
+{
+public:
+    static QByteArray layoutHash(const QVector<GattDatabase::Attribute> &attributes);
+
+    bool m_valid = false;
+    QString m_address;
+    QByteArray m_hash;
+    QVector<GattDatabase::Attribute> m_attributes;
+};
+
+} // namespace BluezQt
+
+#endif // BLUEZQT_GATTDATABASE_P_H
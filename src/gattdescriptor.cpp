@@ -0,0 +1,97 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "gattdescriptor.h"
+#include "gattcharacteristic.h"
+#include "gattdescriptor_p.h"
+
+#include <QtEndian>
+
+namespace BluezQt
+{
+GattDescriptor::GattDescriptor(const QString &uuid, GattCharacteristic *characteristic)
+    : QObject(characteristic)
+    , d(new GattDescriptorPrivate(uuid, characteristic))
+{
+}
+
+GattDescriptor::~GattDescriptor()
+{
+    delete d;
+}
+
+GattDescriptor *GattDescriptor::createUserDescription(const QString &description, GattCharacteristic *characteristic)
+{
+    GattDescriptor *descriptor = new GattDescriptor(QStringLiteral("00002901-0000-1000-8000-00805f9b34fb"), characteristic);
+    descriptor->d->m_value = description.toUtf8();
+    return descriptor;
+}
+
+GattDescriptor *GattDescriptor::createClientCharacteristicConfiguration(GattCharacteristic *characteristic)
+{
+    GattDescriptor *descriptor = new GattDescriptor(QStringLiteral("00002902-0000-1000-8000-00805f9b34fb"), characteristic);
+    descriptor->d->m_value = QByteArray(2, 0);
+    descriptor->d->m_flags = QStringList{QStringLiteral("read"), QStringLiteral("write")};
+    return descriptor;
+}
+
+GattDescriptor *GattDescriptor::createPresentationFormat(quint8 format,
+                                                         qint8 exponent,
+                                                         quint16 unit,
+                                                         quint8 nameSpace,
+                                                         quint16 description,
+                                                         GattCharacteristic *characteristic)
+{
+    // Multi-byte fields are little endian
+    QByteArray value(7, Qt::Uninitialized);
+    value[0] = char(format);
+    value[1] = char(exponent);
+    qToLittleEndian<quint16>(unit, value.data() + 2);
+    value[4] = char(nameSpace);
+    qToLittleEndian<quint16>(description, value.data() + 5);
+
+    GattDescriptor *descriptor = new GattDescriptor(QStringLiteral("00002904-0000-1000-8000-00805f9b34fb"), characteristic);
+    descriptor->d->m_value = value;
+    return descriptor;
+}
+
+QByteArray GattDescriptor::readValue()
+{
+    return d->m_value;
+}
+
+void GattDescriptor::writeValue(const QByteArray &value)
+{
+    d->m_value = value;
+    Q_EMIT valueWritten(d->m_value);
+}
+
+QString GattDescriptor::uuid() const
+{
+    return d->m_uuid;
+}
+
+QStringList GattDescriptor::flags() const
+{
+    return d->m_flags;
+}
+
+void GattDescriptor::setFlags(const QStringList &flags)
+{
+    d->m_flags = flags;
+}
+
+const GattCharacteristic *GattDescriptor::characteristic() const
+{
+    return d->m_characteristic;
+}
+
+QDBusObjectPath GattDescriptor::objectPath() const
+{
+    return d->m_objectPath;
+}
+
+} // namespace BluezQt
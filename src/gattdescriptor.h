@@ -0,0 +1,151 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "bluezqt_export.h"
+
+#include <QDBusObjectPath>
+#include <QStringList>
+
+namespace BluezQt
+{
+class GattCharacteristic;
+
+/**
+ * @class BluezQt::GattDescriptor GattDescriptor.h <BluezQt/GattDescriptor>
+ *
+ * Bluetooth GattDescriptor.
+ *
+ * This class represents a Bluetooth GATT descriptor of a local GattCharacteristic.
+ *
+ * Object path: [variable prefix]/appXX/serviceYY/charZZ/descWW
+ */
+class BLUEZQT_EXPORT GattDescriptor : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Creates a new GattDescriptor object.
+     *
+     * @param uuid 128-bit descriptor UUID
+     * @param characteristic characteristic the descriptor belongs to
+     */
+    explicit GattDescriptor(const QString &uuid, GattCharacteristic *characteristic);
+
+    /**
+     * Destroys a GattDescriptor object.
+     */
+    ~GattDescriptor() override;
+
+    /**
+     * Creates a Characteristic User Description descriptor (0x2901).
+     *
+     * @param description user readable description of the characteristic
+     * @param characteristic characteristic the descriptor belongs to
+     * @return new descriptor
+     */
+    static GattDescriptor *createUserDescription(const QString &description, GattCharacteristic *characteristic);
+
+    /**
+     * Creates a Client Characteristic Configuration descriptor (0x2902).
+     *
+     * @note BlueZ adds this descriptor automatically to characteristics with
+     *       "notify" or "indicate" flags, it is only needed for custom handling.
+     *
+     * @param characteristic characteristic the descriptor belongs to
+     * @return new descriptor
+     */
+    static GattDescriptor *createClientCharacteristicConfiguration(GattCharacteristic *characteristic);
+
+    /**
+     * Creates a Characteristic Presentation Format descriptor (0x2904).
+     *
+     * @param format format of the value (see Bluetooth Assigned Numbers)
+     * @param exponent exponent of the value
+     * @param unit unit of the value (see Bluetooth Assigned Numbers)
+     * @param nameSpace name space of the description
+     * @param description description of the value
+     * @param characteristic characteristic the descriptor belongs to
+     * @return new descriptor
+     */
+    static GattDescriptor *createPresentationFormat(quint8 format,
+                                                    qint8 exponent,
+                                                    quint16 unit,
+                                                    quint8 nameSpace,
+                                                    quint16 description,
+                                                    GattCharacteristic *characteristic);
+
+    /**
+     * Reads the value of the descriptor.
+     */
+    QByteArray readValue();
+
+    /**
+     * Writes the value of the descriptor.
+     */
+    void writeValue(const QByteArray &value);
+
+    /**
+     * 128-bit GATT descriptor UUID.
+     *
+     * @return uuid of descriptor
+     */
+    QString uuid() const;
+
+    /**
+     * Flags defining how the descriptor value can be used.
+     *
+     * Default flag is "read".
+     *
+     * @return flags of descriptor
+     */
+    QStringList flags() const;
+
+    /**
+     * Sets flags of the descriptor.
+     *
+     * Flags must be set before the application is registered.
+     *
+     * @param flags flags of descriptor
+     */
+    void setFlags(const QStringList &flags);
+
+    /**
+     * The GATT characteristic the descriptor belongs to.
+     *
+     * @return characteristic this descriptor belongs to
+     */
+    const GattCharacteristic *characteristic() const;
+
+Q_SIGNALS:
+    /**
+     * Indicates that a value was written.
+     */
+    void valueWritten(const QByteArray &value);
+
+protected:
+    /**
+     * D-Bus object path of the GattDescriptor.
+     *
+     * The path where the GattDescriptor will be registered.
+     *
+     * @note You must provide valid object path!
+     *
+     * @return object path of GattDescriptor
+     */
+    virtual QDBusObjectPath objectPath() const;
+
+private:
+    class GattDescriptorPrivate *const d;
+
+    friend class GattApplicationPrivate;
+    friend class GattDescriptorAdaptor;
+    friend class GattManager;
+};
+
+} // namespace BluezQt
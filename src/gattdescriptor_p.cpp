@@ -0,0 +1,21 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "gattdescriptor_p.h"
+#include "gattcharacteristic.h"
+
+namespace BluezQt
+{
+GattDescriptorPrivate::GattDescriptorPrivate(const QString &uuid, const GattCharacteristic *characteristic)
+    : m_uuid(uuid)
+    , m_characteristic(characteristic)
+    , m_flags({QStringLiteral("read")})
+{
+    static uint8_t descNumber = 0;
+    m_objectPath.setPath(m_characteristic->objectPath().path() + QStringLiteral("/desc") + QString::number(descNumber++));
+}
+
+} // namespace BluezQt
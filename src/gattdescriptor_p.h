@@ -0,0 +1,25 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "gattdescriptor.h"
+
+namespace BluezQt
+{
+class GattDescriptorPrivate
+{
+public:
+    GattDescriptorPrivate(const QString &uuid, const GattCharacteristic *characteristic);
+
+    QString m_uuid;
+    const GattCharacteristic *m_characteristic;
+    QDBusObjectPath m_objectPath;
+    QByteArray m_value;
+    QStringList m_flags;
+};
+
+} // namespace BluezQt
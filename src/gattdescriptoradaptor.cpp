@@ -0,0 +1,49 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "gattdescriptoradaptor.h"
+#include "gattcharacteristic.h"
+#include "gattdescriptor.h"
+
+namespace BluezQt
+{
+GattDescriptorAdaptor::GattDescriptorAdaptor(GattDescriptor *parent)
+    : QDBusAbstractAdaptor(parent)
+    , m_gattDescriptor(parent)
+{
+}
+
+QString GattDescriptorAdaptor::uuid() const
+{
+    return m_gattDescriptor->uuid();
+}
+
+QDBusObjectPath GattDescriptorAdaptor::characteristic() const
+{
+    return m_gattDescriptor->characteristic()->objectPath();
+}
+
+QByteArray GattDescriptorAdaptor::value() const
+{
+    return m_gattDescriptor->readValue();
+}
+
+QStringList GattDescriptorAdaptor::flags() const
+{
+    return m_gattDescriptor->flags();
+}
+
+QByteArray GattDescriptorAdaptor::ReadValue(const QVariantMap & /*options*/)
+{
+    return m_gattDescriptor->readValue();
+}
+
+void GattDescriptorAdaptor::WriteValue(const QByteArray &value, const QVariantMap & /*options*/)
+{
+    m_gattDescriptor->writeValue(value);
+}
+
+} // namespace BluezQt
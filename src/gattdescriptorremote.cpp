@@ -30,7 +30,7 @@ GattDescriptorRemotePtr GattDescriptorRemote::toSharedPtr() const
 
 QString GattDescriptorRemote::ubi() const
 {
-    return d->m_bluezGattDescriptor->path();
+    return d->m_path;
 }
 
 QString GattDescriptorRemote::uuid() const
@@ -38,6 +38,11 @@ QString GattDescriptorRemote::uuid() const
     return d->m_uuid;
 }
 
+Uuid GattDescriptorRemote::uuidValue() const
+{
+    return d->m_uuidValue;
+}
+
 QByteArray GattDescriptorRemote::value() const
 {
     return d->m_value;
@@ -65,12 +70,12 @@ GattCharacteristicRemotePtr GattDescriptorRemote::characteristic() const
 
 PendingCall *GattDescriptorRemote::readValue(const QVariantMap &options)
 {
-    return new PendingCall(d->m_bluezGattDescriptor->ReadValue(options), PendingCall::ReturnByteArray, this);
+    return new PendingCall(d->bluezGattDescriptor()->ReadValue(options), PendingCall::ReturnByteArray, this);
 }
 
 PendingCall *GattDescriptorRemote::writeValue(const QByteArray &value, const QVariantMap &options)
 {
-    return new PendingCall(d->m_bluezGattDescriptor->WriteValue(value,options), PendingCall::ReturnVoid, this);
+    return new PendingCall(d->bluezGattDescriptor()->WriteValue(value,options), PendingCall::ReturnVoid, this);
 }
 
 }  // namespace BluezQt
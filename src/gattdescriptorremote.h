@@ -13,6 +13,7 @@
 #include <QMap>
 
 #include "types.h"
+#include "uuid.h"
 #include "bluezqt_export.h"
 
 namespace BluezQt
@@ -68,6 +69,13 @@ public:
      */
     QString uuid() const;
 
+    /**
+     * Returns an uuid of the descriptor as value that is compared as integers.
+     *
+     * @return uuid of the descriptor
+     */
+    Uuid uuidValue() const;
+
     /**
      * Returns an value of the descriptor.
      *
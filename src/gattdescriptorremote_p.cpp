@@ -23,30 +23,44 @@ namespace BluezQt
 
 GattDescriptorRemotePrivate::GattDescriptorRemotePrivate(const QString &path, const QVariantMap &properties, const GattCharacteristicRemotePtr &characteristic)
     : QObject()
+    , m_path(path)
+    , m_bluezGattDescriptor(nullptr)
     , m_dbusProperties(nullptr)
     , m_handle()
     , m_characteristic(characteristic)
 {
-    m_bluezGattDescriptor = new BluezGattDescriptor(Strings::orgBluez(), path, DBusConnection::orgBluez(), this);
-
     init(properties);
 }
 
 void GattDescriptorRemotePrivate::init(const QVariantMap &properties)
 {
-    m_dbusProperties = new DBusProperties(Strings::orgBluez(), m_bluezGattDescriptor->path(),
-                                          DBusConnection::orgBluez(), this);
-
     // Init properties
     m_uuid = properties.value(QStringLiteral("UUID")).toString();
+    m_uuidValue = Uuid(m_uuid);
     m_value = properties.value(QStringLiteral("Value")).toByteArray();
     m_flags = properties.value(QStringLiteral("Flags")).toStringList();
     m_handle = properties.value(QStringLiteral("Handle")).value<quint16>();
 }
 
+BluezGattDescriptor *GattDescriptorRemotePrivate::bluezGattDescriptor()
+{
+    if (!m_bluezGattDescriptor) {
+        m_bluezGattDescriptor = new BluezGattDescriptor(Strings::orgBluez(), m_path, DBusConnection::orgBluez(), this);
+    }
+    return m_bluezGattDescriptor;
+}
+
+DBusProperties *GattDescriptorRemotePrivate::dbusProperties()
+{
+    if (!m_dbusProperties) {
+        m_dbusProperties = new DBusProperties(Strings::orgBluez(), m_path, DBusConnection::orgBluez(), this);
+    }
+    return m_dbusProperties;
+}
+
 QDBusPendingReply<> GattDescriptorRemotePrivate::setDBusProperty(const QString &name, const QVariant &value)
 {
-    return m_dbusProperties->Set(Strings::orgBluezGattDescriptor1(), name, QDBusVariant(value));
+    return dbusProperties()->Set(Strings::orgBluezGattDescriptor1(), name, QDBusVariant(value));
 }
 
 void GattDescriptorRemotePrivate::propertiesChanged(const QString &path, const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
@@ -63,6 +77,7 @@ void GattDescriptorRemotePrivate::propertiesChanged(const QString &path, const Q
         const QString &property = i.key();
 
         if (property == QLatin1String("UUID")) {
+            m_uuidValue = Uuid(value.toString());
             PROPERTY_CHANGED(m_uuid, toString, uuidChanged);
         } else if (property == QLatin1String("Value")) {
             PROPERTY_CHANGED(m_value, toByteArray, valueChanged);
@@ -75,6 +90,7 @@ void GattDescriptorRemotePrivate::propertiesChanged(const QString &path, const Q
 
     for (auto& property : invalidated) {
         if (property == QLatin1String("UUID")) {
+            m_uuidValue = Uuid();
             PROPERTY_INVALIDATED(m_uuid, QString(), uuidChanged);
         } else if (property == QLatin1String("Value")) {
             PROPERTY_INVALIDATED(m_value, QByteArray(), valueChanged);
@@ -13,6 +13,7 @@
 #include <QMap>
 
 #include "types.h"
+#include "uuid.h"
 #include "bluezgattdescriptor1.h"
 #include "dbusproperties.h"
 #include "bluezqt_dbustypes.h"
@@ -33,14 +34,19 @@ public:
 
     void init(const QVariantMap &properties);
 
+    BluezGattDescriptor *bluezGattDescriptor();
+    DBusProperties *dbusProperties();
+
     QDBusPendingReply<> setDBusProperty(const QString &name, const QVariant &value);
     void propertiesChanged(const QString &path, const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
 
     QWeakPointer<GattDescriptorRemote> q;
+    QString m_path;
     BluezGattDescriptor *m_bluezGattDescriptor;
     DBusProperties *m_dbusProperties;
 
     QString m_uuid;
+    Uuid m_uuidValue;
     QByteArray m_value;
     QStringList m_flags;
     quint16 m_handle;
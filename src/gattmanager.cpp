@@ -10,8 +10,11 @@
 
 #include "debug.h"
 #include "gattapplication.h"
+#include "gattapplication_p.h"
 #include "gattcharacteristic.h"
 #include "gattcharacteristicadaptor.h"
+#include "gattdescriptor.h"
+#include "gattdescriptoradaptor.h"
 #include "gattmanager_p.h"
 #include "gattservice.h"
 #include "gattserviceadaptor.h"
@@ -48,6 +51,14 @@ PendingCall *GattManager::registerApplication(GattApplication *application)
             if (!DBusConnection::orgBluez().registerObject(charc->objectPath().path(), charc, QDBusConnection::ExportAdaptors)) {
                 qCDebug(BLUEZQT) << "Cannot register object" << charc->objectPath().path();
             }
+
+            const auto descriptors = charc->findChildren<GattDescriptor *>();
+            for (auto descriptor : descriptors) {
+                new GattDescriptorAdaptor(descriptor);
+                if (!DBusConnection::orgBluez().registerObject(descriptor->objectPath().path(), descriptor, QDBusConnection::ExportAdaptors)) {
+                    qCDebug(BLUEZQT) << "Cannot register object" << descriptor->objectPath().path();
+                }
+            }
         }
 
         if (!DBusConnection::orgBluez().registerObject(service->objectPath().path(), service, QDBusConnection::ExportAdaptors)) {
@@ -56,6 +67,7 @@ PendingCall *GattManager::registerApplication(GattApplication *application)
     }
 
     new ObjectManagerAdaptor(application);
+    application->d->invalidateManagedObjects();
 
     if (!DBusConnection::orgBluez().registerObject(application->objectPath().path(), application, QDBusConnection::ExportAdaptors)) {
         qCDebug(BLUEZQT) << "Cannot register object" << application->objectPath().path();
@@ -0,0 +1,174 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "gattreadjob.h"
+#include "gattreadjob_p.h"
+#include "debug.h"
+#include "gattcharacteristicremote.h"
+#include "utils.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+
+namespace BluezQt
+{
+GattReadJobReceiver::GattReadJobReceiver(GattReadJobPrivate *job)
+    : QObject(job)
+    , m_job(job)
+    , m_index(-1)
+{
+}
+
+void GattReadJobReceiver::readFinished(const QByteArray &value)
+{
+    m_job->readFinished(this, value);
+}
+
+void GattReadJobReceiver::readError(const QDBusError &error)
+{
+    m_job->readError(this, error.message());
+}
+
+GattReadJobPrivate::GattReadJobPrivate(GattReadJob *q, const QList<GattCharacteristicRemotePtr> &characteristics, const QVariantMap &options)
+    : QObject(q)
+    , q(q)
+    , m_characteristics(characteristics)
+    , m_options(options)
+    , m_maxInFlight(4)
+    , m_next(0)
+    , m_inFlight(0)
+{
+}
+
+void GattReadJobPrivate::doStart()
+{
+    // One receiver per read in flight instead of a watcher per read
+    const int count = qMin(m_maxInFlight, m_characteristics.size());
+    m_receivers.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        m_receivers.append(new GattReadJobReceiver(this));
+    }
+
+    for (GattReadJobReceiver *receiver : std::as_const(m_receivers)) {
+        if (!sendRead(receiver)) {
+            return;
+        }
+    }
+
+    if (m_inFlight == 0) {
+        q->emitResult();
+    }
+}
+
+bool GattReadJobPrivate::sendRead(GattReadJobReceiver *receiver)
+{
+    if (m_next >= m_characteristics.size()) {
+        return true;
+    }
+
+    receiver->m_index = m_next++;
+
+    QDBusMessage call = QDBusMessage::createMethodCall(Strings::orgBluez(),
+                                                       m_characteristics.at(receiver->m_index)->ubi(),
+                                                       Strings::orgBluezGattCharacteristic1(),
+                                                       QStringLiteral("ReadValue"));
+    call << m_options;
+
+    if (!DBusConnection::orgBluez().callWithCallback(call, receiver, SLOT(readFinished(QByteArray)), SLOT(readError(QDBusError)))) {
+        qCWarning(BLUEZQT) << "GattReadJob Error: Cannot send ReadValue call.";
+
+        q->setError(GattReadJob::UserDefinedError);
+        q->setErrorText(QStringLiteral("Cannot send ReadValue call."));
+        q->emitResult();
+        return false;
+    }
+
+    ++m_inFlight;
+    return true;
+}
+
+void GattReadJobPrivate::readFinished(GattReadJobReceiver *receiver, const QByteArray &value)
+{
+    if (!q->isRunning()) {
+        return;
+    }
+
+    m_values.insert(m_characteristics.at(receiver->m_index)->uuidValue(), value);
+    --m_inFlight;
+
+    if (sendRead(receiver) && m_inFlight == 0) {
+        q->emitResult();
+    }
+}
+
+void GattReadJobPrivate::readError(GattReadJobReceiver *receiver, const QString &errorText)
+{
+    if (!q->isRunning()) {
+        return;
+    }
+
+    m_errors.insert(m_characteristics.at(receiver->m_index)->uuidValue(), errorText);
+    --m_inFlight;
+
+    if (sendRead(receiver) && m_inFlight == 0) {
+        q->emitResult();
+    }
+}
+
+GattReadJob::GattReadJob(const QList<GattCharacteristicRemotePtr> &characteristics, const QVariantMap &options, QObject *parent)
+    : Job(parent)
+    , d(new GattReadJobPrivate(this, characteristics, options))
+{
+}
+
+GattReadJob::~GattReadJob()
+{
+    if (isRunning()) {
+        qCWarning(BLUEZQT) << "GattReadJob Error: Job was deleted before finished!";
+
+        setError(UserDefinedError);
+        setErrorText(QStringLiteral("Job was deleted before finished."));
+        emitResult();
+    }
+    delete d;
+}
+
+int GattReadJob::maxInFlight() const
+{
+    return d->m_maxInFlight;
+}
+
+void GattReadJob::setMaxInFlight(int count)
+{
+    d->m_maxInFlight = qMax(1, count);
+}
+
+QList<GattCharacteristicRemotePtr> GattReadJob::characteristics() const
+{
+    return d->m_characteristics;
+}
+
+QHash<Uuid, QByteArray> GattReadJob::values() const
+{
+    return d->m_values;
+}
+
+QHash<Uuid, QString> GattReadJob::errors() const
+{
+    return d->m_errors;
+}
+
+void GattReadJob::doStart()
+{
+    d->doStart();
+}
+
+void GattReadJob::doEmitResult()
+{
+    Q_EMIT result(this);
+}
+
+} // namespace BluezQt
@@ -0,0 +1,107 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#ifndef BLUEZQT_GATTREADJOB_H
+#define BLUEZQT_GATTREADJOB_H
+
+#include <QHash>
+
+#include "bluezqt_export.h"
+#include "job.h"
+#include "types.h"
+#include "uuid.h"
+
+namespace BluezQt
+{
+/**
+ * @class BluezQt::GattReadJob gattreadjob.h <BluezQt/GattReadJob>
+ *
+ * GATT batch read job.
+ *
+ * This class represents a job that reads values of several remote GATT
+ * characteristics. Reads are dispatched concurrently with up to maxInFlight()
+ * reads pending at once, and results are collected into one map of UUIDs
+ * to values or errors.
+ *
+ * The job itself only fails when the reads cannot be sent, failed reads of
+ * individual characteristics are reported in errors().
+ *
+ * The job must be started with start().
+ *
+ * @see Device::readCharacteristics()
+ */
+class BLUEZQT_EXPORT GattReadJob : public Job
+{
+    Q_OBJECT
+    Q_PROPERTY(int maxInFlight READ maxInFlight WRITE setMaxInFlight)
+
+public:
+    /**
+     * Destroys a GattReadJob object.
+     */
+    ~GattReadJob() override;
+
+    /**
+     * Returns the maximum number of reads in flight.
+     *
+     * @return maximum number of reads in flight
+     */
+    int maxInFlight() const;
+
+    /**
+     * Sets the maximum number of reads in flight.
+     *
+     * Must be set before the job is started. Default is 4.
+     *
+     * @param count maximum number of reads in flight
+     */
+    void setMaxInFlight(int count);
+
+    /**
+     * Returns characteristics read by the job.
+     *
+     * @return list of characteristics
+     */
+    QList<GattCharacteristicRemotePtr> characteristics() const;
+
+    /**
+     * Returns values of successfully read characteristics.
+     *
+     * If more characteristics share the same UUID, the value
+     * read last is kept.
+     *
+     * @return map of characteristic UUIDs to values
+     */
+    QHash<Uuid, QByteArray> values() const;
+
+    /**
+     * Returns errors of failed reads.
+     *
+     * @return map of characteristic UUIDs to error messages
+     */
+    QHash<Uuid, QString> errors() const;
+
+Q_SIGNALS:
+    /**
+     * Indicates that the job have finished.
+     */
+    void result(GattReadJob *job);
+
+private:
+    explicit GattReadJob(const QList<GattCharacteristicRemotePtr> &characteristics, const QVariantMap &options, QObject *parent);
+
+    void doStart() override;
+    void doEmitResult() override;
+
+    class GattReadJobPrivate *const d;
+
+    friend class GattReadJobPrivate;
+    friend class Device;
+};
+
+} // namespace BluezQt
+
+#endif // BLUEZQT_GATTREADJOB_H
@@ -0,0 +1,66 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#ifndef BLUEZQT_GATTREADJOB_P_H
+#define BLUEZQT_GATTREADJOB_P_H
+
+#include <QDBusError>
+#include <QHash>
+#include <QObject>
+#include <QVariantMap>
+#include <QVector>
+
+#include "types.h"
+#include "uuid.h"
+
+namespace BluezQt
+{
+class GattReadJob;
+class GattReadJobPrivate;
+
+// Receiver of one read in flight, reused for following reads
+class GattReadJobReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GattReadJobReceiver(GattReadJobPrivate *job);
+
+    GattReadJobPrivate *m_job;
+    int m_index;
+
+private Q_SLOTS:
+    void readFinished(const QByteArray &value);
+    void readError(const QDBusError &error);
+};
+
+class GattReadJobPrivate : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GattReadJobPrivate(GattReadJob *q, const QList<GattCharacteristicRemotePtr> &characteristics, const QVariantMap &options);
+
+    void doStart();
+    bool sendRead(GattReadJobReceiver *receiver);
+    void readFinished(GattReadJobReceiver *receiver, const QByteArray &value);
+    void readError(GattReadJobReceiver *receiver, const QString &errorText);
+
+    GattReadJob *q;
+    QList<GattCharacteristicRemotePtr> m_characteristics;
+    QVariantMap m_options;
+    int m_maxInFlight;
+    int m_next;
+    int m_inFlight;
+    QVector<GattReadJobReceiver *> m_receivers;
+
+    QHash<Uuid, QByteArray> m_values;
+    QHash<Uuid, QString> m_errors;
+};
+
+} // namespace BluezQt
+
+#endif // BLUEZQT_GATTREADJOB_P_H
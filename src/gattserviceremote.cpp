@@ -33,7 +33,7 @@ GattServiceRemotePtr GattServiceRemote::toSharedPtr() const
 
 QString GattServiceRemote::ubi() const
 {
-    return d->m_bluezGattService->path();
+    return d->m_path;
 }
 
 QString GattServiceRemote::uuid() const
@@ -41,6 +41,11 @@ QString GattServiceRemote::uuid() const
     return d->m_uuid;
 }
 
+Uuid GattServiceRemote::uuidValue() const
+{
+    return d->m_uuidValue;
+}
+
 bool GattServiceRemote::isPrimary() const
 {
     return d->m_primary;
@@ -71,4 +76,11 @@ QList<GattCharacteristicRemotePtr> GattServiceRemote::characteristics() const
     return d->m_characteristics;
 }
 
+GattCharacteristicRemotePtr GattServiceRemote::findCharacteristic(const Uuid &uuid) const
+{
+    d->m_device->d->ensureGattIndex();
+
+    return d->findCharacteristic(uuid);
+}
+
 } // namespace BluezQt
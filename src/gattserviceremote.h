@@ -14,6 +14,7 @@
 #include <QDBusObjectPath>
 
 #include "types.h"
+#include "uuid.h"
 #include "bluezqt_export.h"
 
 namespace BluezQt
@@ -69,6 +70,13 @@ public:
      */
     QString uuid() const;
 
+    /**
+     * Returns an uuid of the service as value that is compared as integers.
+     *
+     * @return uuid of the service
+     */
+    Uuid uuidValue() const;
+
     /**
      * Returns whether the service is primary.
      *
@@ -114,6 +122,17 @@ public:
      */
     QList<GattCharacteristicRemotePtr> characteristics() const;
 
+    /**
+     * Returns a characteristic with given UUID.
+     *
+     * If there are more characteristics with the same UUID,
+     * the one with the lowest handle is returned.
+     *
+     * @param uuid characteristic UUID
+     * @return null if there is no such characteristic
+     */
+    GattCharacteristicRemotePtr findCharacteristic(const Uuid &uuid) const;
+
 Q_SIGNALS:
     /**
      * Indicates that at least one of the service's properties have changed.
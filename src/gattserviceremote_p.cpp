@@ -25,23 +25,21 @@ namespace BluezQt
 
 GattServiceRemotePrivate::GattServiceRemotePrivate(const QString &path, const QVariantMap &properties, const DevicePtr &device)
     : QObject()
+    , m_path(path)
+    , m_bluezGattService(nullptr)
     , m_dbusProperties(nullptr)
     , m_primary(false)
     , m_device(device)
     , m_handle(0)
 {
-    m_bluezGattService = new BluezGattService(Strings::orgBluez(), path, DBusConnection::orgBluez(), this);
-
     init(properties);
 }
 
 void GattServiceRemotePrivate::init(const QVariantMap &properties)
 {
-    m_dbusProperties = new DBusProperties(Strings::orgBluez(), m_bluezGattService->path(),
-                                          DBusConnection::orgBluez(), this);
-
     // Init properties    
     m_uuid = properties.value(QStringLiteral("UUID")).toString();
+    m_uuidValue = Uuid(m_uuid);
     m_primary = properties.value(QStringLiteral("Primary")).toBool();
     m_includes = properties.value(QStringLiteral("Includes")).value<QList<QDBusObjectPath>>();
     m_handle = static_cast<quint16>(properties.value(QStringLiteral("Handle")).toUInt());
@@ -60,11 +58,9 @@ void GattServiceRemotePrivate::interfacesAdded(const QString &path, const QVaria
         }
     }
 
-    for (auto& ch: m_characteristics) {
-        if (path.startsWith(ch->ubi())) {
-            ch->d->interfacesAdded(path, interfaces);
-            changed = true;
-        }
+    if (GattCharacteristicRemotePtr ch = m_characteristicsByPath.value(childObjectPath(m_path, path))) {
+        ch->d->interfacesAdded(path, interfaces);
+        changed = true;
     }
 
     if (changed) {
@@ -84,11 +80,9 @@ void GattServiceRemotePrivate::interfacesRemoved(const QString &path, const QStr
         }
     }
 
-    for (auto& ch: m_characteristics) {
-        if (path.startsWith(ch->ubi())) {
-            ch->d->interfacesRemoved(path, interfaces);
-            changed = true;
-        }
+    if (GattCharacteristicRemotePtr ch = m_characteristicsByPath.value(childObjectPath(m_path, path))) {
+        ch->d->interfacesRemoved(path, interfaces);
+        changed = true;
     }
 
     if (changed) {
@@ -99,7 +93,7 @@ void GattServiceRemotePrivate::interfacesRemoved(const QString &path, const QStr
 void GattServiceRemotePrivate::addGattCharacteristic(const QString &gattCharacteristicPath, const QVariantMap &properties)
 {
     // Check if we have the right path
-    if (m_bluezGattService->path() != properties.value(QStringLiteral("Service")).value<QDBusObjectPath>().path()) {
+    if (m_path != properties.value(QStringLiteral("Service")).value<QDBusObjectPath>().path()) {
         return;
     }
 
@@ -112,6 +106,9 @@ void GattServiceRemotePrivate::addGattCharacteristic(const QString &gattCharacte
     GattCharacteristicRemotePtr gattCharacteristic = GattCharacteristicRemotePtr(new GattCharacteristicRemote(gattCharacteristicPath, properties, service));
     gattCharacteristic->d->q = gattCharacteristic.toWeakRef();
     m_characteristics.append(gattCharacteristic);
+    m_characteristicsByPath.insert(gattCharacteristicPath, gattCharacteristic);
+    m_characteristicsByUuid.insert(gattCharacteristic->uuidValue(), gattCharacteristic);
+    m_device->d->indexGattCharacteristic(gattCharacteristic);
 
     Q_EMIT service->gattCharacteristicAdded(gattCharacteristic);
     Q_EMIT service->characteristicsChanged(m_characteristics);
@@ -128,18 +125,14 @@ void GattServiceRemotePrivate::removeGattCharacteristic(const QString &gattChara
         return;
     }
 
-    GattCharacteristicRemotePtr gattCharacteristic = nullptr;
-    for (int i=0; i < service->characteristics().size(); ++i) {
-        if (service->characteristics().at(i)->ubi() == gattCharacteristicPath) {
-            gattCharacteristic = service->characteristics().at(i);
-        }
-    }
-
-    if (gattCharacteristic == nullptr) {
+    GattCharacteristicRemotePtr gattCharacteristic = m_characteristicsByPath.take(gattCharacteristicPath);
+    if (!gattCharacteristic) {
         return;
     }
 
     m_characteristics.removeOne(gattCharacteristic);
+    m_characteristicsByUuid.remove(gattCharacteristic->uuidValue(), gattCharacteristic);
+    m_device->d->unindexGattCharacteristic(gattCharacteristic);
 
     Q_EMIT service->gattCharacteristicRemoved(gattCharacteristic);
     Q_EMIT service->characteristicsChanged(m_characteristics);
@@ -148,20 +141,55 @@ void GattServiceRemotePrivate::removeGattCharacteristic(const QString &gattChara
     disconnect(gattCharacteristic.data(),&GattCharacteristicRemote::characteristicChanged,q.lock().data(),&GattServiceRemote::gattCharacteristicChanged);
 }
 
+void GattServiceRemotePrivate::rebuildCharacteristicsIndex()
+{
+    m_characteristicsByUuid.clear();
+    for (const GattCharacteristicRemotePtr &characteristic : std::as_const(m_characteristics)) {
+        m_characteristicsByUuid.insert(characteristic->uuidValue(), characteristic);
+    }
+}
+
+// Services may contain more characteristics with the same UUID,
+// return the first one in handle order in that case
+GattCharacteristicRemotePtr GattServiceRemotePrivate::findCharacteristic(const Uuid &uuid) const
+{
+    GattCharacteristicRemotePtr found;
+    for (auto it = m_characteristicsByUuid.constFind(uuid); it != m_characteristicsByUuid.constEnd() && it.key() == uuid; ++it) {
+        if (!found || it.value()->handle() < found->handle()) {
+            found = it.value();
+        }
+    }
+    return found;
+}
+
+BluezGattService *GattServiceRemotePrivate::bluezGattService()
+{
+    if (!m_bluezGattService) {
+        m_bluezGattService = new BluezGattService(Strings::orgBluez(), m_path, DBusConnection::orgBluez(), this);
+    }
+    return m_bluezGattService;
+}
+
+DBusProperties *GattServiceRemotePrivate::dbusProperties()
+{
+    if (!m_dbusProperties) {
+        m_dbusProperties = new DBusProperties(Strings::orgBluez(), m_path, DBusConnection::orgBluez(), this);
+    }
+    return m_dbusProperties;
+}
+
 QDBusPendingReply<> GattServiceRemotePrivate::setDBusProperty(const QString &name, const QVariant &value)
 {
-    return m_dbusProperties->Set(Strings::orgBluezGattService1(), name, QDBusVariant(value));
+    return dbusProperties()->Set(Strings::orgBluezGattService1(), name, QDBusVariant(value));
 }
 
 void GattServiceRemotePrivate::propertiesChanged(const QString &path, const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
 {
     if (interface == Strings::orgBluezGattCharacteristic1() || interface == Strings::orgBluezGattDescriptor1()) {
-        for (GattCharacteristicRemotePtr characteristic : m_characteristics) {
-            if (path.startsWith(characteristic->ubi())) {
-                characteristic->d->propertiesChanged(path, interface, changed, invalidated);
-                return;
-            }
+        if (GattCharacteristicRemotePtr characteristic = m_characteristicsByPath.value(childObjectPath(m_path, path))) {
+            characteristic->d->propertiesChanged(path, interface, changed, invalidated);
         }
+        return;
     } else if (interface != Strings::orgBluezGattService1()) {
         return;
     }
@@ -172,6 +200,7 @@ void GattServiceRemotePrivate::propertiesChanged(const QString &path, const QStr
         const QString &property = i.key();
 
         if (property == QLatin1String("UUID")) {
+            m_uuidValue = Uuid(value.toString());
             PROPERTY_CHANGED(m_uuid, toString, uuidChanged);
         } else if (property == QLatin1String("Primary")) {
             PROPERTY_CHANGED(m_primary, toBool, primaryChanged);
@@ -184,6 +213,7 @@ void GattServiceRemotePrivate::propertiesChanged(const QString &path, const QStr
 
     for (auto& property : invalidated) {
         if (property == QLatin1String("UUID")) {
+            m_uuidValue = Uuid();
             PROPERTY_INVALIDATED(m_uuid, QString(), uuidChanged);
         } else if (property == QLatin1String("Primary")) {
             PROPERTY_INVALIDATED(m_primary, false, primaryChanged);
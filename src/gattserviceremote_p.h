@@ -9,10 +9,12 @@
 #ifndef BLUEZQT_GATTSERVICE_P_H
 #define BLUEZQT_GATTSERVICE_P_H
 
+#include <QHash>
 #include <QObject>
 #include <QStringList>
 
 #include "types.h"
+#include "uuid.h"
 #include "bluezgattservice1.h"
 #include "dbusproperties.h"
 #include "bluezqt_dbustypes.h"
@@ -37,20 +39,29 @@ public:
 
     void addGattCharacteristic(const QString &gattCharacteristicPath, const QVariantMap &properties);
     void removeGattCharacteristic(const QString &gattCharacteristicPath);
+    void rebuildCharacteristicsIndex();
+    GattCharacteristicRemotePtr findCharacteristic(const Uuid &uuid) const;
+
+    BluezGattService *bluezGattService();
+    DBusProperties *dbusProperties();
 
     QDBusPendingReply<> setDBusProperty(const QString &name, const QVariant &value);
     void propertiesChanged(const QString &path, const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
 
     QWeakPointer<GattServiceRemote> q;
+    QString m_path;
     BluezGattService *m_bluezGattService;
     DBusProperties *m_dbusProperties;
 
     QString m_uuid;
+    Uuid m_uuidValue;
     bool m_primary;
     const DevicePtr m_device;
     QList<QDBusObjectPath> m_includes;
     quint16 m_handle;
     QList<GattCharacteristicRemotePtr> m_characteristics;
+    QHash<QString, GattCharacteristicRemotePtr> m_characteristicsByPath;
+    QMultiHash<Uuid, GattCharacteristicRemotePtr> m_characteristicsByUuid;
 };
 
 } // namespace BluezQt
@@ -0,0 +1,200 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "gattsocketdevice_p.h"
+
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <QSocketNotifier>
+
+namespace BluezQt
+{
+GattSocketDevice::GattSocketDevice(int fd, quint16 mtu, QObject *parent)
+    : QIODevice(parent)
+    , m_fd(fd)
+    , m_mtu(mtu)
+    , m_notifier(new QSocketNotifier(fd, QSocketNotifier::Read, this))
+    , m_writeNotifier(new QSocketNotifier(fd, QSocketNotifier::Write, this))
+    , m_pendingBytes(0)
+{
+    connect(m_notifier, &QSocketNotifier::activated, this, &GattSocketDevice::socketActivated);
+
+    m_writeNotifier->setEnabled(false);
+    connect(m_writeNotifier, &QSocketNotifier::activated, this, &GattSocketDevice::sendPendingPackets);
+}
+
+GattSocketDevice::~GattSocketDevice()
+{
+    close();
+}
+
+bool GattSocketDevice::isSequential() const
+{
+    return true;
+}
+
+qint64 GattSocketDevice::bytesAvailable() const
+{
+    int size = 0;
+#ifdef Q_OS_LINUX
+    if (m_fd >= 0 && ::ioctl(m_fd, FIONREAD, &size) < 0) {
+        size = 0;
+    }
+#endif
+    return QIODevice::bytesAvailable() + size;
+}
+
+qint64 GattSocketDevice::bytesToWrite() const
+{
+    return m_pendingBytes;
+}
+
+void GattSocketDevice::close()
+{
+    if (m_fd < 0) {
+        return;
+    }
+
+    QIODevice::close();
+
+    // Called from socketActivated() while the notifier is emitting
+    m_notifier->setEnabled(false);
+    m_notifier->deleteLater();
+    m_notifier = nullptr;
+    m_writeNotifier->setEnabled(false);
+    m_writeNotifier->deleteLater();
+    m_writeNotifier = nullptr;
+
+    m_pendingPackets.clear();
+    m_pendingBytes = 0;
+#ifdef Q_OS_LINUX
+    ::close(m_fd);
+#endif
+    m_fd = -1;
+}
+
+quint16 GattSocketDevice::mtu() const
+{
+    return m_mtu;
+}
+
+qint64 GattSocketDevice::readData(char *data, qint64 maxSize)
+{
+#ifdef Q_OS_LINUX
+    // Notifier is disabled until the pending packet is read
+    if (m_notifier) {
+        m_notifier->setEnabled(true);
+    }
+
+    const ssize_t size = ::recv(m_fd, data, maxSize, MSG_DONTWAIT);
+    if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return 0;
+    } else if (size == 0) {
+        QMetaObject::invokeMethod(this, &GattSocketDevice::socketActivated, Qt::QueuedConnection);
+        return -1;
+    }
+    return size;
+#else
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+    return -1;
+#endif
+}
+
+qint64 GattSocketDevice::writeData(const char *data, qint64 maxSize)
+{
+#ifdef Q_OS_LINUX
+    // Packet would be truncated by the other side, MTU includes the 3 byte ATT header
+    if (maxSize > m_mtu - 3) {
+        setErrorString(QStringLiteral("Packet does not fit into MTU"));
+        return -1;
+    }
+
+    // Keep the order of packets
+    if (m_pendingPackets.isEmpty()) {
+        const ssize_t size = ::send(m_fd, data, maxSize, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (size >= 0) {
+            return size;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            setErrorString(QString::fromLocal8Bit(::strerror(errno)));
+            return -1;
+        }
+    }
+
+    m_pendingPackets.enqueue(QByteArray(data, maxSize));
+    m_pendingBytes += maxSize;
+    m_writeNotifier->setEnabled(true);
+    return maxSize;
+#else
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+    return -1;
+#endif
+}
+
+void GattSocketDevice::sendPendingPackets()
+{
+#ifdef Q_OS_LINUX
+    qint64 written = 0;
+
+    while (!m_pendingPackets.isEmpty()) {
+        const QByteArray &packet = m_pendingPackets.head();
+        const ssize_t size = ::send(m_fd, packet.constData(), packet.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else if (size < 0) {
+            // Hangup is reported by socketActivated()
+            m_pendingPackets.clear();
+            m_pendingBytes = 0;
+            break;
+        }
+
+        written += packet.size();
+        m_pendingBytes -= packet.size();
+        m_pendingPackets.dequeue();
+    }
+
+    if (m_pendingPackets.isEmpty()) {
+        m_writeNotifier->setEnabled(false);
+    }
+    if (written > 0) {
+        Q_EMIT bytesWritten(written);
+    }
+#endif
+}
+
+void GattSocketDevice::socketActivated()
+{
+#ifdef Q_OS_LINUX
+    if (m_fd < 0) {
+        return;
+    }
+
+    // Zero length read means BlueZ closed its end of the socket
+    char buffer[64];
+    if (::recv(m_fd, buffer, 1, MSG_PEEK | MSG_DONTWAIT) == 0) {
+        close();
+        Q_EMIT hangup();
+        return;
+    }
+
+    if (openMode() & QIODevice::ReadOnly) {
+        m_notifier->setEnabled(false);
+        Q_EMIT readyRead();
+    } else {
+        // Nothing is expected on the notify socket, drop whatever was sent to it
+        while (::recv(m_fd, buffer, sizeof(buffer), MSG_DONTWAIT) > 0) { }
+    }
+#endif
+}
+
+} // namespace BluezQt
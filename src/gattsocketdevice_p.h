@@ -0,0 +1,58 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QIODevice>
+#include <QQueue>
+
+class QSocketNotifier;
+
+namespace BluezQt
+{
+/**
+ * QIODevice over one end of a SOCK_SEQPACKET socket handed to BlueZ
+ * with AcquireWrite or AcquireNotify.
+ *
+ * The device is unbuffered, each read returns one packet and each write
+ * sends one packet. Packets written while the socket is full are queued
+ * and sent once it becomes writable again.
+ */
+class GattSocketDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    explicit GattSocketDevice(int fd, quint16 mtu, QObject *parent = nullptr);
+    ~GattSocketDevice() override;
+
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+    qint64 bytesToWrite() const override;
+    void close() override;
+
+    quint16 mtu() const;
+
+Q_SIGNALS:
+    void hangup();
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    void socketActivated();
+    void sendPendingPackets();
+
+    int m_fd;
+    quint16 m_mtu;
+    QSocketNotifier *m_notifier;
+    QSocketNotifier *m_writeNotifier;
+    QQueue<QByteArray> m_pendingPackets;
+    qint64 m_pendingBytes;
+};
+
+} // namespace BluezQt
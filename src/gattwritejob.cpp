@@ -0,0 +1,242 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "gattwritejob.h"
+#include "gattwritejob_p.h"
+#include "debug.h"
+#include "gattcharacteristicremote.h"
+#include "utils.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QIODevice>
+
+namespace BluezQt
+{
+// ATT_MTU minimum and size of ATT write header
+static const int DEFAULT_ATT_MTU = 23;
+static const int ATT_WRITE_HEADER = 3;
+
+GattWriteJobPrivate::GattWriteJobPrivate(GattWriteJob *q, GattCharacteristicRemote *characteristic, const QVariantMap &options)
+    : QObject(q)
+    , q(q)
+    , m_path(characteristic->ubi())
+    , m_options(options)
+    , m_windowSize(8)
+    , m_valuePos(0)
+    , m_useDevice(false)
+    , m_deviceFinished(false)
+    , m_sourceFinished(false)
+    , m_bytesWritten(0)
+    , m_totalSize(-1)
+{
+    m_writeType = m_options.value(QStringLiteral("type")).toString();
+    if (m_writeType.isEmpty()) {
+        const bool command = characteristic->flags().contains(QLatin1String("write-without-response"));
+        m_writeType = command ? QStringLiteral("command") : QStringLiteral("request");
+        m_options.insert(QStringLiteral("type"), m_writeType);
+    }
+
+    m_chunkSize = qMax<int>(characteristic->MTU(), DEFAULT_ATT_MTU) - ATT_WRITE_HEADER;
+}
+
+void GattWriteJobPrivate::doStart()
+{
+    m_timer.start();
+    sendChunks();
+}
+
+void GattWriteJobPrivate::sendChunks()
+{
+    // Calls with callback don't need a QDBusPendingCallWatcher per write
+    while (!m_sourceFinished && m_inFlight.size() < m_windowSize) {
+        const QByteArray chunk = nextChunk();
+        if (!q->isRunning()) {
+            return;
+        }
+        if (chunk.isEmpty()) {
+            // Sequential devices may not have data buffered yet, wait for readyRead()
+            m_sourceFinished = atSourceEnd();
+            break;
+        }
+
+        QDBusMessage call = QDBusMessage::createMethodCall(Strings::orgBluez(),
+                                                           m_path,
+                                                           Strings::orgBluezGattCharacteristic1(),
+                                                           QStringLiteral("WriteValue"));
+        call << chunk << m_options;
+
+        if (!DBusConnection::orgBluez().callWithCallback(call, this, SLOT(writeFinished()), SLOT(writeError(QDBusError)))) {
+            fail(QStringLiteral("Cannot send WriteValue call."));
+            return;
+        }
+        m_inFlight.enqueue(chunk.size());
+    }
+
+    if (m_sourceFinished && m_inFlight.isEmpty()) {
+        q->emitResult();
+    }
+}
+
+QByteArray GattWriteJobPrivate::nextChunk()
+{
+    if (!m_useDevice) {
+        const QByteArray chunk = m_value.mid(m_valuePos, m_chunkSize);
+        m_valuePos += chunk.size();
+        return chunk;
+    }
+
+    if (!m_device) {
+        fail(QStringLiteral("Device was deleted."));
+        return QByteArray();
+    }
+
+    QByteArray chunk(m_chunkSize, Qt::Uninitialized);
+    const qint64 size = m_device->read(chunk.data(), chunk.size());
+    if (size < 0) {
+        fail(m_device->errorString());
+        return QByteArray();
+    }
+    chunk.resize(size);
+    return chunk;
+}
+
+bool GattWriteJobPrivate::atSourceEnd() const
+{
+    if (!m_useDevice) {
+        return m_valuePos >= m_value.size();
+    }
+    if (!m_device || !m_device->isOpen() || m_deviceFinished) {
+        return true;
+    }
+    return !m_device->isSequential() && m_device->atEnd();
+}
+
+void GattWriteJobPrivate::deviceReadyRead()
+{
+    // Not started yet
+    if (!m_timer.isValid() || !q->isRunning()) {
+        return;
+    }
+    sendChunks();
+}
+
+void GattWriteJobPrivate::deviceFinished()
+{
+    // Read channel finished or device is about to close, only buffered data is left
+    m_deviceFinished = true;
+    deviceReadyRead();
+}
+
+void GattWriteJobPrivate::fail(const QString &errorText)
+{
+    qCWarning(BLUEZQT) << "GattWriteJob Error:" << errorText;
+
+    q->setError(GattWriteJob::UserDefinedError);
+    q->setErrorText(errorText);
+    q->emitResult();
+}
+
+void GattWriteJobPrivate::writeFinished()
+{
+    if (!q->isRunning() || m_inFlight.isEmpty()) {
+        return;
+    }
+
+    m_bytesWritten += m_inFlight.dequeue();
+    Q_EMIT q->progress(m_bytesWritten, m_totalSize);
+    sendChunks();
+}
+
+void GattWriteJobPrivate::writeError(const QDBusError &error)
+{
+    if (!q->isRunning()) {
+        return;
+    }
+
+    fail(error.message());
+}
+
+GattWriteJob::GattWriteJob(GattCharacteristicRemote *characteristic, const QByteArray &value, const QVariantMap &options)
+    : Job(characteristic)
+    , d(new GattWriteJobPrivate(this, characteristic, options))
+{
+    d->m_value = value;
+    d->m_totalSize = value.size();
+}
+
+GattWriteJob::GattWriteJob(GattCharacteristicRemote *characteristic, QIODevice *device, const QVariantMap &options)
+    : Job(characteristic)
+    , d(new GattWriteJobPrivate(this, characteristic, options))
+{
+    d->m_device = device;
+    d->m_useDevice = true;
+    d->m_totalSize = device->isSequential() ? -1 : device->size() - device->pos();
+
+    connect(device, &QIODevice::readyRead, d, &GattWriteJobPrivate::deviceReadyRead);
+    connect(device, &QIODevice::readChannelFinished, d, &GattWriteJobPrivate::deviceFinished);
+    connect(device, &QIODevice::aboutToClose, d, &GattWriteJobPrivate::deviceFinished);
+}
+
+GattWriteJob::~GattWriteJob()
+{
+    if (isRunning()) {
+        qCWarning(BLUEZQT) << "GattWriteJob Error: Job was deleted before finished!";
+
+        setError(UserDefinedError);
+        setErrorText(QStringLiteral("Job was deleted before finished."));
+        emitResult();
+    }
+    delete d;
+}
+
+int GattWriteJob::windowSize() const
+{
+    return d->m_windowSize;
+}
+
+void GattWriteJob::setWindowSize(int size)
+{
+    d->m_windowSize = qMax(1, size);
+}
+
+int GattWriteJob::chunkSize() const
+{
+    return d->m_chunkSize;
+}
+
+QString GattWriteJob::writeType() const
+{
+    return d->m_writeType;
+}
+
+qint64 GattWriteJob::bytesWritten() const
+{
+    return d->m_bytesWritten;
+}
+
+qint64 GattWriteJob::totalSize() const
+{
+    return d->m_totalSize;
+}
+
+qint64 GattWriteJob::throughput() const
+{
+    const qint64 elapsed = d->m_timer.isValid() ? d->m_timer.elapsed() : 0;
+    return elapsed > 0 ? d->m_bytesWritten * 1000 / elapsed : 0;
+}
+
+void GattWriteJob::doStart()
+{
+    d->doStart();
+}
+
+void GattWriteJob::doEmitResult()
+{
+    Q_EMIT result(this);
+}
+
+} // namespace BluezQt
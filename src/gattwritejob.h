@@ -0,0 +1,124 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#ifndef BLUEZQT_GATTWRITEJOB_H
+#define BLUEZQT_GATTWRITEJOB_H
+
+#include "bluezqt_export.h"
+#include "job.h"
+
+class QIODevice;
+
+namespace BluezQt
+{
+class GattCharacteristicRemote;
+
+/**
+ * @class BluezQt::GattWriteJob gattwritejob.h <BluezQt/GattWriteJob>
+ *
+ * GATT write job.
+ *
+ * This class represents a job that writes a large value to the remote
+ * GATT characteristic. The value is split into chunks that fit into MTU
+ * and up to windowSize() writes are kept in flight at once, so the transfer
+ * is not limited by round-trip time of each write.
+ *
+ * Write without response (type "command") is used when the characteristic
+ * supports it, unless the type is set in options.
+ *
+ * The job must be started with start().
+ */
+class BLUEZQT_EXPORT GattWriteJob : public Job
+{
+    Q_OBJECT
+    Q_PROPERTY(qint64 bytesWritten READ bytesWritten NOTIFY progress)
+    Q_PROPERTY(qint64 totalSize READ totalSize)
+    Q_PROPERTY(qint64 throughput READ throughput NOTIFY progress)
+
+public:
+    /**
+     * Destroys a GattWriteJob object.
+     */
+    ~GattWriteJob() override;
+
+    /**
+     * Returns the maximum number of writes in flight.
+     *
+     * @return window size
+     */
+    int windowSize() const;
+
+    /**
+     * Sets the maximum number of writes in flight.
+     *
+     * Must be set before the job is started. Default is 8.
+     *
+     * @param size window size
+     */
+    void setWindowSize(int size);
+
+    /**
+     * Returns the size of a single write.
+     *
+     * @return chunk size in bytes
+     */
+    int chunkSize() const;
+
+    /**
+     * Returns the write type used for the chunks.
+     *
+     * @return "command" or "request"
+     */
+    QString writeType() const;
+
+    /**
+     * Returns the number of bytes acknowledged so far.
+     *
+     * @return bytes written
+     */
+    qint64 bytesWritten() const;
+
+    /**
+     * Returns the total number of bytes to write.
+     *
+     * @return total size or -1 if unknown (sequential devices)
+     */
+    qint64 totalSize() const;
+
+    /**
+     * Returns average throughput of the transfer.
+     *
+     * @return throughput in bytes per second
+     */
+    qint64 throughput() const;
+
+Q_SIGNALS:
+    /**
+     * Indicates that chunks were written.
+     */
+    void progress(qint64 bytesWritten, qint64 totalSize);
+
+    /**
+     * Indicates that the job have finished.
+     */
+    void result(GattWriteJob *job);
+
+private:
+    explicit GattWriteJob(GattCharacteristicRemote *characteristic, const QByteArray &value, const QVariantMap &options);
+    explicit GattWriteJob(GattCharacteristicRemote *characteristic, QIODevice *device, const QVariantMap &options);
+
+    void doStart() override;
+    void doEmitResult() override;
+
+    class GattWriteJobPrivate *const d;
+
+    friend class GattWriteJobPrivate;
+    friend class GattCharacteristicRemote;
+};
+
+} // namespace BluezQt
+
+#endif // BLUEZQT_GATTWRITEJOB_H
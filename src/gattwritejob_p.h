@@ -0,0 +1,65 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#ifndef BLUEZQT_GATTWRITEJOB_P_H
+#define BLUEZQT_GATTWRITEJOB_P_H
+
+#include <QDBusError>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QVariantMap>
+
+class QIODevice;
+
+namespace BluezQt
+{
+class GattCharacteristicRemote;
+class GattWriteJob;
+
+class GattWriteJobPrivate : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GattWriteJobPrivate(GattWriteJob *q, GattCharacteristicRemote *characteristic, const QVariantMap &options);
+
+    void doStart();
+    void sendChunks();
+    QByteArray nextChunk();
+    bool atSourceEnd() const;
+    void fail(const QString &errorText);
+
+    GattWriteJob *q;
+    QString m_path;
+    QVariantMap m_options;
+    QString m_writeType;
+    int m_chunkSize;
+    int m_windowSize;
+
+    QByteArray m_value;
+    int m_valuePos;
+    QPointer<QIODevice> m_device;
+    bool m_useDevice;
+    bool m_deviceFinished;
+
+    bool m_sourceFinished;
+    qint64 m_bytesWritten;
+    qint64 m_totalSize;
+    QQueue<int> m_inFlight;
+    QElapsedTimer m_timer;
+
+private Q_SLOTS:
+    void deviceReadyRead();
+    void deviceFinished();
+    void writeFinished();
+    void writeError(const QDBusError &error);
+};
+
+} // namespace BluezQt
+
+#endif // BLUEZQT_GATTWRITEJOB_P_H
@@ -17,7 +17,7 @@ static int devicesCountDeclarativeAdapterFunction(QQmlListProperty<DeclarativeDe
     Q_ASSERT(qobject_cast<DeclarativeAdapter *>(property->object));
     DeclarativeAdapter *adapter = static_cast<DeclarativeAdapter *>(property->object);
 
-    return adapter->m_devices.count();
+    return adapter->m_deviceList.count();
 }
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -29,7 +29,7 @@ static DeclarativeDevice *devicesAtDeclarativeAdapterFunction(QQmlListProperty<D
     Q_ASSERT(qobject_cast<DeclarativeAdapter *>(property->object));
     DeclarativeAdapter *adapter = static_cast<DeclarativeAdapter *>(property->object);
 
-    return adapter->m_devices.values().at(index);
+    return adapter->m_deviceList.at(index);
 }
 
 DeclarativeAdapter::DeclarativeAdapter(BluezQt::AdapterPtr adapter, QObject *parent)
@@ -73,6 +73,8 @@ public:
 
     BluezQt::AdapterPtr m_adapter;
     QHash<QString, DeclarativeDevice *> m_devices;
+    QList<DeclarativeDevice *> m_deviceList;
+    QHash<DeclarativeDevice *, qint64> m_deviceKeys;
 
 public Q_SLOTS:
     DeclarativeDevice *deviceForAddress(const QString &address) const;
@@ -12,6 +12,11 @@
 #include "declarativedevice.h"
 #include "device.h"
 #include "initmanagerjob.h"
+#include "orderedlist_p.h"
+
+using BluezQt::appendToList;
+using BluezQt::removeFromList;
+
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
 static qsizetype adaptersCountFunction(QQmlListProperty<DeclarativeAdapter> *property)
 #else
@@ -21,7 +26,7 @@ static int adaptersCountFunction(QQmlListProperty<DeclarativeAdapter> *property)
     Q_ASSERT(qobject_cast<DeclarativeManager *>(property->object));
     DeclarativeManager *manager = static_cast<DeclarativeManager *>(property->object);
 
-    return manager->m_adapters.count();
+    return manager->m_adapterList.count();
 }
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -33,7 +38,7 @@ static DeclarativeAdapter *adaptersAtFunction(QQmlListProperty<DeclarativeAdapte
     Q_ASSERT(qobject_cast<DeclarativeManager *>(property->object));
     DeclarativeManager *manager = static_cast<DeclarativeManager *>(property->object);
 
-    return manager->m_adapters.values().at(index);
+    return manager->m_adapterList.at(index);
 }
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -45,7 +50,7 @@ static int devicesCountFunction(QQmlListProperty<DeclarativeDevice> *property)
     Q_ASSERT(qobject_cast<DeclarativeManager *>(property->object));
     DeclarativeManager *manager = static_cast<DeclarativeManager *>(property->object);
 
-    return manager->m_devices.count();
+    return manager->m_deviceList.count();
 }
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -57,7 +62,7 @@ static DeclarativeDevice *devicesAtFunction(QQmlListProperty<DeclarativeDevice>
     Q_ASSERT(qobject_cast<DeclarativeManager *>(property->object));
     DeclarativeManager *manager = static_cast<DeclarativeManager *>(property->object);
 
-    return manager->m_devices.values().at(index);
+    return manager->m_deviceList.at(index);
 }
 
 DeclarativeManager::DeclarativeManager(QObject *parent)
@@ -147,6 +152,7 @@ void DeclarativeManager::slotAdapterAdded(BluezQt::AdapterPtr adapter)
 {
     DeclarativeAdapter *dAdapter = new DeclarativeAdapter(adapter, this);
     m_adapters[adapter->ubi()] = dAdapter;
+    appendToList(m_adapterList, m_adapterKeys, dAdapter);
 
     Q_EMIT adapterAdded(dAdapter);
     Q_EMIT adaptersChanged(declarativeAdapters());
@@ -155,6 +161,7 @@ void DeclarativeManager::slotAdapterAdded(BluezQt::AdapterPtr adapter)
 void DeclarativeManager::slotAdapterRemoved(BluezQt::AdapterPtr adapter)
 {
     DeclarativeAdapter *dAdapter = m_adapters.take(adapter->ubi());
+    removeFromList(m_adapterList, m_adapterKeys, dAdapter);
     dAdapter->deleteLater();
 
     Q_EMIT adapterRemoved(dAdapter);
@@ -166,7 +173,9 @@ void DeclarativeManager::slotDeviceAdded(BluezQt::DevicePtr device)
     DeclarativeAdapter *dAdapter = declarativeAdapterFromPtr(device->adapter());
     DeclarativeDevice *dDevice = new DeclarativeDevice(device, dAdapter);
     m_devices[device->ubi()] = dDevice;
+    appendToList(m_deviceList, m_deviceKeys, dDevice);
     dAdapter->m_devices[device->ubi()] = dDevice;
+    appendToList(dAdapter->m_deviceList, dAdapter->m_deviceKeys, dDevice);
 
     Q_EMIT deviceAdded(dDevice);
     Q_EMIT devicesChanged(declarativeDevices());
@@ -175,7 +184,9 @@ void DeclarativeManager::slotDeviceAdded(BluezQt::DevicePtr device)
 void DeclarativeManager::slotDeviceRemoved(BluezQt::DevicePtr device)
 {
     DeclarativeDevice *dDevice = m_devices.take(device->ubi());
+    removeFromList(m_deviceList, m_deviceKeys, dDevice);
     dDevice->adapter()->m_devices.take(device->ubi());
+    removeFromList(dDevice->adapter()->m_deviceList, dDevice->adapter()->m_deviceKeys, dDevice);
     dDevice->deleteLater();
 
     Q_EMIT deviceRemoved(dDevice);
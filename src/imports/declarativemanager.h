@@ -10,6 +10,7 @@
 #define DECLARATIVEMANAGER_H
 
 #include <QHash>
+#include <QList>
 #include <QQmlListProperty>
 
 #include "manager.h"
@@ -36,6 +37,10 @@ public:
 
     QHash<QString, DeclarativeAdapter *> m_adapters;
     QHash<QString, DeclarativeDevice *> m_devices;
+    QList<DeclarativeAdapter *> m_adapterList;
+    QList<DeclarativeDevice *> m_deviceList;
+    QHash<DeclarativeAdapter *, qint64> m_adapterKeys;
+    QHash<DeclarativeDevice *, qint64> m_deviceKeys;
 
 public Q_SLOTS:
     DeclarativeAdapter *adapterForAddress(const QString &address) const;
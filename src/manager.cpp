@@ -73,12 +73,26 @@ AdapterPtr Manager::usableAdapter() const
 
 QList<AdapterPtr> Manager::adapters() const
 {
-    return d->m_adapters.values();
+    return d->m_adapterList;
 }
 
 QList<DevicePtr> Manager::devices() const
 {
-    return d->m_devices.values();
+    return d->m_deviceList;
+}
+
+void Manager::forEachAdapter(const std::function<void(const AdapterPtr &)> &callback) const
+{
+    for (const AdapterPtr &adapter : std::as_const(d->m_adapterList)) {
+        callback(adapter);
+    }
+}
+
+void Manager::forEachDevice(const std::function<void(const DevicePtr &)> &callback) const
+{
+    for (const DevicePtr &device : std::as_const(d->m_deviceList)) {
+        callback(device);
+    }
 }
 
 PendingCall *Manager::startService()
@@ -239,4 +253,33 @@ Rfkill *Manager::rfkill() const
     return d->m_rfkill;
 }
 
+int Manager::propertiesChangedLatency() const
+{
+    return d->m_propertiesChangedTimer->interval();
+}
+
+void Manager::setPropertiesChangedLatency(int msec)
+{
+    d->m_propertiesChangedTimer->setInterval(qMax(0, msec));
+}
+
+quint64 Manager::mergedPropertiesChangedCount() const
+{
+    return d->m_mergedPropertiesChangedCount;
+}
+
+Device::UpdatePolicy Manager::deviceUpdatePolicy() const
+{
+    return d->m_deviceUpdatePolicy;
+}
+
+void Manager::setDeviceUpdatePolicy(const Device::UpdatePolicy &policy)
+{
+    d->m_deviceUpdatePolicy = policy;
+
+    for (const DevicePtr &device : std::as_const(d->m_devices)) {
+        device->setUpdatePolicy(policy);
+    }
+}
+
 } // namespace BluezQt
@@ -11,6 +11,8 @@
 
 #include <QObject>
 
+#include <functional>
+
 #include "adapter.h"
 #include "bluezqt_export.h"
 #include "media.h"
@@ -171,6 +173,9 @@ public:
     /**
      * Returns a list of all adapters.
      *
+     * Adapters are listed in the order they were added. The list is
+     * implicitly shared with the manager, so calling this is cheap.
+     *
      * @return list of adapters
      */
     QList<AdapterPtr> adapters() const;
@@ -178,10 +183,31 @@ public:
     /**
      * Returns a list of all devices.
      *
+     * Devices are listed in the order they were added. The list is
+     * implicitly shared with the manager, so calling this is cheap.
+     *
      * @return list of devices
      */
     QList<DevicePtr> devices() const;
 
+    /**
+     * Calls the callback for each adapter.
+     *
+     * Adapters must not be added or removed from the callback.
+     *
+     * @param callback function called with each adapter
+     */
+    void forEachAdapter(const std::function<void(const AdapterPtr &)> &callback) const;
+
+    /**
+     * Calls the callback for each device.
+     *
+     * Devices must not be added or removed from the callback.
+     *
+     * @param callback function called with each device
+     */
+    void forEachDevice(const std::function<void(const DevicePtr &)> &callback) const;
+
     /**
      * Attempts to start org.bluez service by D-Bus activation.
      *
@@ -297,6 +323,53 @@ public:
 
     Rfkill *rfkill() const;
 
+    /**
+     * Returns the maximum latency of property changes delivery.
+     *
+     * Property changes received from BlueZ are queued and delivered in one
+     * event loop pass. Consecutive changes of the same object and interface
+     * are merged together while queued.
+     *
+     * Default value is 0, which delivers the changes in the next event loop pass.
+     *
+     * @return maximum latency in milliseconds
+     */
+    int propertiesChangedLatency() const;
+
+    /**
+     * Sets the maximum latency of property changes delivery.
+     *
+     * Higher latency allows more property changes to be merged, at the cost
+     * of delayed change notifications.
+     *
+     * @param msec maximum latency in milliseconds
+     */
+    void setPropertiesChangedLatency(int msec);
+
+    /**
+     * Returns number of property change signals that were merged into
+     * already queued changes.
+     *
+     * @return number of merged signals
+     */
+    quint64 mergedPropertiesChangedCount() const;
+
+    /**
+     * Returns update policy applied to devices.
+     *
+     * @return update policy
+     */
+    Device::UpdatePolicy deviceUpdatePolicy() const;
+
+    /**
+     * Sets update policy of all known devices and devices added later.
+     *
+     * Policy of individual devices can be changed with Device::setUpdatePolicy().
+     *
+     * @param policy update policy
+     */
+    void setDeviceUpdatePolicy(const Device::UpdatePolicy &policy);
+
 Q_SIGNALS:
     /**
      * Indicates that operational state have changed.
@@ -13,6 +13,7 @@
 #include "device.h"
 #include "device_p.h"
 #include "manager.h"
+#include "orderedlist_p.h"
 #include "utils.h"
 
 #include <QDBusServiceWatcher>
@@ -29,6 +30,7 @@ ManagerPrivate::ManagerPrivate(Manager *parent)
     , m_bluezRunning(false)
     , m_loaded(false)
     , m_adaptersLoaded(false)
+    , m_mergedPropertiesChangedCount(0)
 {
     qDBusRegisterMetaType<DBusManagerStruct>();
     qDBusRegisterMetaType<QVariantMapMap>();
@@ -38,6 +40,12 @@ ManagerPrivate::ManagerPrivate(Manager *parent)
     connect(m_rfkill, &Rfkill::stateChanged, this, &ManagerPrivate::rfkillStateChanged);
 
     connect(q, &Manager::adapterRemoved, this, &ManagerPrivate::adapterRemoved);
+
+    // Property changes are queued and delivered in one event loop pass
+    m_propertiesChangedTimer = new QTimer(this);
+    m_propertiesChangedTimer->setSingleShot(true);
+    m_propertiesChangedTimer->setInterval(0);
+    connect(m_propertiesChangedTimer, &QTimer::timeout, this, &ManagerPrivate::flushPropertiesChanged);
 }
 
 void ManagerPrivate::init()
@@ -164,12 +172,15 @@ void ManagerPrivate::clear()
 {
     m_loaded = false;
 
-    // Delete all devices first
-    while (!m_devices.isEmpty()) {
-        DevicePtr device = m_devices.begin().value();
-        m_devices.remove(m_devices.begin().key());
+    // Delete all devices first, from the last one so that removals from the lists are cheap
+    while (!m_deviceList.isEmpty()) {
+        DevicePtr device = m_deviceList.takeLast();
+        m_devices.remove(device->ubi());
         device->adapter()->d->removeDevice(device);
     }
+    m_deviceKeys.clear();
+    m_adapterList.clear();
+    m_adapterKeys.clear();
 
     // Delete all adapters
     while (!m_adapters.isEmpty()) {
@@ -206,6 +217,21 @@ AdapterPtr ManagerPrivate::findUsableAdapter() const
     return AdapterPtr();
 }
 
+AdapterPtr ManagerPrivate::adapterForObjectPath(const QString &path) const
+{
+    // Object paths are resolved one segment at a time: /org/bluez/<adapter>/<device>/...
+    return m_adapters.value(childObjectPath(QStringLiteral("/org/bluez"), path));
+}
+
+DevicePtr ManagerPrivate::deviceForObjectPath(const QString &path) const
+{
+    const QString &adapterPath = childObjectPath(QStringLiteral("/org/bluez"), path);
+    if (adapterPath.isEmpty()) {
+        return DevicePtr();
+    }
+    return m_devices.value(childObjectPath(adapterPath, path));
+}
+
 void ManagerPrivate::serviceRegistered()
 {
     qCDebug(BLUEZQT) << "BlueZ service registered";
@@ -242,18 +268,12 @@ void ManagerPrivate::interfacesAdded(const QDBusObjectPath &objectPath, const QV
         }
     }
 
-    for (auto it = m_adapters.cbegin(); it != m_adapters.cend(); ++it) {
-        if (path.startsWith(it.value()->ubi())) {
-            it.value()->d->interfacesAdded(path, interfaces);
-            break;
-        }
+    if (AdapterPtr adapter = adapterForObjectPath(path)) {
+        adapter->d->interfacesAdded(path, interfaces);
     }
 
-    for (auto it = m_devices.cbegin(); it != m_devices.cend(); ++it) {
-        if (path.startsWith(it.value()->ubi())) {
-            it.value()->d->interfacesAdded(path, interfaces);
-            break;
-        }
+    if (DevicePtr device = deviceForObjectPath(path)) {
+        device->d->interfacesAdded(path, interfaces);
     }
 }
 
@@ -269,18 +289,12 @@ void ManagerPrivate::interfacesRemoved(const QDBusObjectPath &objectPath, const
         }
     }
 
-    for (auto it = m_adapters.cbegin(); it != m_adapters.cend(); ++it) {
-        if (path.startsWith(it.value()->ubi())) {
-            it.value()->d->interfacesRemoved(path, interfaces);
-            break;
-        }
+    if (AdapterPtr adapter = adapterForObjectPath(path)) {
+        adapter->d->interfacesRemoved(path, interfaces);
     }
 
-    for (auto it = m_devices.cbegin(); it != m_devices.cend(); ++it) {
-        if (path.startsWith(it.value()->ubi())) {
-            it.value()->d->interfacesRemoved(path, interfaces);
-            break;
-        }
+    if (DevicePtr device = deviceForObjectPath(path)) {
+        device->d->interfacesRemoved(path, interfaces);
     }
 }
 
@@ -331,6 +345,7 @@ void ManagerPrivate::addAdapter(const QString &adapterPath, const QVariantMap &p
     AdapterPtr adapter = AdapterPtr(new Adapter(adapterPath, properties));
     adapter->d->q = adapter.toWeakRef();
     m_adapters.insert(adapterPath, adapter);
+    appendToList(m_adapterList, m_adapterKeys, adapter);
 
     Q_EMIT q->adapterAdded(adapter);
 
@@ -354,7 +369,9 @@ void ManagerPrivate::addDevice(const QString &devicePath, const QVariantMap &pro
 
     DevicePtr device = DevicePtr(new Device(devicePath, properties, adapter));
     device->d->q = device.toWeakRef();
+    device->d->setUpdatePolicy(m_deviceUpdatePolicy);
     m_devices.insert(devicePath, device);
+    appendToList(m_deviceList, m_deviceKeys, device);
     adapter->d->addDevice(device);
 
     connect(device.data(), &Device::deviceRemoved, q, &Manager::deviceRemoved);
@@ -368,13 +385,15 @@ void ManagerPrivate::removeAdapter(const QString &adapterPath)
         return;
     }
 
-    // Make sure we always remove all devices before removing the adapter
+    // Make sure we always remove all devices before removing the adapter,
+    // from the last one so that removals from the lists are cheap
     const auto devices = adapter->devices();
-    for (const DevicePtr &device : devices) {
-        removeDevice(device->ubi());
+    for (auto it = devices.crbegin(); it != devices.crend(); ++it) {
+        removeDevice((*it)->ubi());
     }
 
     m_adapters.remove(adapterPath);
+    removeFromList(m_adapterList, m_adapterKeys, adapter);
     Q_EMIT adapter->adapterRemoved(adapter);
 
     if (m_adapters.isEmpty()) {
@@ -392,6 +411,8 @@ void ManagerPrivate::removeDevice(const QString &devicePath)
         return;
     }
 
+    removeFromList(m_deviceList, m_deviceKeys, device);
+
     device->adapter()->d->removeDevice(device);
 
     disconnect(device.data(), &Device::deviceChanged, q, &Manager::deviceChanged);
@@ -420,25 +441,72 @@ void ManagerPrivate::setUsableAdapter(const AdapterPtr &adapter)
     }
 }
 
+void ManagerPrivate::flushPropertiesChanged()
+{
+    const QVector<PendingPropertiesChange> changes = std::move(m_pendingPropertiesChanges);
+    m_pendingPropertiesChanges.clear();
+
+    for (const PendingPropertiesChange &change : changes) {
+        dispatchPropertiesChanged(change.path, change.interface, change.changed, change.invalidated);
+    }
+}
+
+void ManagerPrivate::dispatchPropertiesChanged(const QString &path, const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
+{
+    AdapterPtr adapter = m_adapters.value(path);
+    if (adapter) {
+        adapter->d->propertiesChanged(interface, changed, invalidated);
+        return;
+    }
+    // Anything below device path is forwarded to Device to handle
+    DevicePtr device = deviceForObjectPath(path);
+    if (device) {
+        device->d->propertiesChanged(path, interface, changed, invalidated);
+        return;
+    }
+    qCDebug(BLUEZQT) << "Unhandled property change" << interface << changed << invalidated;
+}
+
 void ManagerPrivate::propertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
 {
-    // Cut anything after device path to forward it to Device to handle
-    const QString path_full = message().path();
-    const QString path_device = path_full.section(QLatin1Char('/'), 0, 4);
-
-    QTimer::singleShot(0, this, [=]() {
-        AdapterPtr adapter = m_adapters.value(path_device);
-        if (adapter) {
-            adapter->d->propertiesChanged(interface, changed, invalidated);
-            return;
+    const PendingPropertiesChange change{message().path(), interface, changed, invalidated};
+
+    // Every characteristic value is a notification that must be delivered
+    auto isNotification = [](const PendingPropertiesChange &pending) {
+        return pending.interface == Strings::orgBluezGattCharacteristic1()
+            && (pending.changed.contains(QStringLiteral("Value")) || pending.invalidated.contains(QStringLiteral("Value")));
+    };
+
+    // Only the last queued change can be merged, merging into an earlier one
+    // would deliver the change before changes of other objects queued after it
+    bool canMerge = !m_pendingPropertiesChanges.isEmpty() && !isNotification(change);
+    if (canMerge) {
+        const PendingPropertiesChange &last = m_pendingPropertiesChanges.constLast();
+        canMerge = last.path == change.path && last.interface == change.interface && !isNotification(last);
+    }
+
+    if (canMerge) {
+        PendingPropertiesChange &pending = m_pendingPropertiesChanges.last();
+
+        for (auto i = changed.constBegin(); i != changed.constEnd(); ++i) {
+            pending.changed.insert(i.key(), i.value());
+            pending.invalidated.removeOne(i.key());
         }
-        DevicePtr device = m_devices.value(path_device);
-        if (device) {
-            device->d->propertiesChanged(path_full, interface, changed, invalidated);
-            return;
+        for (const QString &property : invalidated) {
+            pending.changed.remove(property);
+            if (!pending.invalidated.contains(property)) {
+                pending.invalidated.append(property);
+            }
         }
-        qCDebug(BLUEZQT) << "Unhandled property change" << interface << changed << invalidated;
-    });
+
+        ++m_mergedPropertiesChangedCount;
+    } else {
+        m_pendingPropertiesChanges.append(change);
+    }
+
+    if (!m_propertiesChangedTimer->isActive()) {
+        m_propertiesChangedTimer->start();
+    }
 }
 
 void ManagerPrivate::dummy()
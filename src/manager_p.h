@@ -12,10 +12,13 @@
 #include <QDBusContext>
 #include <QHash>
 #include <QObject>
+#include <QTimer>
+#include <QVector>
 
 #include "bluezagentmanager1.h"
 #include "bluezprofilemanager1.h"
 #include "dbusobjectmanager.h"
+#include "device.h"
 #include "rfkill.h"
 #include "types.h"
 
@@ -30,6 +33,13 @@ class Adapter;
 class Device;
 class AdapterPrivate;
 
+struct PendingPropertiesChange {
+    QString path;
+    QString interface;
+    QVariantMap changed;
+    QStringList invalidated;
+};
+
 class ManagerPrivate : public QObject, protected QDBusContext
 {
     Q_OBJECT
@@ -44,6 +54,8 @@ public:
     void clear();
 
     AdapterPtr findUsableAdapter() const;
+    AdapterPtr adapterForObjectPath(const QString &path) const;
+    DevicePtr deviceForObjectPath(const QString &path) const;
 
     void serviceRegistered();
     void serviceUnregistered();
@@ -61,6 +73,9 @@ public:
     bool rfkillBlocked() const;
     void setUsableAdapter(const AdapterPtr &adapter);
 
+    void flushPropertiesChanged();
+    void dispatchPropertiesChanged(const QString &path, const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
+
     Manager *q;
     Rfkill *m_rfkill;
     DBusObjectManager *m_dbusObjectManager;
@@ -69,7 +84,16 @@ public:
 
     QHash<QString, AdapterPtr> m_adapters;
     QHash<QString, DevicePtr> m_devices;
+    QList<AdapterPtr> m_adapterList;
+    QList<DevicePtr> m_deviceList;
+    QHash<Adapter *, qint64> m_adapterKeys;
+    QHash<Device *, qint64> m_deviceKeys;
     AdapterPtr m_usableAdapter;
+    Device::UpdatePolicy m_deviceUpdatePolicy;
+
+    QVector<PendingPropertiesChange> m_pendingPropertiesChanges;
+    QTimer *m_propertiesChangedTimer;
+    quint64 m_mergedPropertiesChangedCount;
 
     bool m_initialized;
     bool m_bluezRunning;
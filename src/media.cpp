@@ -46,6 +46,17 @@ PendingCall *Media::registerEndpoint(MediaEndpoint *endpoint)
     return new PendingCall(d->m_bluezMedia->RegisterEndpoint(endpoint->objectPath(), endpoint->properties()), PendingCall::ReturnVoid, this);
 }
 
+QList<PendingCall *> Media::registerEndpoints(const QList<MediaEndpoint *> &endpoints)
+{
+    QList<PendingCall *> calls;
+    calls.reserve(endpoints.size());
+
+    for (MediaEndpoint *endpoint : endpoints) {
+        calls.append(registerEndpoint(endpoint));
+    }
+    return calls;
+}
+
 PendingCall *Media::unregisterEndpoint(MediaEndpoint *endpoint)
 {
     Q_ASSERT(endpoint);
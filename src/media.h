@@ -9,6 +9,7 @@
 #ifndef BLUEZQT_MEDIA_H
 #define BLUEZQT_MEDIA_H
 
+#include <QList>
 #include <QObject>
 
 #include "bluezqt_export.h"
@@ -59,6 +60,17 @@ public:
      */
     PendingCall *registerEndpoint(MediaEndpoint *endpoint);
 
+    /**
+     * Registers endpoints.
+     *
+     * Registers each endpoint as registerEndpoint() does, typically
+     * one endpoint per supported codec.
+     *
+     * @param endpoints endpoints to be registered
+     * @return void pending calls, in order of endpoints
+     */
+    QList<PendingCall *> registerEndpoints(const QList<MediaEndpoint *> &endpoints);
+
     /**
      * Unregisters endpoint.
      *
@@ -7,7 +7,7 @@
  */
 
 #include "mediaendpoint.h"
-#include "a2dp-codecs.h"
+#include "a2dpcodec_p.h"
 #include "mediaendpoint_p.h"
 
 namespace BluezQt
@@ -33,6 +33,47 @@ const QVariantMap &MediaEndpoint::properties() const
     return d->m_properties;
 }
 
+MediaEndpoint::Preference MediaEndpoint::preference() const
+{
+    return d->m_policy.preference;
+}
+
+void MediaEndpoint::setPreference(Preference preference)
+{
+    d->m_policy.preference = preference;
+    d->m_properties[QStringLiteral("Capabilities")] = d->m_codec->ownCapabilities(d->m_policy);
+}
+
+int MediaEndpoint::bitrate() const
+{
+    return d->m_policy.bitrate;
+}
+
+void MediaEndpoint::setBitrate(int bitrate)
+{
+    d->m_policy.bitrate = bitrate;
+}
+
+int MediaEndpoint::packetLatency() const
+{
+    return d->m_policy.packetLatency;
+}
+
+void MediaEndpoint::setPacketLatency(int usec)
+{
+    d->m_policy.packetLatency = usec;
+}
+
+MediaEndpoint::ChannelMode MediaEndpoint::channelMode() const
+{
+    return d->m_policy.channelMode;
+}
+
+void MediaEndpoint::setChannelMode(ChannelMode mode)
+{
+    d->m_policy.channelMode = mode;
+}
+
 void MediaEndpoint::setConfiguration(const QString &transportObjectPath, const QVariantMap &properties)
 {
     Q_EMIT configurationSet(transportObjectPath, properties);
@@ -40,86 +81,18 @@ void MediaEndpoint::setConfiguration(const QString &transportObjectPath, const Q
 
 void MediaEndpoint::selectConfiguration(const QByteArray &capabilities, const Request<QByteArray> &request)
 {
-    switch (d->m_configuration.codec) {
-    case MediaEndpoint::Codec::Sbc: {
-        if (capabilities.size() != sizeof(a2dp_sbc_t)) {
-            Q_EMIT configurationSelected(capabilities, QByteArray());
-            request.reject();
-            return;
-        }
-
-        a2dp_sbc_t caps = *reinterpret_cast<const a2dp_sbc_t *>(capabilities.constData());
-        if (caps.frequency & SBC_SAMPLING_FREQ_44100) {
-            caps.frequency = SBC_SAMPLING_FREQ_44100;
-        } else if (caps.frequency & SBC_SAMPLING_FREQ_48000) {
-            caps.frequency = SBC_SAMPLING_FREQ_48000;
-        } else {
-            break;
-        }
-
-        if (caps.channel_mode & SBC_CHANNEL_MODE_STEREO) {
-            caps.channel_mode = SBC_CHANNEL_MODE_STEREO;
-        } else if (caps.channel_mode & SBC_CHANNEL_MODE_JOINT_STEREO) {
-            caps.channel_mode = SBC_CHANNEL_MODE_JOINT_STEREO;
-        } else {
-            break;
-        }
-
-        if (caps.block_length & SBC_BLOCK_LENGTH_16) {
-            caps.block_length = SBC_BLOCK_LENGTH_16;
-        } else if (caps.block_length & SBC_BLOCK_LENGTH_12) {
-            caps.block_length = SBC_BLOCK_LENGTH_12;
-        } else if (caps.block_length & SBC_BLOCK_LENGTH_8) {
-            caps.block_length = SBC_BLOCK_LENGTH_8;
-        } else if (caps.block_length & SBC_BLOCK_LENGTH_4) {
-            caps.block_length = SBC_BLOCK_LENGTH_4;
-        } else {
-            break;
-        }
-
-        if (caps.subbands & SBC_SUBBANDS_8) {
-            caps.subbands = SBC_SUBBANDS_8;
-        } else if (caps.subbands & SBC_SUBBANDS_4) {
-            caps.subbands = SBC_SUBBANDS_4;
-        } else {
-            break;
-        }
-
-        if (caps.allocation_method & SBC_ALLOCATION_LOUDNESS) {
-            caps.allocation_method = SBC_ALLOCATION_LOUDNESS;
-        } else if (caps.allocation_method & SBC_ALLOCATION_SNR) {
-            caps.allocation_method = SBC_ALLOCATION_SNR;
-        } else {
-            break;
-        }
-
-        caps.min_bitpool = 2;
-        caps.max_bitpool = 53;
-
-        const QByteArray configuration(reinterpret_cast<const char *>(&caps), sizeof(caps));
-        Q_EMIT configurationSelected(capabilities, configuration);
-        request.accept(configuration);
-        return;
-
-        break;
+    QByteArray configuration;
+    if (d->m_codec->matches(capabilities)) {
+        configuration = d->m_codec->selectConfiguration(capabilities, d->m_policy);
     }
-    case MediaEndpoint::Codec::Aac:
-        if (capabilities.size() != sizeof(a2dp_aac_t)) {
-            Q_EMIT configurationSelected(capabilities, QByteArray());
-            request.reject();
-            return;
-        }
-
-        // TODO: implement AAC. However selectConfiguration seems not to be used by iOS nor Android.
-        Q_EMIT configurationSelected(capabilities, QByteArray());
+
+    Q_EMIT configurationSelected(capabilities, configuration);
+
+    if (configuration.isEmpty()) {
         request.reject();
         return;
-
-        break;
     }
-
-    Q_EMIT configurationSelected(capabilities, QByteArray());
-    request.reject();
+    request.accept(configuration);
 }
 
 void MediaEndpoint::clearConfiguration(const QString &transportObjectPath)
@@ -41,6 +41,26 @@ public:
     enum class Codec {
         Sbc,
         Aac,
+        /** Vendor codec, see A2DP_CODEC_VENDOR. */
+        AptX,
+        /** Vendor codec, see A2DP_CODEC_VENDOR. */
+        Ldac,
+    };
+
+    /** Preference used when selecting configuration from capabilities of remote endpoint. */
+    enum class Preference {
+        /** Highest bitrate supported by both endpoints. */
+        HighestBitrate,
+        /** Short frames at constant bitrate, each frame fitting into one baseband packet. */
+        LowestLatency,
+    };
+
+    /** Channel mode preferred when selecting SBC configuration. */
+    enum class ChannelMode {
+        Mono,
+        DualChannel,
+        Stereo,
+        JointStereo,
     };
 
     /** Configuration for MediaEndpoint construction. */
@@ -79,6 +99,79 @@ public:
      */
     virtual const QVariantMap &properties() const;
 
+    /**
+     * Returns the preference used when selecting AAC configuration.
+     *
+     * Default value is Preference::HighestBitrate.
+     *
+     * @return preference
+     */
+    Preference preference() const;
+
+    /**
+     * Sets the preference used when selecting AAC configuration.
+     *
+     * The bitrate in advertised capabilities is limited by the preference
+     * as well, so it should be set before the endpoint is registered.
+     *
+     * @param preference preference
+     */
+    void setPreference(Preference preference);
+
+    /**
+     * Returns the target SBC bitrate.
+     *
+     * @return bitrate in bits per second, 0 if not set
+     */
+    int bitrate() const;
+
+    /**
+     * Sets the target SBC bitrate.
+     *
+     * The highest bitpool not exceeding the target is selected, within
+     * the bitpool range of both endpoints. 0 selects bitpool 53,
+     * recommended for high quality by the A2DP specification.
+     *
+     * @param bitrate bitrate in bits per second
+     */
+    void setBitrate(int bitrate);
+
+    /**
+     * Returns the longest SBC packet latency.
+     *
+     * @return latency in microseconds, 0 for no limit
+     */
+    int packetLatency() const;
+
+    /**
+     * Sets the longest SBC packet latency.
+     *
+     * Block length and subbands are reduced until the audio in one full
+     * packet of SbcStreamInfo::defaultMtu bytes fits into this budget.
+     *
+     * @param usec latency in microseconds, 0 for no limit
+     */
+    void setPacketLatency(int usec);
+
+    /**
+     * Returns the preferred SBC channel mode.
+     *
+     * Default value is ChannelMode::Stereo.
+     *
+     * @return preferred channel mode
+     */
+    ChannelMode channelMode() const;
+
+    /**
+     * Sets the preferred SBC channel mode.
+     *
+     * The channel mode is used if it is supported by both endpoints.
+     * Mono and dual channel are only supported by endpoints of Role::AudioSink.
+     *
+     * @param mode preferred channel mode
+     */
+    void setChannelMode(ChannelMode mode);
+
     /**
      * Set configuration for the transport.
      *
@@ -8,7 +8,7 @@
 
 #include "mediaendpoint_p.h"
 
-#include "a2dp-codecs.h"
+#include "a2dpcodec_p.h"
 #include "services.h"
 
 namespace BluezQt
@@ -38,18 +38,13 @@ void MediaEndpointPrivate::init(const MediaEndpoint::Configuration &configuratio
         break;
     }
 
-    switch (configuration.codec) {
-    case MediaEndpoint::Codec::Sbc:
-        m_properties[codec] = QVariant::fromValue(uchar(A2DP_CODEC_SBC));
-        m_properties[capabilities] = QByteArray(reinterpret_cast<const char *>(&sbcCapabilities), sizeof(sbcCapabilities));
-        objectPath += QStringLiteral("/Sbc");
-        break;
-    case MediaEndpoint::Codec::Aac:
-        m_properties[codec] = QVariant::fromValue(uchar(A2DP_CODEC_MPEG24));
-        m_properties[capabilities] = QByteArray(reinterpret_cast<const char *>(&aacCapabilities), sizeof(aacCapabilities));
-        objectPath += QStringLiteral("/Aac");
-        break;
-    }
+    m_codec = A2dpCodec::find(configuration.codec);
+    Q_ASSERT(m_codec);
+    m_policy.role = configuration.role;
+
+    m_properties[codec] = QVariant::fromValue(uchar(m_codec->id));
+    m_properties[capabilities] = m_codec->ownCapabilities(m_policy);
+    objectPath += QLatin1Char('/') + QLatin1String(m_codec->name);
 
     m_objectPath.setPath(objectPath);
 }
@@ -12,6 +12,7 @@
 #include <QDBusObjectPath>
 #include <QVariantMap>
 
+#include "a2dpcodec_p.h"
 #include "mediaendpoint.h"
 
 namespace BluezQt
@@ -25,6 +26,8 @@ public:
 
     QVariantMap m_properties;
     MediaEndpoint::Configuration m_configuration;
+    A2dpPolicy m_policy;
+    const A2dpCodec *m_codec = nullptr;
     QDBusObjectPath m_objectPath;
 };
 
@@ -27,6 +27,11 @@ AudioConfiguration MediaTransport::audioConfiguration() const
     return d->m_configuration;
 }
 
+int MediaTransport::channels() const
+{
+    return d->m_channels;
+}
+
 MediaTransport::State MediaTransport::state() const
 {
     return d->m_state;
@@ -52,6 +52,13 @@ public:
      */
     AudioConfiguration audioConfiguration() const;
 
+    /**
+     * Returns the number of audio channels of the transport.
+     *
+     * @return number of channels, 0 if unknown
+     */
+    int channels() const;
+
     /**
      * Returns the state of the transport.
      *
@@ -7,7 +7,7 @@
  */
 
 #include "mediatransport_p.h"
-#include "a2dp-codecs.h"
+#include "a2dpcodec_p.h"
 #include "macros.h"
 #include "utils.h"
 
@@ -23,62 +23,6 @@ static MediaTransport::State stringToState(const QString &state)
     return MediaTransport::State::Idle;
 }
 
-static AudioCodec intToCodec(int value)
-{
-    switch (value) {
-    case A2DP_CODEC_SBC:
-        return AudioCodec::Sbc;
-        break;
-    case A2DP_CODEC_MPEG24:
-        return AudioCodec::Aac;
-        break;
-    }
-
-    return AudioCodec::Invalid;
-}
-
-static AudioSampleRate byteArrayToSampleRate(AudioCodec codec, const QByteArray &buffer)
-{
-    switch (codec) {
-    case AudioCodec::Sbc: {
-        if (buffer.size() != sizeof(a2dp_sbc_t)) {
-            return AudioSampleRate::Invalid;
-        }
-
-        a2dp_sbc_t sbcConfig = *reinterpret_cast<const a2dp_sbc_t *>(buffer.constData());
-        switch (sbcConfig.frequency) {
-        case SBC_SAMPLING_FREQ_44100:
-            return AudioSampleRate::Rate44100;
-            break;
-        case SBC_SAMPLING_FREQ_48000:
-            return AudioSampleRate::Rate48000;
-            break;
-        }
-        break;
-    }
-    case AudioCodec::Aac: {
-        if (buffer.size() != sizeof(a2dp_aac_t)) {
-            return AudioSampleRate::Invalid;
-        }
-
-        a2dp_aac_t aacConfig = *reinterpret_cast<const a2dp_aac_t *>(buffer.constData());
-        switch (AAC_GET_FREQUENCY(aacConfig)) {
-        case AAC_SAMPLING_FREQ_44100:
-            return AudioSampleRate::Rate44100;
-            break;
-        case AAC_SAMPLING_FREQ_48000:
-            return AudioSampleRate::Rate48000;
-            break;
-        }
-        break;
-    }
-    default:
-        break;
-    }
-
-    return AudioSampleRate::Invalid;
-}
-
 MediaTransportPrivate::MediaTransportPrivate(const QString &path, const QVariantMap &properties)
     : QObject()
     , m_dbusInterface(Strings::orgBluez(), path, DBusConnection::orgBluez())
@@ -100,8 +44,14 @@ void MediaTransportPrivate::init(const QVariantMap &properties)
 
     m_volume = properties.value(QStringLiteral("Volume")).toUInt();
     m_state = stringToState(properties.value(QStringLiteral("State")).toString());
-    m_configuration.codec = intToCodec(properties.value(QStringLiteral("Codec")).toInt());
-    m_configuration.sampleRate = byteArrayToSampleRate(m_configuration.codec, properties.value(QStringLiteral("Configuration")).toByteArray());
+
+    const QByteArray configuration = properties.value(QStringLiteral("Configuration")).toByteArray();
+    const A2dpCodec *codec = A2dpCodec::find(properties.value(QStringLiteral("Codec")).toUInt(), configuration);
+    if (codec) {
+        m_configuration.codec = codec->codec;
+        m_configuration.sampleRate = codec->audioSampleRate(configuration);
+        m_channels = codec->matches(configuration) ? codec->channels(configuration) : 0;
+    }
 }
 
 void MediaTransportPrivate::onPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
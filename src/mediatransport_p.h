@@ -35,6 +35,7 @@ public:
 
     QString m_path;
     AudioConfiguration m_configuration;
+    int m_channels = 0;
     MediaTransport::State m_state = MediaTransport::State::Idle;
     quint16 m_volume = 0;
 };
@@ -0,0 +1,574 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "mediatransportstream.h"
+#include "mediatransportstream_p.h"
+
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <QDBusUnixFileDescriptor>
+#include <QSocketNotifier>
+
+#include <cstring>
+
+namespace BluezQt
+{
+// RTP header (RFC 3550) followed by A2DP SBC media payload header
+static const int RTP_HEADER_SIZE = 12;
+static const int PACKET_HEADER_SIZE = SbcFrameHeader::packetHeaderSize;
+static const quint8 RTP_PAYLOAD_TYPE = 96;
+static const int MAX_FRAMES_PER_PACKET = SbcFrameHeader::maxFramesPerPacket;
+
+static quint32 readBigEndian32(const uchar *data)
+{
+    return (quint32(data[0]) << 24) | (quint32(data[1]) << 16) | (quint32(data[2]) << 8) | quint32(data[3]);
+}
+
+MediaTransportStreamPrivate::MediaTransportStreamPrivate(MediaTransportStream *q)
+    : q(q)
+    , m_fd(-1)
+    , m_readMtu(0)
+    , m_writeMtu(0)
+    , m_readNotifier(nullptr)
+    , m_writeNotifier(nullptr)
+    , m_framesPos(0)
+    , m_poolSize(16)
+    , m_poolHead(0)
+    , m_poolCount(0)
+    , m_packetOpen(false)
+    , m_packetFrames(0)
+    , m_queuedBytes(0)
+    , m_sendSequence(0)
+    , m_sendTimestamp(0)
+    , m_receiving(false)
+    , m_lastSequence(0)
+    , m_lastTimestamp(0)
+    , m_lastArrival(0)
+    , m_sampleRate(0)
+    , m_jitter(0)
+    , m_packetsReceived(0)
+    , m_packetsSent(0)
+    , m_packetsLost(0)
+    , m_underruns(0)
+{
+}
+
+void MediaTransportStreamPrivate::readPackets()
+{
+#ifdef Q_OS_LINUX
+    const int framesBefore = m_frameSizes.size();
+
+    while (m_fd >= 0) {
+        const ssize_t size = ::recv(m_fd, m_recvPacket.data(), m_recvPacket.size(), MSG_DONTWAIT);
+        if (size < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                q->setErrorString(QString::fromLocal8Bit(strerror(errno)));
+                hangup();
+                return;
+            }
+            break;
+        } else if (size == 0) {
+            hangup();
+            return;
+        }
+        depacketize(reinterpret_cast<const uchar *>(m_recvPacket.constData()), size, m_clock.nsecsElapsed());
+    }
+
+    if (m_frameSizes.size() > framesBefore) {
+        Q_EMIT q->readyRead();
+    }
+#endif
+}
+
+void MediaTransportStreamPrivate::depacketize(const uchar *data, int size, qint64 arrival)
+{
+    if (size < PACKET_HEADER_SIZE || (data[0] >> 6) != 2) {
+        return;
+    }
+
+    int offset = RTP_HEADER_SIZE + 4 * (data[0] & 0x0F);
+    if (data[0] & 0x10) {
+        if (size < offset + 4) {
+            return;
+        }
+        offset += 4 + 4 * ((data[offset + 2] << 8) | data[offset + 3]);
+    }
+
+    int end = size;
+    if (data[0] & 0x20) {
+        end -= data[size - 1];
+    }
+    if (offset >= end) {
+        return;
+    }
+
+    updateStatistics((data[2] << 8) | data[3], readBigEndian32(data + 4), arrival);
+
+    // Fragmented frames are not supported, they only occur with MTU smaller than one frame
+    const quint8 payloadHeader = data[offset++];
+    if (payloadHeader & 0x80) {
+        return;
+    }
+
+    const int frames = payloadHeader & 0x0F;
+    for (int i = 0; i < frames; ++i) {
+        SbcFrameHeader header;
+        if (!header.parse(data + offset, end - offset)) {
+            break;
+        }
+        const int length = header.frameLength();
+        if (offset + length > end) {
+            break;
+        }
+
+        m_frames.append(reinterpret_cast<const char *>(data + offset), length);
+        m_frameSizes.enqueue(length);
+        m_sampleRate = header.sampleRate;
+        offset += length;
+    }
+}
+
+void MediaTransportStreamPrivate::updateStatistics(quint16 sequence, quint32 timestamp, qint64 arrival)
+{
+    ++m_packetsReceived;
+
+    if (!m_receiving) {
+        m_receiving = true;
+        m_lastSequence = sequence;
+        m_lastTimestamp = timestamp;
+        m_lastArrival = arrival;
+        return;
+    }
+
+    // Late and duplicated packets are ignored
+    const quint16 gap = sequence - quint16(m_lastSequence + 1);
+    if (gap >= 0x8000) {
+        return;
+    }
+    m_packetsLost += gap;
+    m_lastSequence = sequence;
+
+    if (m_sampleRate > 0) {
+        const double transit = double(arrival - m_lastArrival) * m_sampleRate / 1e9;
+        const double difference = transit - double(qint32(timestamp - m_lastTimestamp));
+        m_jitter += (qAbs(difference) - m_jitter) / 16;
+    }
+
+    m_lastTimestamp = timestamp;
+    m_lastArrival = arrival;
+}
+
+MediaTransportStreamPrivate::PendingResult MediaTransportStreamPrivate::completePendingFrame(const char *data, qint64 maxSize, qint64 *pos)
+{
+    if (m_pendingFrame.size() < SbcFrameHeader::headerSize) {
+        const int count = qMin<qint64>(SbcFrameHeader::headerSize - m_pendingFrame.size(), maxSize - *pos);
+        m_pendingFrame.append(data + *pos, count);
+        *pos += count;
+        if (m_pendingFrame.size() < SbcFrameHeader::headerSize) {
+            return NeedMoreData;
+        }
+    }
+
+    SbcFrameHeader header;
+    if (!header.parse(reinterpret_cast<const uchar *>(m_pendingFrame.constData()), m_pendingFrame.size())) {
+        m_pendingFrame.clear();
+        return InvalidFrame;
+    }
+
+    const int length = header.frameLength();
+    if (m_pendingFrame.size() < length) {
+        const int count = qMin<qint64>(length - m_pendingFrame.size(), maxSize - *pos);
+        m_pendingFrame.append(data + *pos, count);
+        *pos += count;
+        if (m_pendingFrame.size() < length) {
+            return NeedMoreData;
+        }
+    }
+    return FrameComplete;
+}
+
+MediaTransportStreamPrivate::AppendResult MediaTransportStreamPrivate::appendFrame(const char *frame, int length, const SbcFrameHeader &header)
+{
+    if (PACKET_HEADER_SIZE + length > m_writeMtu) {
+        return FrameTooLarge;
+    }
+
+    const int slot = (m_poolHead + m_poolCount) % m_poolSize;
+
+    if (m_packetOpen && (m_packetSizes.at(slot) + length > m_writeMtu || m_packetFrames == MAX_FRAMES_PER_PACKET)) {
+        finishPacket();
+        return appendFrame(frame, length, header);
+    }
+
+    char *packet = m_pool.data() + slot * m_writeMtu;
+
+    if (!m_packetOpen) {
+        if (m_poolCount == m_poolSize) {
+            return PoolFull;
+        }
+
+        packet[0] = char(0x80);
+        packet[1] = char(RTP_PAYLOAD_TYPE);
+        packet[2] = char(m_sendSequence >> 8);
+        packet[3] = char(m_sendSequence & 0xFF);
+        packet[4] = char(m_sendTimestamp >> 24);
+        packet[5] = char((m_sendTimestamp >> 16) & 0xFF);
+        packet[6] = char((m_sendTimestamp >> 8) & 0xFF);
+        packet[7] = char(m_sendTimestamp & 0xFF);
+        // SSRC
+        packet[8] = 0;
+        packet[9] = 0;
+        packet[10] = 0;
+        packet[11] = 1;
+
+        m_packetSizes[slot] = PACKET_HEADER_SIZE;
+        m_packetFrameBytes[slot] = 0;
+        m_packetFrames = 0;
+        m_packetOpen = true;
+    }
+
+    memcpy(packet + m_packetSizes.at(slot), frame, length);
+    m_packetSizes[slot] += length;
+    m_packetFrameBytes[slot] += length;
+    m_queuedBytes += length;
+    ++m_packetFrames;
+    m_sendTimestamp += header.samplesPerFrame();
+    return Appended;
+}
+
+void MediaTransportStreamPrivate::finishPacket()
+{
+    if (!m_packetOpen) {
+        return;
+    }
+
+    const int slot = (m_poolHead + m_poolCount) % m_poolSize;
+    m_pool[slot * m_writeMtu + RTP_HEADER_SIZE] = char(m_packetFrames & 0x0F);
+
+    ++m_poolCount;
+    ++m_sendSequence;
+    m_packetOpen = false;
+}
+
+void MediaTransportStreamPrivate::flushPackets()
+{
+#ifdef Q_OS_LINUX
+    qint64 written = 0;
+    bool blocked = false;
+
+    while (m_fd >= 0 && m_poolCount > 0) {
+        const char *packet = m_pool.constData() + m_poolHead * m_writeMtu;
+        if (::send(m_fd, packet, m_packetSizes.at(m_poolHead), MSG_DONTWAIT | MSG_NOSIGNAL) < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                blocked = true;
+            } else {
+                q->setErrorString(QString::fromLocal8Bit(strerror(errno)));
+                hangup();
+                return;
+            }
+            break;
+        }
+
+        written += m_packetFrameBytes.at(m_poolHead);
+        m_queuedBytes -= m_packetFrameBytes.at(m_poolHead);
+        m_poolHead = (m_poolHead + 1) % m_poolSize;
+        --m_poolCount;
+        ++m_packetsSent;
+    }
+
+    if (m_writeNotifier) {
+        m_writeNotifier->setEnabled(blocked);
+    }
+
+    if (written > 0) {
+        Q_EMIT q->bytesWritten(written);
+    }
+#endif
+}
+
+void MediaTransportStreamPrivate::hangup()
+{
+    q->close();
+    Q_EMIT q->readChannelFinished();
+}
+
+MediaTransportStream::MediaTransportStream(const QDBusUnixFileDescriptor &fd, quint16 readMtu, quint16 writeMtu, QObject *parent)
+    : QIODevice(parent)
+    , d(new MediaTransportStreamPrivate(this))
+{
+#ifdef Q_OS_LINUX
+    if (fd.isValid()) {
+        d->m_fd = ::dup(fd.fileDescriptor());
+    }
+#endif
+    d->m_readMtu = readMtu;
+    d->m_writeMtu = writeMtu;
+}
+
+MediaTransportStream::~MediaTransportStream()
+{
+    close();
+#ifdef Q_OS_LINUX
+    if (d->m_fd >= 0) {
+        ::close(d->m_fd);
+    }
+#endif
+    delete d;
+}
+
+bool MediaTransportStream::open(OpenMode mode)
+{
+    if (d->m_fd < 0) {
+        setErrorString(QStringLiteral("Invalid file descriptor"));
+        return false;
+    }
+
+    if ((mode & WriteOnly) && d->m_writeMtu <= PACKET_HEADER_SIZE + SbcFrameHeader::headerSize) {
+        setErrorString(QStringLiteral("Write MTU too small"));
+        return false;
+    }
+
+    if (!QIODevice::open(mode | Unbuffered)) {
+        return false;
+    }
+
+    d->m_clock.start();
+
+    if (mode & ReadOnly) {
+        d->m_recvPacket.resize(qMax<int>(d->m_readMtu, PACKET_HEADER_SIZE));
+        d->m_readNotifier = new QSocketNotifier(d->m_fd, QSocketNotifier::Read, this);
+        connect(d->m_readNotifier, &QSocketNotifier::activated, this, [this]() {
+            d->readPackets();
+        });
+    }
+
+    if (mode & WriteOnly) {
+        d->m_pool.resize(d->m_poolSize * d->m_writeMtu);
+        d->m_packetSizes.fill(0, d->m_poolSize);
+        d->m_packetFrameBytes.fill(0, d->m_poolSize);
+        d->m_writeNotifier = new QSocketNotifier(d->m_fd, QSocketNotifier::Write, this);
+        d->m_writeNotifier->setEnabled(false);
+        connect(d->m_writeNotifier, &QSocketNotifier::activated, this, [this]() {
+            d->flushPackets();
+        });
+    }
+
+    return true;
+}
+
+void MediaTransportStream::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    QIODevice::close();
+
+    // Notifiers may be closed from their own activated() handler
+    if (d->m_readNotifier) {
+        d->m_readNotifier->setEnabled(false);
+        d->m_readNotifier->deleteLater();
+        d->m_readNotifier = nullptr;
+    }
+    if (d->m_writeNotifier) {
+        d->m_writeNotifier->setEnabled(false);
+        d->m_writeNotifier->deleteLater();
+        d->m_writeNotifier = nullptr;
+    }
+#ifdef Q_OS_LINUX
+    if (d->m_fd >= 0) {
+        ::close(d->m_fd);
+    }
+#endif
+    d->m_fd = -1;
+}
+
+bool MediaTransportStream::isSequential() const
+{
+    return true;
+}
+
+qint64 MediaTransportStream::bytesAvailable() const
+{
+    return QIODevice::bytesAvailable() + d->m_frames.size() - d->m_framesPos;
+}
+
+qint64 MediaTransportStream::bytesToWrite() const
+{
+    return QIODevice::bytesToWrite() + d->m_queuedBytes + d->m_pendingFrame.size();
+}
+
+quint16 MediaTransportStream::readMtu() const
+{
+    return d->m_readMtu;
+}
+
+quint16 MediaTransportStream::writeMtu() const
+{
+    return d->m_writeMtu;
+}
+
+int MediaTransportStream::packetPoolSize() const
+{
+    return d->m_poolSize;
+}
+
+void MediaTransportStream::setPacketPoolSize(int size)
+{
+    if (!isOpen()) {
+        d->m_poolSize = qMax(1, size);
+    }
+}
+
+int MediaTransportStream::framesAvailable() const
+{
+    return d->m_frameSizes.size();
+}
+
+QByteArray MediaTransportStream::readFrame()
+{
+    if (d->m_frameSizes.isEmpty()) {
+        if (d->m_receiving) {
+            ++d->m_underruns;
+        }
+        return QByteArray();
+    }
+
+    const int length = d->m_frameSizes.dequeue();
+    const QByteArray frame = d->m_frames.mid(d->m_framesPos, length);
+    d->m_framesPos += length;
+
+    if (d->m_frameSizes.isEmpty()) {
+        d->m_frames.resize(0);
+        d->m_framesPos = 0;
+    }
+    return frame;
+}
+
+quint64 MediaTransportStream::packetsReceived() const
+{
+    return d->m_packetsReceived;
+}
+
+quint64 MediaTransportStream::packetsSent() const
+{
+    return d->m_packetsSent;
+}
+
+quint64 MediaTransportStream::packetsLost() const
+{
+    return d->m_packetsLost;
+}
+
+quint64 MediaTransportStream::underruns() const
+{
+    return d->m_underruns;
+}
+
+qreal MediaTransportStream::jitter() const
+{
+    return d->m_sampleRate > 0 ? d->m_jitter * 1e6 / d->m_sampleRate : 0;
+}
+
+qint64 MediaTransportStream::readData(char *data, qint64 maxSize)
+{
+    // Only whole frames are returned
+    qint64 size = 0;
+    while (!d->m_frameSizes.isEmpty() && size + d->m_frameSizes.head() <= maxSize) {
+        const int length = d->m_frameSizes.dequeue();
+        memcpy(data + size, d->m_frames.constData() + d->m_framesPos, length);
+        d->m_framesPos += length;
+        size += length;
+    }
+
+    if (d->m_frameSizes.isEmpty()) {
+        d->m_frames.resize(0);
+        d->m_framesPos = 0;
+        if (size == 0) {
+            if (d->m_fd < 0) {
+                return -1;
+            }
+            if (d->m_receiving) {
+                ++d->m_underruns;
+            }
+        }
+    }
+    return size;
+}
+
+qint64 MediaTransportStream::writeData(const char *data, qint64 maxSize)
+{
+    qint64 pos = 0;
+
+    while (true) {
+        // Frame split across writes is completed first
+        if (!d->m_pendingFrame.isEmpty()) {
+            const MediaTransportStreamPrivate::PendingResult pending = d->completePendingFrame(data, maxSize, &pos);
+            if (pending == MediaTransportStreamPrivate::NeedMoreData) {
+                break;
+            } else if (pending == MediaTransportStreamPrivate::InvalidFrame) {
+                setErrorString(QStringLiteral("Invalid SBC frame"));
+                return -1;
+            }
+
+            SbcFrameHeader header;
+            header.parse(reinterpret_cast<const uchar *>(d->m_pendingFrame.constData()), d->m_pendingFrame.size());
+            const MediaTransportStreamPrivate::AppendResult result = d->appendFrame(d->m_pendingFrame.constData(), d->m_pendingFrame.size(), header);
+            if (result == MediaTransportStreamPrivate::PoolFull) {
+                break;
+            } else if (result == MediaTransportStreamPrivate::FrameTooLarge) {
+                d->m_pendingFrame.clear();
+                setErrorString(QStringLiteral("SBC frame does not fit into write MTU"));
+                return -1;
+            }
+            d->m_pendingFrame.clear();
+            continue;
+        }
+
+        const qint64 remaining = maxSize - pos;
+        if (remaining <= 0) {
+            break;
+        }
+
+        SbcFrameHeader header;
+        if (remaining < SbcFrameHeader::headerSize) {
+            d->m_pendingFrame.append(data + pos, remaining);
+            pos = maxSize;
+            continue;
+        }
+        if (!header.parse(reinterpret_cast<const uchar *>(data + pos), remaining)) {
+            setErrorString(QStringLiteral("Invalid SBC frame"));
+            return pos > 0 ? pos : -1;
+        }
+
+        const int length = header.frameLength();
+        if (remaining < length) {
+            d->m_pendingFrame.append(data + pos, remaining);
+            pos = maxSize;
+            continue;
+        }
+
+        const MediaTransportStreamPrivate::AppendResult result = d->appendFrame(data + pos, length, header);
+        if (result == MediaTransportStreamPrivate::PoolFull) {
+            break;
+        } else if (result == MediaTransportStreamPrivate::FrameTooLarge) {
+            setErrorString(QStringLiteral("SBC frame does not fit into write MTU"));
+            return pos > 0 ? pos : -1;
+        }
+        pos += length;
+    }
+
+    d->finishPacket();
+    d->flushPackets();
+    return pos;
+}
+
+} // namespace BluezQt
@@ -0,0 +1,165 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QIODevice>
+
+#include "bluezqt_export.h"
+
+class QDBusUnixFileDescriptor;
+
+namespace BluezQt
+{
+/**
+ * @class BluezQt::MediaTransportStream mediatransportstream.h <BluezQt/MediaTransportStream>
+ *
+ * A2DP media transport stream.
+ *
+ * This class represents the stream socket of an acquired media transport
+ * carrying SBC audio in RTP packets, created from the file descriptor
+ * returned by MediaTransport::acquire().
+ *
+ * Reading returns whole SBC frames extracted from received RTP packets,
+ * writing accepts SBC frames that are packed into RTP packets of at most
+ * writeMtu() bytes. Frames of one write() call are sent together, packets
+ * are kept in a preallocated pool while the socket is not writable.
+ *
+ * All socket operations are non-blocking, the stream is unbuffered
+ * and sequential.
+ *
+ * @code
+ * auto *call = transport->acquire();
+ * connect(call, &PendingCall::finished, [call]() {
+ *     auto *stream = new MediaTransportStream(call->valueAt<0>(), call->valueAt<1>(), call->valueAt<2>());
+ *     stream->open(QIODevice::ReadOnly);
+ * });
+ * @endcode
+ */
+class BLUEZQT_EXPORT MediaTransportStream : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Creates a new MediaTransportStream object.
+     *
+     * The file descriptor is duplicated, the stream owns the duplicate.
+     *
+     * @param fd transport file descriptor
+     * @param readMtu read MTU of the transport
+     * @param writeMtu write MTU of the transport
+     * @param parent parent object
+     */
+    explicit MediaTransportStream(const QDBusUnixFileDescriptor &fd, quint16 readMtu, quint16 writeMtu, QObject *parent = nullptr);
+
+    /**
+     * Destroys a MediaTransportStream object.
+     */
+    ~MediaTransportStream() override;
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+    qint64 bytesToWrite() const override;
+
+    /**
+     * Returns the read MTU of the transport.
+     *
+     * @return read MTU
+     */
+    quint16 readMtu() const;
+
+    /**
+     * Returns the write MTU of the transport.
+     *
+     * @return write MTU
+     */
+    quint16 writeMtu() const;
+
+    /**
+     * Returns the number of packets that can be queued for sending.
+     *
+     * @return packet pool size
+     */
+    int packetPoolSize() const;
+
+    /**
+     * Sets the number of packets that can be queued for sending.
+     *
+     * Must be set before the stream is opened. Default is 16.
+     *
+     * @param size packet pool size
+     */
+    void setPacketPoolSize(int size);
+
+    /**
+     * Returns the number of received frames not read yet.
+     *
+     * @return number of frames
+     */
+    int framesAvailable() const;
+
+    /**
+     * Reads one SBC frame.
+     *
+     * @return frame or empty byte array if there are no frames
+     */
+    QByteArray readFrame();
+
+    /**
+     * Returns the number of received RTP packets.
+     *
+     * @return received packets
+     */
+    quint64 packetsReceived() const;
+
+    /**
+     * Returns the number of sent RTP packets.
+     *
+     * @return sent packets
+     */
+    quint64 packetsSent() const;
+
+    /**
+     * Returns the number of lost packets.
+     *
+     * Losses are detected from gaps in RTP sequence numbers.
+     *
+     * @return lost packets
+     */
+    quint64 packetsLost() const;
+
+    /**
+     * Returns the number of underruns.
+     *
+     * Underrun is counted when the stream is read while no frames are available.
+     *
+     * @return underruns
+     */
+    quint64 underruns() const;
+
+    /**
+     * Returns the interarrival jitter of received packets.
+     *
+     * The jitter is estimated as described in RFC 3550, section 6.4.1.
+     *
+     * @return jitter in microseconds
+     */
+    qreal jitter() const;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    class MediaTransportStreamPrivate *const d;
+
+    friend class MediaTransportStreamPrivate;
+};
+
+} // namespace BluezQt
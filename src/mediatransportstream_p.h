@@ -0,0 +1,91 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QQueue>
+#include <QVector>
+
+#include "sbcframe_p.h"
+
+class QSocketNotifier;
+
+namespace BluezQt
+{
+class MediaTransportStream;
+
+class MediaTransportStreamPrivate
+{
+public:
+    enum AppendResult {
+        Appended,
+        PoolFull,
+        FrameTooLarge,
+    };
+
+    enum PendingResult {
+        NeedMoreData,
+        FrameComplete,
+        InvalidFrame,
+    };
+
+    explicit MediaTransportStreamPrivate(MediaTransportStream *q);
+
+    void readPackets();
+    void depacketize(const uchar *data, int size, qint64 arrival);
+    void updateStatistics(quint16 sequence, quint32 timestamp, qint64 arrival);
+
+    PendingResult completePendingFrame(const char *data, qint64 maxSize, qint64 *pos);
+    AppendResult appendFrame(const char *frame, int length, const SbcFrameHeader &header);
+    void finishPacket();
+    void flushPackets();
+    void hangup();
+
+    MediaTransportStream *q;
+    int m_fd;
+    quint16 m_readMtu;
+    quint16 m_writeMtu;
+    QSocketNotifier *m_readNotifier;
+    QSocketNotifier *m_writeNotifier;
+    QElapsedTimer m_clock;
+
+    // Received frames, stored back to back
+    QByteArray m_recvPacket;
+    QByteArray m_frames;
+    int m_framesPos;
+    QQueue<int> m_frameSizes;
+
+    // Pool of packets for sending, queued packets are [head, head + count)
+    // and the packet being filled (if any) directly follows them
+    int m_poolSize;
+    QByteArray m_pool;
+    QVector<int> m_packetSizes;
+    QVector<int> m_packetFrameBytes;
+    int m_poolHead;
+    int m_poolCount;
+    bool m_packetOpen;
+    int m_packetFrames;
+    qint64 m_queuedBytes;
+    QByteArray m_pendingFrame;
+    quint16 m_sendSequence;
+    quint32 m_sendTimestamp;
+
+    // Statistics of received stream
+    bool m_receiving;
+    quint16 m_lastSequence;
+    quint32 m_lastTimestamp;
+    qint64 m_lastArrival;
+    int m_sampleRate;
+    double m_jitter;
+    quint64 m_packetsReceived;
+    quint64 m_packetsSent;
+    quint64 m_packetsLost;
+    quint64 m_underruns;
+};
+
+} // namespace BluezQt
@@ -0,0 +1,55 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QSharedPointer>
+
+#include <algorithm>
+
+namespace BluezQt
+{
+template<typename T>
+inline T *orderedListItem(T *item)
+{
+    return item;
+}
+
+template<typename T>
+inline T *orderedListItem(const QSharedPointer<T> &item)
+{
+    return item.data();
+}
+
+// Items are kept in the order they were appended, each with a key increasing along the list
+template<typename T, typename Item>
+inline void appendToList(QList<Item> &list, QHash<T *, qint64> &keys, const Item &item)
+{
+    const qint64 key = list.isEmpty() ? 0 : keys.value(orderedListItem(list.last())) + 1;
+    keys.insert(orderedListItem(item), key);
+    list.append(item);
+}
+
+// Removed item is found by binary search over the keys, removing the last item is O(1)
+template<typename T, typename Item>
+inline void removeFromList(QList<Item> &list, QHash<T *, qint64> &keys, const Item &item)
+{
+    const auto it = keys.constFind(orderedListItem(item));
+    if (it == keys.constEnd()) {
+        return;
+    }
+
+    const qint64 key = it.value();
+    const auto pos = std::lower_bound(list.cbegin(), list.cend(), key, [&keys](const Item &candidate, qint64 value) {
+        return keys.value(orderedListItem(candidate)) < value;
+    });
+    list.removeAt(pos - list.cbegin());
+    keys.erase(it);
+}
+
+} // namespace BluezQt
@@ -0,0 +1,237 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "sbcdecoder.h"
+#include "sbcfilter_p.h"
+#include "sbcframe_p.h"
+
+namespace BluezQt
+{
+static const int WINDOW_SIZE = 512;
+static const int MAX_FRAME_SAMPLES = SbcFrameHeader::maxBlocks * SbcFrameHeader::maxSubbands * SbcFrameHeader::maxChannels;
+
+static qint16 saturate(qint32 value)
+{
+    return qint16(qBound(-32768, value, 32767));
+}
+
+class SbcDecoderPrivate
+{
+public:
+    void reset();
+    bool matchesConfiguration(const SbcFrameHeader &header) const;
+    int decodeFrame(const uchar *frame, int size, qint16 *pcm);
+    void synthesize(qint16 *pcm);
+
+    bool m_configured = false;
+    SbcFrameHeader m_configuration;
+    int m_minBitpool = 0;
+    int m_maxBitpool = 0;
+    SbcFrameHeader m_header;
+    quint64 m_crcErrors = 0;
+    SbcWindow<WINDOW_SIZE> m_windows[SbcFrameHeader::maxChannels];
+    // Subband samples divided by two
+    qint16 m_samples[SbcFrameHeader::maxBlocks][SbcFrameHeader::maxChannels][SbcFrameHeader::maxSubbands];
+};
+
+void SbcDecoderPrivate::reset()
+{
+    for (SbcWindow<WINDOW_SIZE> &window : m_windows) {
+        window.reset(10 * m_header.subbands);
+    }
+}
+
+bool SbcDecoderPrivate::matchesConfiguration(const SbcFrameHeader &header) const
+{
+    return header.sampleRate == m_configuration.sampleRate //
+        && header.blocks == m_configuration.blocks //
+        && header.channelMode == m_configuration.channelMode //
+        && header.snrAllocation == m_configuration.snrAllocation //
+        && header.subbands == m_configuration.subbands //
+        && header.bitpool >= m_minBitpool //
+        && header.bitpool <= m_maxBitpool;
+}
+
+int SbcDecoderPrivate::decodeFrame(const uchar *frame, int size, qint16 *pcm)
+{
+    SbcFrameHeader header;
+    if (!header.parse(frame, size)) {
+        return -1;
+    }
+    if (m_configured && !matchesConfiguration(header)) {
+        return -1;
+    }
+
+    const int length = header.frameLength();
+    if (size < length) {
+        return 0;
+    }
+    if (header.crc(frame) != frame[3]) {
+        ++m_crcErrors;
+        return -1;
+    }
+
+    if (header.subbands != m_header.subbands || header.channels() != m_header.channels()) {
+        m_header = header;
+        reset();
+    }
+    m_header = header;
+
+    const int channels = header.channels();
+    const int subbands = header.subbands;
+
+    SbcBitReader reader(frame + SbcFrameHeader::headerSize);
+
+    quint32 join = 0;
+    if (header.channelMode == SbcFrameHeader::JointStereo) {
+        join = reader.read(subbands);
+    }
+
+    int scaleFactors[SbcFrameHeader::maxChannels][SbcFrameHeader::maxSubbands];
+    for (int ch = 0; ch < channels; ++ch) {
+        for (int sb = 0; sb < subbands; ++sb) {
+            scaleFactors[ch][sb] = reader.read(4);
+        }
+    }
+
+    int bits[SbcFrameHeader::maxChannels][SbcFrameHeader::maxSubbands];
+    header.calculateBits(scaleFactors, bits);
+
+    // sb_sample = scale_factor * ((audio_sample * 2 + 1) / levels - 1), computed with
+    // 2^31 / levels in fixed point, scale_factor / 2 is 2^scaleFactors
+    qint64 reciprocals[SbcFrameHeader::maxChannels][SbcFrameHeader::maxSubbands];
+    for (int ch = 0; ch < channels; ++ch) {
+        for (int sb = 0; sb < subbands; ++sb) {
+            reciprocals[ch][sb] = bits[ch][sb] ? (qint64(1) << 31) / ((1 << bits[ch][sb]) - 1) : 0;
+        }
+    }
+
+    for (int blk = 0; blk < header.blocks; ++blk) {
+        for (int ch = 0; ch < channels; ++ch) {
+            for (int sb = 0; sb < subbands; ++sb) {
+                if (!bits[ch][sb]) {
+                    m_samples[blk][ch][sb] = 0;
+                    continue;
+                }
+                const int levels = (1 << bits[ch][sb]) - 1;
+                const int shift = 31 - scaleFactors[ch][sb];
+                const qint64 value = qint64(2 * int(reader.read(bits[ch][sb])) + 1 - levels) * reciprocals[ch][sb];
+                m_samples[blk][ch][sb] = saturate(qint32((value + (qint64(1) << (shift - 1))) >> shift));
+            }
+        }
+    }
+
+    if (join) {
+        for (int sb = 0; sb < subbands; ++sb) {
+            if (!(join & (1 << (subbands - 1 - sb)))) {
+                continue;
+            }
+            for (int blk = 0; blk < header.blocks; ++blk) {
+                const qint32 mid = m_samples[blk][0][sb];
+                const qint32 side = m_samples[blk][1][sb];
+                m_samples[blk][0][sb] = saturate(mid + side);
+                m_samples[blk][1][sb] = saturate(mid - side);
+            }
+        }
+    }
+
+    synthesize(pcm);
+    return length;
+}
+
+void SbcDecoderPrivate::synthesize(qint16 *pcm)
+{
+    const int channels = m_header.channels();
+    const int subbands = m_header.subbands;
+    const qint16 *matrix = SbcFilter::synthesisMatrix(subbands);
+    const qint32 rounding = 1 << (SbcFilter::synthesisShift - 1);
+
+    qint32 out[SbcFrameHeader::maxSubbands];
+    for (int blk = 0; blk < m_header.blocks; ++blk) {
+        for (int ch = 0; ch < channels; ++ch) {
+            // Newest block is first in the window
+            qint16 *block = m_windows[ch].advance(subbands);
+            memcpy(block, m_samples[blk][ch], subbands * sizeof(qint16));
+            SbcFilter::multiply(matrix, m_windows[ch].data(), subbands, 10 * subbands, out);
+
+            for (int i = 0; i < subbands; ++i) {
+                pcm[(blk * subbands + i) * channels + ch] = saturate((out[i] + rounding) >> SbcFilter::synthesisShift);
+            }
+        }
+    }
+}
+
+SbcDecoder::SbcDecoder(const QByteArray &configuration)
+    : d(new SbcDecoderPrivate)
+{
+    if (!configuration.isEmpty()) {
+        d->m_configured = d->m_configuration.parseConfiguration(configuration, &d->m_minBitpool, &d->m_maxBitpool);
+    }
+    if (d->m_configured) {
+        d->m_header = d->m_configuration;
+    }
+    d->reset();
+}
+
+SbcDecoder::~SbcDecoder()
+{
+    delete d;
+}
+
+int SbcDecoder::sampleRate() const
+{
+    return d->m_header.sampleRate;
+}
+
+int SbcDecoder::channels() const
+{
+    return d->m_header.subbands ? d->m_header.channels() : 0;
+}
+
+int SbcDecoder::samplesPerFrame() const
+{
+    return d->m_header.samplesPerFrame();
+}
+
+quint64 SbcDecoder::crcErrors() const
+{
+    return d->m_crcErrors;
+}
+
+int SbcDecoder::decode(const char *frame, int size, qint16 *pcm)
+{
+    return d->decodeFrame(reinterpret_cast<const uchar *>(frame), size, pcm);
+}
+
+QByteArray SbcDecoder::decode(const QByteArray &frames)
+{
+    QByteArray out;
+    qint16 pcm[MAX_FRAME_SAMPLES];
+
+    const uchar *data = reinterpret_cast<const uchar *>(frames.constData());
+    int pos = 0;
+    while (pos < frames.size()) {
+        const int length = d->decodeFrame(data + pos, frames.size() - pos, pcm);
+        if (length == 0) {
+            break;
+        } else if (length < 0) {
+            // Resynchronize on next sync word
+            ++pos;
+            continue;
+        }
+
+        out.append(reinterpret_cast<const char *>(pcm), d->m_header.samplesPerFrame() * d->m_header.channels() * int(sizeof(qint16)));
+        pos += length;
+    }
+    return out;
+}
+
+void SbcDecoder::reset()
+{
+    d->reset();
+}
+
+} // namespace BluezQt
@@ -0,0 +1,113 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include "bluezqt_export.h"
+
+namespace BluezQt
+{
+/**
+ * @class BluezQt::SbcDecoder sbcdecoder.h <BluezQt/SbcDecoder>
+ *
+ * SBC audio decoder.
+ *
+ * This class decodes SBC frames into 16-bit PCM audio. When created with
+ * the configuration negotiated by MediaEndpoint (a2dp_sbc_t structure),
+ * frames not matching the configuration are rejected.
+ *
+ * PCM samples are signed 16-bit in host byte order, channels are interleaved.
+ *
+ * @code
+ * SbcDecoder decoder(configuration);
+ * const QByteArray pcm = decoder.decode(stream->readAll());
+ * @endcode
+ *
+ * @see MediaTransportStream, SbcEncoder
+ */
+class BLUEZQT_EXPORT SbcDecoder
+{
+public:
+    /**
+     * Creates a new SbcDecoder object.
+     *
+     * @param configuration a2dp_sbc_t configuration, frames are not checked if empty
+     */
+    explicit SbcDecoder(const QByteArray &configuration = QByteArray());
+
+    /**
+     * Destroys a SbcDecoder object.
+     */
+    ~SbcDecoder();
+
+    /**
+     * Returns the sample rate.
+     *
+     * Sample rate of the configuration or of the last decoded frame.
+     *
+     * @return sample rate in Hz
+     */
+    int sampleRate() const;
+
+    /**
+     * Returns the number of channels.
+     *
+     * Number of channels of the configuration or of the last decoded frame.
+     *
+     * @return number of channels
+     */
+    int channels() const;
+
+    /**
+     * Returns the number of samples of each channel in the last decoded frame.
+     *
+     * @return samples per frame
+     */
+    int samplesPerFrame() const;
+
+    /**
+     * Returns the number of frames rejected because of invalid CRC.
+     *
+     * @return number of CRC errors
+     */
+    quint64 crcErrors() const;
+
+    /**
+     * Decodes one frame.
+     *
+     * @param frame frame data
+     * @param size size of frame data
+     * @param pcm buffer for samplesPerFrame() samples of each channel, at most 256 samples
+     * @return length of decoded frame, 0 if frame is not complete, -1 if frame is invalid
+     */
+    int decode(const char *frame, int size, qint16 *pcm);
+
+    /**
+     * Decodes frames into PCM data.
+     *
+     * Invalid frames are skipped, trailing incomplete frame is ignored.
+     *
+     * @param frames frames
+     * @return PCM data
+     */
+    QByteArray decode(const QByteArray &frames);
+
+    /**
+     * Resets the filter state.
+     *
+     * Call this when starting to decode a new stream.
+     */
+    void reset();
+
+private:
+    class SbcDecoderPrivate *const d;
+
+    Q_DISABLE_COPY(SbcDecoder)
+};
+
+} // namespace BluezQt
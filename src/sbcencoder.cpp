@@ -0,0 +1,254 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "sbcencoder.h"
+#include "sbcfilter_p.h"
+#include "sbcframe_p.h"
+
+#include <QtAlgorithms>
+
+namespace BluezQt
+{
+static const int WINDOW_SIZE = 512;
+
+// Smallest scale factor with |sample| < 2^(scaleFactor + 1)
+static int scaleFactor(quint32 maxAbs)
+{
+    const int bitLength = 32 - qCountLeadingZeroBits(maxAbs);
+    return qMax(0, bitLength - SbcFilter::analysisShift - 1);
+}
+
+class SbcEncoderPrivate
+{
+public:
+    void reset();
+    void analyze(const qint16 *pcm);
+    void calculateScaleFactors();
+    quint32 applyJointStereo();
+    int encodeFrame(const qint16 *pcm, uchar *frame);
+
+    bool m_valid = false;
+    SbcFrameHeader m_header;
+    int m_minBitpool = 0;
+    int m_maxBitpool = 0;
+    SbcWindow<WINDOW_SIZE> m_windows[SbcFrameHeader::maxChannels];
+    qint32 m_samples[SbcFrameHeader::maxBlocks][SbcFrameHeader::maxChannels][SbcFrameHeader::maxSubbands];
+    int m_scaleFactors[SbcFrameHeader::maxChannels][SbcFrameHeader::maxSubbands];
+};
+
+void SbcEncoderPrivate::reset()
+{
+    for (SbcWindow<WINDOW_SIZE> &window : m_windows) {
+        window.reset(10 * m_header.subbands);
+    }
+}
+
+void SbcEncoderPrivate::analyze(const qint16 *pcm)
+{
+    const int channels = m_header.channels();
+    const int subbands = m_header.subbands;
+    const qint16 *matrix = SbcFilter::analysisMatrix(subbands);
+
+    for (int blk = 0; blk < m_header.blocks; ++blk) {
+        for (int ch = 0; ch < channels; ++ch) {
+            // Newest sample is first in the window
+            qint16 *block = m_windows[ch].advance(subbands);
+            for (int i = 0; i < subbands; ++i) {
+                block[subbands - 1 - i] = pcm[(blk * subbands + i) * channels + ch];
+            }
+            SbcFilter::multiply(matrix, m_windows[ch].data(), subbands, 10 * subbands, m_samples[blk][ch]);
+        }
+    }
+}
+
+void SbcEncoderPrivate::calculateScaleFactors()
+{
+    for (int ch = 0; ch < m_header.channels(); ++ch) {
+        for (int sb = 0; sb < m_header.subbands; ++sb) {
+            quint32 maxAbs = 0;
+            for (int blk = 0; blk < m_header.blocks; ++blk) {
+                maxAbs = qMax(maxAbs, quint32(qAbs(m_samples[blk][ch][sb])));
+            }
+            m_scaleFactors[ch][sb] = scaleFactor(maxAbs);
+        }
+    }
+}
+
+quint32 SbcEncoderPrivate::applyJointStereo()
+{
+    quint32 join = 0;
+
+    // Last subband is never joined
+    for (int sb = 0; sb < m_header.subbands - 1; ++sb) {
+        quint32 maxMid = 0;
+        quint32 maxSide = 0;
+        for (int blk = 0; blk < m_header.blocks; ++blk) {
+            const qint32 left = m_samples[blk][0][sb];
+            const qint32 right = m_samples[blk][1][sb];
+            maxMid = qMax(maxMid, quint32(qAbs((left + right) >> 1)));
+            maxSide = qMax(maxSide, quint32(qAbs((left - right) >> 1)));
+        }
+
+        const int scaleFactorMid = scaleFactor(maxMid);
+        const int scaleFactorSide = scaleFactor(maxSide);
+        if (scaleFactorMid + scaleFactorSide >= m_scaleFactors[0][sb] + m_scaleFactors[1][sb]) {
+            continue;
+        }
+
+        join |= 1 << (m_header.subbands - 1 - sb);
+        m_scaleFactors[0][sb] = scaleFactorMid;
+        m_scaleFactors[1][sb] = scaleFactorSide;
+        for (int blk = 0; blk < m_header.blocks; ++blk) {
+            const qint32 left = m_samples[blk][0][sb];
+            const qint32 right = m_samples[blk][1][sb];
+            m_samples[blk][0][sb] = (left + right) >> 1;
+            m_samples[blk][1][sb] = (left - right) >> 1;
+        }
+    }
+
+    return join;
+}
+
+int SbcEncoderPrivate::encodeFrame(const qint16 *pcm, uchar *frame)
+{
+    const int channels = m_header.channels();
+    const int subbands = m_header.subbands;
+
+    analyze(pcm);
+    calculateScaleFactors();
+
+    quint32 join = 0;
+    if (m_header.channelMode == SbcFrameHeader::JointStereo) {
+        join = applyJointStereo();
+    }
+
+    int bits[SbcFrameHeader::maxChannels][SbcFrameHeader::maxSubbands];
+    m_header.calculateBits(m_scaleFactors, bits);
+
+    // Bitpool does not need to be used completely, unused bits are zero
+    memset(frame, 0, m_header.frameLength());
+    m_header.write(frame);
+
+    SbcBitWriter writer(frame + SbcFrameHeader::headerSize);
+    if (m_header.channelMode == SbcFrameHeader::JointStereo) {
+        writer.write(join, subbands);
+    }
+    for (int ch = 0; ch < channels; ++ch) {
+        for (int sb = 0; sb < subbands; ++sb) {
+            writer.write(m_scaleFactors[ch][sb], 4);
+        }
+    }
+
+    // audio_sample = (sb_sample / scale_factor + 1) * levels / 2
+    for (int blk = 0; blk < m_header.blocks; ++blk) {
+        for (int ch = 0; ch < channels; ++ch) {
+            for (int sb = 0; sb < subbands; ++sb) {
+                if (!bits[ch][sb]) {
+                    continue;
+                }
+                const int shift = m_scaleFactors[ch][sb] + SbcFilter::analysisShift + 1;
+                const qint64 levels = (1 << bits[ch][sb]) - 1;
+                const qint64 sample = ((m_samples[blk][ch][sb] + (qint64(1) << shift)) * levels) >> (shift + 1);
+                writer.write(quint32(qBound<qint64>(0, sample, levels - 1)), bits[ch][sb]);
+            }
+        }
+    }
+    writer.flush();
+
+    frame[3] = m_header.crc(frame);
+    return m_header.frameLength();
+}
+
+SbcEncoder::SbcEncoder(const QByteArray &configuration)
+    : d(new SbcEncoderPrivate)
+{
+    d->m_valid = d->m_header.parseConfiguration(configuration, &d->m_minBitpool, &d->m_maxBitpool);
+    if (d->m_valid) {
+        d->reset();
+    }
+}
+
+SbcEncoder::~SbcEncoder()
+{
+    delete d;
+}
+
+bool SbcEncoder::isValid() const
+{
+    return d->m_valid;
+}
+
+int SbcEncoder::sampleRate() const
+{
+    return d->m_header.sampleRate;
+}
+
+int SbcEncoder::channels() const
+{
+    return d->m_valid ? d->m_header.channels() : 0;
+}
+
+int SbcEncoder::bitpool() const
+{
+    return d->m_header.bitpool;
+}
+
+void SbcEncoder::setBitpool(int bitpool)
+{
+    if (d->m_valid) {
+        d->m_header.bitpool = qBound(d->m_minBitpool, bitpool, d->m_maxBitpool);
+    }
+}
+
+int SbcEncoder::frameLength() const
+{
+    return d->m_valid ? d->m_header.frameLength() : 0;
+}
+
+int SbcEncoder::samplesPerFrame() const
+{
+    return d->m_header.samplesPerFrame();
+}
+
+int SbcEncoder::codeSize() const
+{
+    return d->m_valid ? d->m_header.samplesPerFrame() * d->m_header.channels() * int(sizeof(qint16)) : 0;
+}
+
+int SbcEncoder::encode(const qint16 *pcm, char *frame)
+{
+    if (!d->m_valid) {
+        return -1;
+    }
+    return d->encodeFrame(pcm, reinterpret_cast<uchar *>(frame));
+}
+
+QByteArray SbcEncoder::encode(const QByteArray &pcm)
+{
+    if (!d->m_valid) {
+        return QByteArray();
+    }
+
+    const int codeSize = this->codeSize();
+    const int frameLength = d->m_header.frameLength();
+    const int frames = pcm.size() / codeSize;
+
+    QByteArray out(frames * frameLength, Qt::Uninitialized);
+    for (int i = 0; i < frames; ++i) {
+        const qint16 *samples = reinterpret_cast<const qint16 *>(pcm.constData() + i * codeSize);
+        d->encodeFrame(samples, reinterpret_cast<uchar *>(out.data() + i * frameLength));
+    }
+    return out;
+}
+
+void SbcEncoder::reset()
+{
+    if (d->m_valid) {
+        d->reset();
+    }
+}
+
+} // namespace BluezQt
@@ -0,0 +1,143 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include "bluezqt_export.h"
+
+namespace BluezQt
+{
+/**
+ * @class BluezQt::SbcEncoder sbcencoder.h <BluezQt/SbcEncoder>
+ *
+ * SBC audio encoder.
+ *
+ * This class encodes 16-bit PCM audio into SBC frames using the
+ * configuration negotiated by MediaEndpoint (a2dp_sbc_t structure),
+ * as passed in MediaEndpoint::configurationSelected() or in the
+ * "Configuration" property of the transport.
+ *
+ * PCM samples are signed 16-bit in host byte order, channels are interleaved.
+ *
+ * @code
+ * SbcEncoder encoder(configuration);
+ * stream->write(encoder.encode(pcm));
+ * @endcode
+ *
+ * @see MediaTransportStream, SbcDecoder
+ */
+class BLUEZQT_EXPORT SbcEncoder
+{
+public:
+    /**
+     * Creates a new SbcEncoder object.
+     *
+     * The bitpool is initially set to the maximum bitpool of the configuration.
+     *
+     * @param configuration a2dp_sbc_t configuration
+     */
+    explicit SbcEncoder(const QByteArray &configuration);
+
+    /**
+     * Destroys a SbcEncoder object.
+     */
+    ~SbcEncoder();
+
+    /**
+     * Returns whether the configuration is valid.
+     *
+     * Configuration is valid only if exactly one option is selected in each field.
+     *
+     * @return true if encoder is valid
+     */
+    bool isValid() const;
+
+    /**
+     * Returns the sample rate.
+     *
+     * @return sample rate in Hz
+     */
+    int sampleRate() const;
+
+    /**
+     * Returns the number of channels.
+     *
+     * @return number of channels
+     */
+    int channels() const;
+
+    /**
+     * Returns the bitpool used for encoding.
+     *
+     * @return bitpool
+     */
+    int bitpool() const;
+
+    /**
+     * Sets the bitpool used for encoding.
+     *
+     * The bitpool is bounded by the minimum and maximum bitpool of the configuration.
+     *
+     * @param bitpool bitpool
+     */
+    void setBitpool(int bitpool);
+
+    /**
+     * Returns the length of encoded frame.
+     *
+     * @return frame length in bytes
+     */
+    int frameLength() const;
+
+    /**
+     * Returns the number of samples of each channel in one frame.
+     *
+     * @return samples per frame
+     */
+    int samplesPerFrame() const;
+
+    /**
+     * Returns the size of PCM data encoded into one frame.
+     *
+     * @return PCM size in bytes
+     */
+    int codeSize() const;
+
+    /**
+     * Encodes one frame.
+     *
+     * @param pcm samplesPerFrame() samples of each channel
+     * @param frame buffer of at least frameLength() bytes
+     * @return length of encoded frame or -1 if encoder is not valid
+     */
+    int encode(const qint16 *pcm, char *frame);
+
+    /**
+     * Encodes PCM data into frames.
+     *
+     * Only whole frames are encoded, trailing data shorter than codeSize() is ignored.
+     *
+     * @param pcm PCM data
+     * @return encoded frames
+     */
+    QByteArray encode(const QByteArray &pcm);
+
+    /**
+     * Resets the filter state.
+     *
+     * Call this when starting to encode a new stream.
+     */
+    void reset();
+
+private:
+    class SbcEncoderPrivate *const d;
+
+    Q_DISABLE_COPY(SbcEncoder)
+};
+
+} // namespace BluezQt
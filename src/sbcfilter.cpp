@@ -0,0 +1,400 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "sbcfilter_p.h"
+#include "bluezqt_export.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define BLUEZQT_SBC_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__)
+#define BLUEZQT_SBC_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define BLUEZQT_SBC_NEON
+#include <arm_neon.h>
+#endif
+
+namespace BluezQt
+{
+// Fixed-point matrices derived from prototype filter coefficients p[i] of
+// A2DP specification, tables 12.23 and 12.24, with M subbands:
+//
+//   analysis[k][i] = round(p[i] * cos((k + 0.5) * ((i % 2M) - M / 2) * pi / M) * 2^analysisShift)
+//
+// Output j of synthesis takes block i of the window from V[j] or V[j + M],
+// with n = j + (i % 2) * M and window coefficients -M * p:
+//
+//   synthesis[j][i * M + sb] = round(2 * -M * p[j + M * i] * cos((sb + 0.5) * (n + M / 2) * pi / M) * 2^synthesisShift)
+
+alignas(32) static const qint16 analysis4[160] = {
+    // Row 0
+    0, 8, 24, 41, 44, 24, 0, 19, 126, 309,
+    473, 487, 300, 38, 0, 487, 1571, 2952, 4041, 4266,
+    3410, 1767, 0, -1223, -1571, -1175, -472, 93, 300, 202,
+    0, -128, -126, -46, 31, 59, 44, 17, 0, -3,
+    // Row 1
+    0, 3, 24, 17, -44, -59, 0, -46, -126, 128,
+    473, 202, -300, -93, 0, -1175, -1571, 1223, 4041, 1767,
+    -3410, -4266, 0, 2952, 1571, -487, -472, 38, -300, -487,
+    0, 309, 126, -19, 31, 24, -44, -41, 0, 8,
+    // Row 2
+    0, -3, 24, -17, -44, 59, 0, 46, -126, -128,
+    473, -202, -300, 93, 0, 1175, -1571, -1223, 4041, -1767,
+    -3410, 4266, 0, -2952, 1571, 487, -472, -38, -300, 487,
+    0, -309, 126, 19, 31, -24, -44, 41, 0, -8,
+    // Row 3
+    0, -8, 24, -41, 44, -24, 0, -19, 126, -309,
+    473, -487, 300, -38, 0, -487, 1571, -2952, 4041, -4266,
+    3410, -1767, 0, 1223, -1571, 1175, -472, -93, 300, -202,
+    0, 128, -126, 46, 31, -59, 44, -17, 0, 3,
+};
+
+alignas(32) static const qint16 analysis8[640] = {
+    // Row 0
+    0, 2, 5, 9, 13, 18, 22, 24, 23, 19,
+    13, 5, 0, 1, 10, 32, 66, 109, 158, 205,
+    240, 256, 246, 209, 150, 81, 18, -16, 0, 83,
+    245, 484, 788, 1130, 1477, 1787, 2020, 2141, 2131, 1981,
+    1703, 1323, 883, 426, 0, -355, -612, -755, -788, -725,
+    -591, -420, -240, -79, 44, 121, 150, 139, 102, 51,
+    0, -41, -66, -73, -66, -48, -25, -3, 15, 26,
+    30, 29, 23, 16, 9, 4, 0, -2, -2, -1,
+    // Row 1
+    0, -1, 2, 8, 13, 16, 9, -6, -23, -34,
+    -30, -15, 0, -2, -25, -56, -66, -26, 66, 174,
+    240, 217, 102, -49, -150, -142, -44, 45, 0, -238,
+    -591, -855, -788, -265, 612, 1515, 2020, 1815, 883, -465,
+    -1703, -2336, -2131, -1213, 0, 1012, 1477, 1333, 788, 170,
+    -245, -356, -240, -67, 18, -28, -150, -246, -246, -145,
+    0, 116, 158, 129, 66, 11, -10, -2, 15, 22,
+    13, -7, -23, -29, -22, -10, 0, 5, 5, 3,
+    // Row 2
+    0, -3, -2, 5, 13, 10, -9, -29, -23, 7,
+    30, 22, 0, 2, 25, 11, -66, -129, -66, 116,
+    240, 145, -102, -246, -150, 28, 44, -67, 0, 356,
+    591, 170, -788, -1333, -612, 1012, 2020, 1213, -883, -2336,
+    -1703, 465, 2131, 1815, 0, -1515, -1477, -265, 788, 855,
+    245, -238, -240, -45, -18, -142, -150, 49, 246, 217,
+    0, -174, -158, -26, 66, 56, 10, -2, 15, 15,
+    -13, -34, -23, 6, 22, 16, 0, -8, -5, -1,
+    // Row 3
+    0, -1, -5, 2, 13, 4, -22, -16, 23, 29,
+    -13, -26, 0, -3, -10, 48, 66, -73, -158, 41,
+    240, 51, -246, -139, 150, 121, -18, 79, 0, -420,
+    -245, 725, 788, -755, -1477, 355, 2020, 426, -2131, -1323,
+    1703, 1981, -883, -2141, 0, 1787, 612, -1130, -788, 484,
+    591, -83, -240, -16, -44, -81, 150, 209, -102, -256,
+    0, 205, 66, -109, -66, 32, 25, -1, 15, 5,
+    -30, -19, 23, 24, -9, -18, 0, 9, 2, -2,
+    // Row 4
+    0, 1, -5, -2, 13, -4, -22, 16, 23, -29,
+    -13, 26, 0, 3, -10, -48, 66, 73, -158, -41,
+    240, -51, -246, 139, 150, -121, -18, -79, 0, 420,
+    -245, -725, 788, 755, -1477, -355, 2020, -426, -2131, 1323,
+    1703, -1981, -883, 2141, 0, -1787, 612, 1130, -788, -484,
+    591, 83, -240, 16, -44, 81, 150, -209, -102, 256,
+    0, -205, 66, 109, -66, -32, 25, 1, 15, -5,
+    -30, 19, 23, -24, -9, 18, 0, -9, 2, 2,
+    // Row 5
+    0, 3, -2, -5, 13, -10, -9, 29, -23, -7,
+    30, -22, 0, -2, 25, -11, -66, 129, -66, -116,
+    240, -145, -102, 246, -150, -28, 44, 67, 0, -356,
+    591, -170, -788, 1333, -612, -1012, 2020, -1213, -883, 2336,
+    -1703, -465, 2131, -1815, 0, 1515, -1477, 265, 788, -855,
+    245, 238, -240, 45, -18, 142, -150, -49, 246, -217,
+    0, 174, -158, 26, 66, -56, 10, 2, 15, -15,
+    -13, 34, -23, -6, 22, -16, 0, 8, -5, 1,
+    // Row 6
+    0, 1, 2, -8, 13, -16, 9, 6, -23, 34,
+    -30, 15, 0, 2, -25, 56, -66, 26, 66, -174,
+    240, -217, 102, 49, -150, 142, -44, -45, 0, 238,
+    -591, 855, -788, 265, 612, -1515, 2020, -1815, 883, 465,
+    -1703, 2336, -2131, 1213, 0, -1012, 1477, -1333, 788, -170,
+    -245, 356, -240, 67, 18, 28, -150, 246, -246, 145,
+    0, -116, 158, -129, 66, -11, -10, 2, 15, -22,
+    13, 7, -23, 29, -22, 10, 0, -5, 5, -3,
+    // Row 7
+    0, -2, 5, -9, 13, -18, 22, -24, 23, -19,
+    13, -5, 0, -1, 10, -32, 66, -109, 158, -205,
+    240, -256, 246, -209, 150, -81, 18, 16, 0, -83,
+    245, -484, 788, -1130, 1477, -1787, 2020, -2141, 2131, -1981,
+    1703, -1323, 883, -426, 0, 355, -612, 755, -788, 725,
+    -591, 420, -240, 79, 44, -121, 150, -139, 102, -51,
+    0, 41, -66, 73, -66, 48, -25, 3, 15, -26,
+    30, -29, 23, -16, 9, -4, 0, 2, -2, 1,
+};
+
+alignas(32) static const qint16 synthesis4[160] = {
+    // Row 0
+    0, 0, 0, 0, 44, -44, -44, 44, -126, 126,
+    126, -126, 300, -300, -300, 300, -1571, 1571, 1571, -1571,
+    3410, -3410, -3410, 3410, 1571, -1571, -1571, 1571, 300, -300,
+    -300, 300, 126, -126, -126, 126, 44, -44, -44, 44,
+    // Row 1
+    -3, 8, -8, 3, 59, 24, -24, -59, -128, 309,
+    -309, 128, 93, 38, -38, -93, -1223, 2952, -2952, 1223,
+    4266, 1767, -1767, -4266, 487, -1175, 1175, -487, 487, 202,
+    -202, -487, 19, -46, 46, -19, 41, 17, -17, -41,
+    // Row 2
+    0, 0, 0, 0, 31, 31, 31, 31, 0, 0,
+    0, 0, -472, -472, -472, -472, 0, 0, 0, 0,
+    4041, 4041, 4041, 4041, 0, 0, 0, 0, 473, 473,
+    473, 473, 0, 0, 0, 0, 24, 24, 24, 24,
+    // Row 3
+    17, -41, 41, -17, -46, -19, 19, 46, 202, -487,
+    487, -202, -1175, -487, 487, 1175, 1767, -4266, 4266, -1767,
+    2952, 1223, -1223, -2952, 38, -93, 93, -38, 309, 128,
+    -128, -309, 24, -59, 59, -24, 8, 3, -3, -8,
+};
+
+alignas(32) static const qint16 synthesis8[640] = {
+    // Row 0
+    0, 0, 0, 0, 0, 0, 0, 0, 47, -47,
+    -47, 47, 47, -47, -47, 47, -131, 131, 131, -131,
+    -131, 131, 131, -131, 300, -300, -300, 300, 300, -300,
+    -300, 300, -1576, 1576, 1576, -1576, -1576, 1576, 1576, -1576,
+    3405, -3405, -3405, 3405, 3405, -3405, -3405, 3405, 1576, -1576,
+    -1576, 1576, 1576, -1576, -1576, 1576, 300, -300, -300, 300,
+    300, -300, -300, 300, 131, -131, -131, 131, 131, -131,
+    -131, 131, 47, -47, -47, 47, 47, -47, -47, 47,
+    // Row 1
+    -3, 5, -1, -4, 4, 1, -5, 3, 57, -13,
+    -68, -38, 38, 68, 13, -57, -146, 258, -51, -219,
+    219, 51, -258, 146, 241, -57, -285, -161, 161, 285,
+    57, -241, -1511, 2667, -530, -2261, 2261, 530, -2667, 1511,
+    3961, -929, -4673, -2647, 2647, 4673, 929, -3961, 968, -1709,
+    340, 1449, -1449, -340, 1709, -968, 417, -98, -492, -279,
+    279, 492, 98, -417, 64, -112, 22, 95, -95, -22,
+    112, -64, 49, -11, -57, -32, 32, 57, 11, -49,
+    // Row 2
+    -4, 10, -10, 4, 4, -10, 10, -4, 60, 25,
+    -25, -60, -60, -25, 25, 60, -131, 317, -317, 131,
+    131, -317, 317, -131, 89, 37, -37, -89, -89, -37,
+    37, 89, -1224, 2954, -2954, 1224, 1224, -2954, 2954, -1224,
+    4261, 1765, -1765, -4261, -4261, -1765, 1765, 4261, 490, -1183,
+    1183, -490, -490, 1183, -1183, 490, 491, 203, -203, -491,
+    -491, -203, 203, 491, 21, -50, 50, -21, -21, 50,
+    -50, 21, 45, 19, -19, -45, -45, -19, 19, 45,
+    // Row 3
+    -4, 10, -15, 18, -18, 15, -10, 4, 52, 44,
+    29, 10, -10, -29, -44, -52, -81, 232, -347, 410,
+    -410, 347, -232, 81, -158, -134, -89, -31, 31, 89,
+    134, 158, -711, 2024, -3030, 3574, -3574, 3030, -2024, 711,
+    4283, 3631, 2426, 852, -852, -2426, -3631, -4283, 167, -475,
+    711, -839, 839, -711, 475, -167, 511, 433, 290, 102,
+    -102, -290, -433, -511, 1, -3, 5, -6, 6, -5,
+    3, -1, 37, 31, 21, 7, -7, -21, -31, -37,
+    // Row 4
+    0, 0, 0, 0, 0, 0, 0, 0, 30, 30,
+    30, 30, 30, 30, 30, 30, 0, 0, 0, 0,
+    0, 0, 0, 0, -480, -480, -480, -480, -480, -480,
+    -480, -480, 0, 0, 0, 0, 0, 0, 0, 0,
+    4039, 4039, 4039, 4039, 4039, 4039, 4039, 4039, 0, 0,
+    0, 0, 0, 0, 0, 0, 480, 480, 480, 480,
+    480, 480, 480, 480, 0, 0, 0, 0, 0, 0,
+    0, 0, 27, 27, 27, 27, 27, 27, 27, 27,
+    // Row 5
+    7, -21, 31, -37, 37, -31, 21, -7, -6, -5,
+    -3, -1, 1, 3, 5, 6, 102, -290, 433, -511,
+    511, -433, 290, -102, -839, -711, -475, -167, 167, 475,
+    711, 839, 852, -2426, 3631, -4283, 4283, -3631, 2426, -852,
+    3574, 3030, 2024, 711, -711, -2024, -3030, -3574, -31, 89,
+    -134, 158, -158, 134, -89, 31, 410, 347, 232, 81,
+    -81, -232, -347, -410, 10, -29, 44, -52, 52, -44,
+    29, -10, 18, 15, 10, 4, -4, -10, -15, -18,
+    // Row 6
+    19, -45, 45, -19, -19, 45, -45, 19, -50, -21,
+    21, 50, 50, 21, -21, -50, 203, -491, 491, -203,
+    -203, 491, -491, 203, -1183, -490, 490, 1183, 1183, 490,
+    -490, -1183, 1765, -4261, 4261, -1765, -1765, 4261, -4261, 1765,
+    2954, 1224, -1224, -2954, -2954, -1224, 1224, 2954, 37, -89,
+    89, -37, -37, 89, -89, 37, 317, 131, -131, -317,
+    -317, -131, 131, 317, 25, -60, 60, -25, -25, 60,
+    -60, 25, 10, 4, -4, -10, -10, -4, 4, 10,
+    // Row 7
+    32, -57, 11, 49, -49, -11, 57, -32, -95, 22,
+    112, 64, -64, -112, -22, 95, 279, -492, 98, 417,
+    -417, -98, 492, -279, -1449, 340, 1709, 968, -968, -1709,
+    -340, 1449, 2647, -4673, 929, 3961, -3961, -929, 4673, -2647,
+    2261, -530, -2667, -1511, 1511, 2667, 530, -2261, 161, -285,
+    57, 241, -241, -57, 285, -161, 219, -51, -258, -146,
+    146, 258, 51, -219, 38, -68, 13, 57, -57, -13,
+    68, -38, 4, -1, -5, -3, 3, 5, 1, -4,
+};
+
+static void multiplyScalar(const qint16 *matrix, const qint16 *vector, int rows, int length, qint32 *out)
+{
+    for (int row = 0; row < rows; ++row) {
+        const qint16 *coefficients = matrix + row * length;
+        qint32 sum = 0;
+        for (int i = 0; i < length; ++i) {
+            sum += qint32(coefficients[i]) * vector[i];
+        }
+        out[row] = sum;
+    }
+}
+
+#ifdef BLUEZQT_SBC_SSE2
+static inline qint32 horizontalSum(__m128i sum)
+{
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+
+static void multiplySse2(const qint16 *matrix, const qint16 *vector, int rows, int length, qint32 *out)
+{
+    for (int row = 0; row < rows; ++row) {
+        const qint16 *coefficients = matrix + row * length;
+        __m128i sum = _mm_setzero_si128();
+        for (int i = 0; i < length; i += 8) {
+            const __m128i c = _mm_load_si128(reinterpret_cast<const __m128i *>(coefficients + i));
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(vector + i));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(c, v));
+        }
+        out[row] = horizontalSum(sum);
+    }
+}
+#endif
+
+#ifdef BLUEZQT_SBC_AVX2
+__attribute__((target("avx2"))) static void multiplyAvx2(const qint16 *matrix, const qint16 *vector, int rows, int length, qint32 *out)
+{
+    for (int row = 0; row < rows; ++row) {
+        const qint16 *coefficients = matrix + row * length;
+        __m256i sum = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 16 <= length; i += 16) {
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(coefficients + i));
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(vector + i));
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(c, v));
+        }
+
+        __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        if (i < length) {
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(coefficients + i));
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(vector + i));
+            half = _mm_add_epi32(half, _mm_madd_epi16(c, v));
+        }
+        out[row] = horizontalSum(half);
+    }
+}
+#endif
+
+#ifdef BLUEZQT_SBC_NEON
+static void multiplyNeon(const qint16 *matrix, const qint16 *vector, int rows, int length, qint32 *out)
+{
+    for (int row = 0; row < rows; ++row) {
+        const qint16 *coefficients = matrix + row * length;
+        int32x4_t sum = vdupq_n_s32(0);
+        for (int i = 0; i < length; i += 8) {
+            const int16x8_t c = vld1q_s16(coefficients + i);
+            const int16x8_t v = vld1q_s16(vector + i);
+            sum = vmlal_s16(sum, vget_low_s16(c), vget_low_s16(v));
+            sum = vmlal_s16(sum, vget_high_s16(c), vget_high_s16(v));
+        }
+#ifdef __aarch64__
+        out[row] = vaddvq_s32(sum);
+#else
+        int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+        out[row] = vget_lane_s32(vpadd_s32(pair, pair), 0);
+#endif
+    }
+}
+#endif
+
+typedef void (*MultiplyFunction)(const qint16 *, const qint16 *, int, int, qint32 *);
+
+static MultiplyFunction multiplyFunction(SbcFilter::Implementation implementation)
+{
+    switch (implementation) {
+    case SbcFilter::Scalar:
+        return multiplyScalar;
+#ifdef BLUEZQT_SBC_SSE2
+    case SbcFilter::Sse2:
+        return multiplySse2;
+#endif
+#ifdef BLUEZQT_SBC_AVX2
+    case SbcFilter::Avx2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? multiplyAvx2 : nullptr;
+#endif
+#ifdef BLUEZQT_SBC_NEON
+    case SbcFilter::Neon:
+        return multiplyNeon;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+static SbcFilter::Implementation bestImplementation()
+{
+    const SbcFilter::Implementation preferred[] = {SbcFilter::Avx2, SbcFilter::Sse2, SbcFilter::Neon};
+    for (SbcFilter::Implementation implementation : preferred) {
+        if (multiplyFunction(implementation)) {
+            return implementation;
+        }
+    }
+    return SbcFilter::Scalar;
+}
+
+static SbcFilter::Implementation s_implementation = bestImplementation();
+static MultiplyFunction s_multiply = multiplyFunction(s_implementation);
+
+const qint16 *SbcFilter::analysisMatrix(int subbands)
+{
+    return subbands == 4 ? analysis4 : analysis8;
+}
+
+const qint16 *SbcFilter::synthesisMatrix(int subbands)
+{
+    return subbands == 4 ? synthesis4 : synthesis8;
+}
+
+void SbcFilter::multiply(const qint16 *matrix, const qint16 *vector, int rows, int length, qint32 *out)
+{
+    s_multiply(matrix, vector, rows, length, out);
+}
+
+SbcFilter::Implementation SbcFilter::implementation()
+{
+    return s_implementation;
+}
+
+bool SbcFilter::isSupported(Implementation implementation)
+{
+    return multiplyFunction(implementation);
+}
+
+bool SbcFilter::setImplementation(Implementation implementation)
+{
+    const MultiplyFunction function = multiplyFunction(implementation);
+    if (!function) {
+        return false;
+    }
+
+    s_implementation = implementation;
+    s_multiply = function;
+    return true;
+}
+
+// For autotests
+BLUEZQT_EXPORT bool bluezqt_setSbcFilterImplementation(int implementation)
+{
+    return SbcFilter::setImplementation(SbcFilter::Implementation(implementation));
+}
+
+BLUEZQT_EXPORT void bluezqt_resetSbcFilterImplementation()
+{
+    SbcFilter::setImplementation(bestImplementation());
+}
+
+} // namespace BluezQt
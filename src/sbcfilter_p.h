@@ -0,0 +1,80 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <cstring>
+
+namespace BluezQt
+{
+// Polyphase filterbank of SBC, see A2DP specification section 12.5
+//
+// Both analysis and synthesis of one block are computed as a product of
+// subbands x (10 * subbands) fixed-point matrix with a window of the last
+// ten blocks. Integer arithmetic makes all implementations bit-exact.
+class SbcFilter
+{
+public:
+    enum Implementation {
+        Scalar,
+        Sse2,
+        Avx2,
+        Neon,
+    };
+
+    // Analysis output is subband samples scaled by 2^analysisShift
+    static const int analysisShift = 14;
+    // Synthesis input is subband samples divided by two, output is scaled by 2^synthesisShift
+    static const int synthesisShift = 11;
+
+    static const qint16 *analysisMatrix(int subbands);
+    static const qint16 *synthesisMatrix(int subbands);
+
+    // out[row] = sum of matrix[row * length + i] * vector[i], length is multiple of 8
+    static void multiply(const qint16 *matrix, const qint16 *vector, int rows, int length, qint32 *out);
+
+    static Implementation implementation();
+    static bool isSupported(Implementation implementation);
+    static bool setImplementation(Implementation implementation);
+};
+
+// Sliding window of blocks, newest sample first
+template<int Size>
+class SbcWindow
+{
+public:
+    // Returns space for the next block of given size, the window then starts there
+    qint16 *advance(int blockSize)
+    {
+        if (m_pos < blockSize) {
+            memmove(m_buffer + Size - m_length + blockSize, m_buffer + m_pos, (m_length - blockSize) * sizeof(qint16));
+            m_pos = Size - m_length + blockSize;
+        }
+        m_pos -= blockSize;
+        return m_buffer + m_pos;
+    }
+
+    const qint16 *data() const
+    {
+        return m_buffer + m_pos;
+    }
+
+    void reset(int length)
+    {
+        memset(m_buffer, 0, sizeof(m_buffer));
+        m_length = length;
+        m_pos = Size - length;
+    }
+
+private:
+    qint16 m_buffer[Size];
+    int m_length = Size;
+    int m_pos = 0;
+};
+
+} // namespace BluezQt
@@ -0,0 +1,337 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "sbcframe_p.h"
+#include "a2dp-codecs.h"
+
+#include <QByteArray>
+
+namespace BluezQt
+{
+static const int sampleRates[] = {16000, 32000, 44100, 48000};
+
+// Loudness offsets of A2DP specification, tables 12.18 and 12.19
+static const int loudnessOffsets4[4][4] = {
+    {-1, 0, 0, 0},
+    {-2, 0, 0, 1},
+    {-2, 0, 0, 1},
+    {-2, 0, 0, 1},
+};
+
+static const int loudnessOffsets8[4][8] = {
+    {-2, 0, 0, 0, 0, 0, 0, 1},
+    {-3, 0, 0, 0, 0, 0, 1, 2},
+    {-4, 0, 0, 0, 0, 0, 1, 2},
+    {-4, 0, 0, 0, 0, 0, 1, 2},
+};
+
+static int sampleRateIndex(int sampleRate)
+{
+    for (int i = 0; i < 4; ++i) {
+        if (sampleRates[i] == sampleRate) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Distributes bitpool over subbands of given channels, channels are interleaved
+static void allocateBits(const int bitneed[][SbcFrameHeader::maxSubbands],
+                         int bits[][SbcFrameHeader::maxSubbands],
+                         int channels,
+                         int subbands,
+                         int bitpool)
+{
+    int maxBitneed = 0;
+    for (int ch = 0; ch < channels; ++ch) {
+        for (int sb = 0; sb < subbands; ++sb) {
+            maxBitneed = qMax(maxBitneed, bitneed[ch][sb]);
+        }
+    }
+
+    int bitcount = 0;
+    int slicecount = 0;
+    int bitslice = maxBitneed + 1;
+    do {
+        --bitslice;
+        bitcount += slicecount;
+        slicecount = 0;
+        for (int ch = 0; ch < channels; ++ch) {
+            for (int sb = 0; sb < subbands; ++sb) {
+                if (bitneed[ch][sb] > bitslice + 1 && bitneed[ch][sb] < bitslice + 16) {
+                    ++slicecount;
+                } else if (bitneed[ch][sb] == bitslice + 1) {
+                    slicecount += 2;
+                }
+            }
+        }
+    } while (bitcount + slicecount < bitpool);
+
+    if (bitcount + slicecount == bitpool) {
+        bitcount += slicecount;
+        --bitslice;
+    }
+
+    for (int ch = 0; ch < channels; ++ch) {
+        for (int sb = 0; sb < subbands; ++sb) {
+            bits[ch][sb] = bitneed[ch][sb] < bitslice + 2 ? 0 : qMin(bitneed[ch][sb] - bitslice, 16);
+        }
+    }
+
+    int ch = 0;
+    int sb = 0;
+    while (bitcount < bitpool && sb < subbands) {
+        if (bits[ch][sb] >= 2 && bits[ch][sb] < 16) {
+            ++bits[ch][sb];
+            ++bitcount;
+        } else if (bitneed[ch][sb] == bitslice + 1 && bitpool > bitcount + 1) {
+            bits[ch][sb] = 2;
+            bitcount += 2;
+        }
+        if (++ch == channels) {
+            ch = 0;
+            ++sb;
+        }
+    }
+
+    ch = 0;
+    sb = 0;
+    while (bitcount < bitpool && sb < subbands) {
+        if (bits[ch][sb] < 16) {
+            ++bits[ch][sb];
+            ++bitcount;
+        }
+        if (++ch == channels) {
+            ch = 0;
+            ++sb;
+        }
+    }
+}
+
+bool SbcFrameHeader::parse(const uchar *data, int size)
+{
+    if (size < headerSize || data[0] != syncWord) {
+        return false;
+    }
+
+    sampleRate = sampleRates[(data[1] >> 6) & 0x03];
+    blocks = 4 * (((data[1] >> 4) & 0x03) + 1);
+    channelMode = ChannelMode((data[1] >> 2) & 0x03);
+    snrAllocation = data[1] & 0x02;
+    subbands = (data[1] & 0x01) ? 8 : 4;
+    bitpool = data[2];
+
+    return bitpool >= 2 && bitpool <= bitpoolLimit();
+}
+
+bool SbcFrameHeader::parseConfiguration(const QByteArray &configuration, int *minBitpool, int *maxBitpool)
+{
+    if (configuration.size() != sizeof(a2dp_sbc_t)) {
+        return false;
+    }
+
+    const a2dp_sbc_t sbc = *reinterpret_cast<const a2dp_sbc_t *>(configuration.constData());
+
+    switch (sbc.frequency) {
+    case SBC_SAMPLING_FREQ_16000:
+        sampleRate = 16000;
+        break;
+    case SBC_SAMPLING_FREQ_32000:
+        sampleRate = 32000;
+        break;
+    case SBC_SAMPLING_FREQ_44100:
+        sampleRate = 44100;
+        break;
+    case SBC_SAMPLING_FREQ_48000:
+        sampleRate = 48000;
+        break;
+    default:
+        return false;
+    }
+
+    switch (sbc.channel_mode) {
+    case SBC_CHANNEL_MODE_MONO:
+        channelMode = Mono;
+        break;
+    case SBC_CHANNEL_MODE_DUAL_CHANNEL:
+        channelMode = DualChannel;
+        break;
+    case SBC_CHANNEL_MODE_STEREO:
+        channelMode = Stereo;
+        break;
+    case SBC_CHANNEL_MODE_JOINT_STEREO:
+        channelMode = JointStereo;
+        break;
+    default:
+        return false;
+    }
+
+    switch (sbc.block_length) {
+    case SBC_BLOCK_LENGTH_4:
+        blocks = 4;
+        break;
+    case SBC_BLOCK_LENGTH_8:
+        blocks = 8;
+        break;
+    case SBC_BLOCK_LENGTH_12:
+        blocks = 12;
+        break;
+    case SBC_BLOCK_LENGTH_16:
+        blocks = 16;
+        break;
+    default:
+        return false;
+    }
+
+    switch (sbc.subbands) {
+    case SBC_SUBBANDS_4:
+        subbands = 4;
+        break;
+    case SBC_SUBBANDS_8:
+        subbands = 8;
+        break;
+    default:
+        return false;
+    }
+
+    switch (sbc.allocation_method) {
+    case SBC_ALLOCATION_SNR:
+        snrAllocation = true;
+        break;
+    case SBC_ALLOCATION_LOUDNESS:
+        snrAllocation = false;
+        break;
+    default:
+        return false;
+    }
+
+    if (sbc.min_bitpool < MIN_BITPOOL || sbc.min_bitpool > sbc.max_bitpool) {
+        return false;
+    }
+
+    *minBitpool = sbc.min_bitpool;
+    *maxBitpool = qMin<int>(sbc.max_bitpool, bitpoolLimit());
+    bitpool = *maxBitpool;
+    return *minBitpool <= *maxBitpool;
+}
+
+void SbcFrameHeader::write(uchar *data) const
+{
+    data[0] = syncWord;
+    data[1] = uchar(sampleRateIndex(sampleRate) << 6);
+    data[1] |= uchar((blocks / 4 - 1) << 4);
+    data[1] |= uchar(channelMode << 2);
+    data[1] |= snrAllocation ? 0x02 : 0x00;
+    data[1] |= subbands == 8 ? 0x01 : 0x00;
+    data[2] = uchar(bitpool);
+}
+
+quint8 SbcFrameHeader::crc(const uchar *frame) const
+{
+    // CRC-8 with polynomial x^8 + x^4 + x^3 + x^2 + 1, sync word and CRC itself are skipped
+    quint8 crc = 0x0F;
+    auto update = [&crc](uchar octet, int count) {
+        for (int i = 0; i < count; ++i) {
+            const bool bit = (octet ^ crc) & 0x80;
+            crc = quint8(crc << 1) ^ (bit ? 0x1D : 0x00);
+            octet <<= 1;
+        }
+    };
+
+    update(frame[1], 8);
+    update(frame[2], 8);
+
+    int bits = 4 * subbands * channels() + (channelMode == JointStereo ? subbands : 0);
+    for (const uchar *data = frame + headerSize; bits > 0; ++data, bits -= 8) {
+        update(*data, qMin(bits, 8));
+    }
+    return crc;
+}
+
+void SbcFrameHeader::calculateBits(const int scaleFactors[maxChannels][maxSubbands], int bits[maxChannels][maxSubbands]) const
+{
+    const int rateIndex = sampleRateIndex(sampleRate);
+    const int *offsets = subbands == 4 ? loudnessOffsets4[rateIndex] : loudnessOffsets8[rateIndex];
+
+    int bitneed[maxChannels][maxSubbands];
+    for (int ch = 0; ch < channels(); ++ch) {
+        for (int sb = 0; sb < subbands; ++sb) {
+            if (snrAllocation) {
+                bitneed[ch][sb] = scaleFactors[ch][sb];
+            } else if (scaleFactors[ch][sb] == 0) {
+                bitneed[ch][sb] = -5;
+            } else {
+                const int loudness = scaleFactors[ch][sb] - offsets[sb];
+                bitneed[ch][sb] = loudness > 0 ? loudness / 2 : loudness;
+            }
+        }
+    }
+
+    // Bitpool is shared by both channels only in stereo modes
+    if (channelMode == Mono || channelMode == DualChannel) {
+        for (int ch = 0; ch < channels(); ++ch) {
+            allocateBits(bitneed + ch, bits + ch, 1, subbands, bitpool);
+        }
+    } else {
+        allocateBits(bitneed, bits, 2, subbands, bitpool);
+    }
+}
+
+int SbcFrameHeader::channels() const
+{
+    return channelMode == Mono ? 1 : 2;
+}
+
+int SbcFrameHeader::frameLength() const
+{
+    const int scaleFactors = subbands * channels() / 2;
+
+    int bits;
+    switch (channelMode) {
+    case Mono:
+    case DualChannel:
+        bits = blocks * channels() * bitpool;
+        break;
+    case Stereo:
+        bits = blocks * bitpool;
+        break;
+    case JointStereo:
+    default:
+        bits = subbands + blocks * bitpool;
+        break;
+    }
+
+    return headerSize + scaleFactors + (bits + 7) / 8;
+}
+
+int SbcFrameHeader::samplesPerFrame() const
+{
+    return blocks * subbands;
+}
+
+int SbcFrameHeader::bitpoolLimit() const
+{
+    // Bitpool limits from the SBC specification
+    const int limit = (channelMode == Mono || channelMode == DualChannel) ? 16 * subbands : 32 * subbands;
+    return qMin(limit, 250);
+}
+
+int SbcFrameHeader::bitrate() const
+{
+    return int(qint64(frameLength()) * 8 * sampleRate / samplesPerFrame());
+}
+
+int SbcFrameHeader::framesPerPacket(int mtu) const
+{
+    return qBound(0, (mtu - packetHeaderSize) / frameLength(), int(maxFramesPerPacket));
+}
+
+int SbcFrameHeader::packetLatency(int mtu) const
+{
+    return int(qint64(framesPerPacket(mtu)) * samplesPerFrame() * 1000000 / sampleRate);
+}
+
+} // namespace BluezQt
@@ -0,0 +1,130 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+class QByteArray;
+
+namespace BluezQt
+{
+// Header of SBC frame as defined in A2DP specification, section 12.6
+struct SbcFrameHeader {
+    enum ChannelMode {
+        Mono = 0,
+        DualChannel = 1,
+        Stereo = 2,
+        JointStereo = 3,
+    };
+
+    static const quint8 syncWord = 0x9C;
+    static const int headerSize = 4;
+    static const int maxChannels = 2;
+    static const int maxBlocks = 16;
+    static const int maxSubbands = 8;
+
+    // RTP header and SBC payload header of media packet, see A2DP specification section 4.3.4
+    static const int packetHeaderSize = 13;
+    static const int maxFramesPerPacket = 15;
+
+    int sampleRate = 0;
+    int blocks = 0;
+    ChannelMode channelMode = Mono;
+    bool snrAllocation = false;
+    int subbands = 0;
+    int bitpool = 0;
+
+    // Parses frame header, returns false if data does not start with valid header
+    bool parse(const uchar *data, int size);
+
+    // Sets parameters from a2dp_sbc_t configuration, only one option may be selected in each field
+    bool parseConfiguration(const QByteArray &configuration, int *minBitpool, int *maxBitpool);
+
+    // Writes header without the CRC
+    void write(uchar *data) const;
+
+    // CRC of header, join flags and scale factors of complete frame
+    quint8 crc(const uchar *frame) const;
+
+    // Bit allocation as defined in A2DP specification, section 12.6.3
+    void calculateBits(const int scaleFactors[maxChannels][maxSubbands], int bits[maxChannels][maxSubbands]) const;
+
+    int channels() const;
+    int frameLength() const;
+    int samplesPerFrame() const;
+
+    // Highest bitpool allowed by SBC specification for channel mode and subbands
+    int bitpoolLimit() const;
+
+    // Bits per second of stream
+    int bitrate() const;
+
+    // Frames in full media packet and their duration in microseconds
+    int framesPerPacket(int mtu) const;
+    int packetLatency(int mtu) const;
+};
+
+// Writes MSB first fields of at most 16 bits
+class SbcBitWriter
+{
+public:
+    explicit SbcBitWriter(uchar *data)
+        : m_data(data)
+    {
+    }
+
+    void write(quint32 value, int count)
+    {
+        m_cache = (m_cache << count) | value;
+        m_cached += count;
+        while (m_cached >= 8) {
+            m_cached -= 8;
+            *m_data++ = uchar(m_cache >> m_cached);
+        }
+    }
+
+    // Pads last byte with zeros
+    void flush()
+    {
+        if (m_cached > 0) {
+            *m_data++ = uchar(m_cache << (8 - m_cached));
+            m_cached = 0;
+        }
+    }
+
+private:
+    uchar *m_data;
+    quint32 m_cache = 0;
+    int m_cached = 0;
+};
+
+// Reads MSB first fields of at most 16 bits
+class SbcBitReader
+{
+public:
+    explicit SbcBitReader(const uchar *data)
+        : m_data(data)
+    {
+    }
+
+    quint32 read(int count)
+    {
+        while (m_cached < count) {
+            m_cache = (m_cache << 8) | *m_data++;
+            m_cached += 8;
+        }
+        m_cached -= count;
+        return (m_cache >> m_cached) & ((1u << count) - 1);
+    }
+
+private:
+    const uchar *m_data;
+    quint32 m_cache = 0;
+    int m_cached = 0;
+};
+
+} // namespace BluezQt
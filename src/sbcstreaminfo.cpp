@@ -0,0 +1,36 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "sbcstreaminfo.h"
+#include "sbcframe_p.h"
+
+namespace BluezQt
+{
+bool SbcStreamInfo::isValid() const
+{
+    return frameLength > 0;
+}
+
+SbcStreamInfo SbcStreamInfo::fromConfiguration(const QByteArray &configuration, int mtu)
+{
+    SbcStreamInfo info;
+
+    SbcFrameHeader header;
+    int minBitpool;
+    int maxBitpool;
+    if (!header.parseConfiguration(configuration, &minBitpool, &maxBitpool)) {
+        return info;
+    }
+
+    info.frameLength = header.frameLength();
+    info.samplesPerFrame = header.samplesPerFrame();
+    info.bitrate = header.bitrate();
+    info.framesPerPacket = header.framesPerPacket(mtu);
+    info.packetLatency = header.packetLatency(mtu);
+    return info;
+}
+
+} // namespace BluezQt
@@ -0,0 +1,55 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include "bluezqt_export.h"
+
+namespace BluezQt
+{
+/**
+ * @class BluezQt::SbcStreamInfo sbcstreaminfo.h <BluezQt/SbcStreamInfo>
+ *
+ * Parameters of SBC stream.
+ *
+ * Frame size, bitrate and packet latency of a stream encoded with
+ * the maximum bitpool of SBC configuration selected by MediaEndpoint.
+ */
+struct BLUEZQT_EXPORT SbcStreamInfo {
+    /** Default L2CAP MTU. */
+    static const int defaultMtu = 672;
+
+    /** Length of one frame in bytes. */
+    int frameLength = 0;
+    /** Number of samples per channel in one frame. */
+    int samplesPerFrame = 0;
+    /** Bits per second. */
+    int bitrate = 0;
+    /** Number of frames in one full packet. */
+    int framesPerPacket = 0;
+    /** Duration of audio in one full packet in microseconds. */
+    int packetLatency = 0;
+
+    /**
+     * Returns whether the configuration was valid.
+     *
+     * @return true if valid
+     */
+    bool isValid() const;
+
+    /**
+     * Computes stream parameters from a2dp_sbc_t configuration.
+     *
+     * @param configuration SBC configuration
+     * @param mtu write MTU of transport
+     * @return stream parameters, invalid if configuration is not valid
+     */
+    static SbcStreamInfo fromConfiguration(const QByteArray &configuration, int mtu = defaultMtu);
+};
+
+} // namespace BluezQt
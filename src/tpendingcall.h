@@ -84,6 +84,7 @@ private:
     QDBusPendingReply<T...> m_reply;
 
     friend class MediaTransport;
+    friend class GattCharacteristicRemote;
 };
 
 } // namespace BluezQt
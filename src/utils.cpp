@@ -11,8 +11,11 @@
 #include "manager.h"
 #include "obexmanager.h"
 
+#include <QDBusArgument>
 #include <QDBusConnection>
+#include <QDBusVariant>
 #include <QPointer>
+#include <QVector>
 
 namespace BluezQt
 {
@@ -228,38 +231,98 @@ void Instance::setObexManager(ObexManager *obexManager)
     globalData->obexManager = obexManager;
 }
 
-QStringList stringListToUpper(const QStringList &list)
+// Converts UUIDs to uppercase, well-known UUIDs share interned strings
+QStringList uuidListToUpper(const QStringList &list, QVector<Uuid> *uuids)
 {
     QStringList converted;
     converted.reserve(list.size());
+    uuids->clear();
+    uuids->reserve(list.size());
     for (const QString &str : list) {
-        converted.append(str.toUpper());
+        converted.append(uuidToUpper(str));
+        uuids->append(Uuid(str));
     }
     return converted;
 }
 
-ManData variantToManData(const QVariant &v) {
-    // Map to return
+// Returns uppercase UUID, well-known UUIDs share interned strings
+QString uuidToUpper(const QString &uuid)
+{
+    for (const QChar c : uuid) {
+        if (c.isLower()) {
+            const Uuid value(uuid);
+            return value.isNull() || uuid.size() != 36 ? uuid.toUpper() : value.toString();
+        }
+    }
+    return uuid;
+}
+
+// Returns path of the direct child of parentPath that path belongs to (or path itself
+// if it is the direct child), or empty string if path is not below parentPath
+QString childObjectPath(const QString &parentPath, const QString &path)
+{
+    const int parentSize = parentPath.size();
+    if (path.size() <= parentSize + 1 || path.at(parentSize) != QLatin1Char('/') || !path.startsWith(parentPath)) {
+        return QString();
+    }
+
+    const int end = path.indexOf(QLatin1Char('/'), parentSize + 1);
+    return end < 0 ? path : path.left(end);
+}
+
+// Demarshals a{qv} straight into the result, without going through QMap<quint16, QVariant>
+ManData variantToManData(const QVariant &value)
+{
     ManData manData;
 
-    if (!v.isValid()) {
+    if (value.userType() != qMetaTypeId<QDBusArgument>()) {
         return manData;
     }
 
-    // Map with QVariant values
-    QMap<uint16_t,QVariant> vMap;
-    const QDBusArgument &dbusArgs = v.value<QDBusArgument>();
-    dbusArgs >> vMap;
-    // Iterate & convert values to byte array
-    QMap<uint16_t,QVariant>::const_iterator i;
-    for (i = vMap.constBegin(); i != vMap.constEnd(); ++i) {
-        const QVariant &value = i.value();
-        const uint16_t &key = i.key();
-        manData.insert(key,value.toByteArray());
+    const QDBusArgument &arg = value.value<QDBusArgument>();
+    if (arg.currentType() != QDBusArgument::MapType) {
+        return manData;
     }
+
+    arg.beginMap();
+    while (!arg.atEnd()) {
+        quint16 key;
+        QDBusVariant data;
+        arg.beginMapEntry();
+        arg >> key >> data;
+        arg.endMapEntry();
+        manData.insert(key, data.variant().toByteArray());
+    }
+    arg.endMap();
     return manData;
 }
 
+QHash<QString, QByteArray> variantToServiceData(const QVariant &value)
+{
+    QHash<QString, QByteArray> serviceData;
+
+    if (value.userType() != qMetaTypeId<QDBusArgument>()) {
+        return serviceData;
+    }
+
+    const QDBusArgument &arg = value.value<QDBusArgument>();
+    if (arg.currentType() != QDBusArgument::MapType) {
+        return serviceData;
+    }
+
+    arg.beginMap();
+    while (!arg.atEnd()) {
+        QString key;
+        QDBusVariant data;
+        arg.beginMapEntry();
+        arg >> key >> data;
+        arg.endMapEntry();
+        serviceData.insert(uuidToUpper(key), data.variant().toByteArray());
+    }
+    arg.endMap();
+    return serviceData;
+}
+
 Device::Type classToType(quint32 classNum)
 {
     switch ((classNum & 0x1f00) >> 8) {
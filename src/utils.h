@@ -10,6 +10,7 @@
 #define BLUEZQT_UTILS_H
 
 #include "device.h"
+#include "uuid.h"
 
 #include <QStringList>
 
@@ -62,8 +63,11 @@ void setObexManager(ObexManager *obexManager);
 
 }
 
-QStringList stringListToUpper(const QStringList &list);
+QStringList uuidListToUpper(const QStringList &list, QVector<Uuid> *uuids);
+QString uuidToUpper(const QString &uuid);
+QString childObjectPath(const QString &parentPath, const QString &path);
 ManData variantToManData(const QVariant &value);
+QHash<QString, QByteArray> variantToServiceData(const QVariant &value);
 Device::Type classToType(quint32 classNum);
 Device::Type appearanceToType(quint16 appearance);
 
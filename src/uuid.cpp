@@ -0,0 +1,177 @@
+/*
+ * BluezQt - Asynchronous Bluez wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "uuid.h"
+#include "services.h"
+
+#include <QHash>
+
+namespace BluezQt
+{
+// Bluetooth Base UUID 00000000-0000-1000-8000-00805F9B34FB
+static const quint64 BASE_UUID_HIGH = Q_UINT64_C(0x0000000000001000);
+static const quint64 BASE_UUID_LOW = Q_UINT64_C(0x800000805F9B34FB);
+
+static int hexValue(QChar c)
+{
+    const ushort u = c.unicode();
+    if (u >= '0' && u <= '9') {
+        return u - '0';
+    } else if (u >= 'a' && u <= 'f') {
+        return u - 'a' + 10;
+    } else if (u >= 'A' && u <= 'F') {
+        return u - 'A' + 10;
+    }
+    return -1;
+}
+
+// Parses hex digits of str in range [from, to), skipping dashes at given positions
+static bool parseHex(const QString &str, int from, int to, quint64 *out)
+{
+    quint64 value = 0;
+    for (int i = from; i < to; ++i) {
+        if (str.at(i) == QLatin1Char('-') && (i == 8 || i == 13 || i == 18 || i == 23)) {
+            continue;
+        }
+        const int v = hexValue(str.at(i));
+        if (v < 0) {
+            return false;
+        }
+        value = (value << 4) | quint64(v);
+    }
+    *out = value;
+    return true;
+}
+
+class UuidInternTable
+{
+public:
+    explicit UuidInternTable();
+
+    QHash<Uuid, QString> strings;
+};
+
+UuidInternTable::UuidInternTable()
+{
+    const QString services[] = {
+        Services::ServiceDiscoveryServer,
+        Services::SerialPort,
+        Services::DialupNetworking,
+        Services::ObexObjectPush,
+        Services::ObexFileTransfer,
+        Services::Headset,
+        Services::AudioSource,
+        Services::AudioSink,
+        Services::AudioVideoRemoteControlTarget,
+        Services::AdvancedAudioDistribution,
+        Services::AudioVideoRemoteControl,
+        Services::HeadsetAudioGateway,
+        Services::Panu,
+        Services::Nap,
+        Services::Handsfree,
+        Services::HandsfreeAudioGateway,
+        Services::HumanInterfaceDevice,
+        Services::SimAccess,
+        Services::PhonebookAccessServer,
+        Services::MessageAccessServer,
+        Services::PnpInformation,
+        Services::GenericAccess,
+        Services::GenericAttribute,
+        Services::ImmediateAlert,
+        Services::LinkLoss,
+        Services::TxPower,
+        Services::HeartRate,
+    };
+
+    for (const QString &service : services) {
+        strings.insert(Uuid(service), service.toUpper());
+    }
+}
+
+Q_GLOBAL_STATIC(UuidInternTable, internTable)
+
+Uuid::Uuid()
+    : m_high(0)
+    , m_low(0)
+{
+}
+
+Uuid::Uuid(quint32 shortUuid)
+    : m_high((quint64(shortUuid) << 32) | BASE_UUID_HIGH)
+    , m_low(BASE_UUID_LOW)
+{
+}
+
+Uuid::Uuid(const QString &uuid)
+    : m_high(0)
+    , m_low(0)
+{
+    if (uuid.size() == 4 || uuid.size() == 8) {
+        quint64 shortUuid;
+        if (parseHex(uuid, 0, uuid.size(), &shortUuid)) {
+            *this = Uuid(quint32(shortUuid));
+        }
+        return;
+    }
+
+    if (uuid.size() != 36) {
+        return;
+    }
+
+    quint64 high;
+    quint64 low;
+    if (uuid.at(8) != QLatin1Char('-') || uuid.at(13) != QLatin1Char('-') || uuid.at(18) != QLatin1Char('-') || uuid.at(23) != QLatin1Char('-')) {
+        return;
+    }
+    if (parseHex(uuid, 0, 18, &high) && parseHex(uuid, 19, 36, &low)) {
+        m_high = high;
+        m_low = low;
+    }
+}
+
+bool Uuid::isNull() const
+{
+    return m_high == 0 && m_low == 0;
+}
+
+bool Uuid::isShort() const
+{
+    return m_low == BASE_UUID_LOW && (m_high & Q_UINT64_C(0xFFFFFFFF)) == BASE_UUID_HIGH;
+}
+
+quint32 Uuid::toShort() const
+{
+    return isShort() ? quint32(m_high >> 32) : 0;
+}
+
+QString Uuid::toString() const
+{
+    if (isNull()) {
+        return QString();
+    }
+
+    const QString interned = internTable->strings.value(*this);
+    if (!interned.isNull()) {
+        return interned;
+    }
+
+    static const char digits[] = "0123456789ABCDEF";
+
+    QString str(36, QLatin1Char('-'));
+    QChar *data = str.data();
+    int pos = 0;
+    for (int i = 0; i < 32; ++i) {
+        if (pos == 8 || pos == 13 || pos == 18 || pos == 23) {
+            ++pos;
+        }
+        const quint64 part = i < 16 ? m_high : m_low;
+        const int shift = (15 - (i % 16)) * 4;
+        data[pos++] = QLatin1Char(digits[(part >> shift) & 0xF]);
+    }
+    return str;
+}
+
+} // namespace BluezQt
@@ -0,0 +1,117 @@
+/*
+ * BluezQt - Asynchronous BlueZ wrapper library
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#ifndef BLUEZQT_UUID_H
+#define BLUEZQT_UUID_H
+
+#include <QMetaType>
+#include <QString>
+
+#include "bluezqt_export.h"
+
+namespace BluezQt
+{
+/**
+ * @class BluezQt::Uuid uuid.h <BluezQt/Uuid>
+ *
+ * Bluetooth UUID.
+ *
+ * This class represents a 128-bit Bluetooth UUID stored as two integers.
+ * Comparing and hashing UUIDs is done on integers only, which makes it
+ * a cheap alternative to comparing UUID strings.
+ *
+ * 16-bit and 32-bit short forms are expanded using the Bluetooth Base UUID
+ * (00000000-0000-1000-8000-00805F9B34FB).
+ */
+class BLUEZQT_EXPORT Uuid
+{
+public:
+    /**
+     * Creates a new null Uuid object.
+     */
+    Uuid();
+
+    /**
+     * Creates a new Uuid object from 16-bit or 32-bit short form.
+     *
+     * @param shortUuid short form of UUID
+     */
+    explicit Uuid(quint32 shortUuid);
+
+    /**
+     * Creates a new Uuid object from string.
+     *
+     * Both full 128-bit form (xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx) and
+     * 16-bit or 32-bit short forms (xxxx or xxxxxxxx) are accepted,
+     * case insensitive. Invalid strings result in null Uuid.
+     *
+     * @param uuid UUID string
+     */
+    explicit Uuid(const QString &uuid);
+
+    /**
+     * Returns whether the UUID is null.
+     *
+     * @return true if UUID is null
+     */
+    bool isNull() const;
+
+    /**
+     * Returns whether the UUID is derived from the Bluetooth Base UUID.
+     *
+     * @return true if UUID has a short form
+     */
+    bool isShort() const;
+
+    /**
+     * Returns 16-bit or 32-bit short form of the UUID.
+     *
+     * @return short form or 0 if UUID has no short form
+     */
+    quint32 toShort() const;
+
+    /**
+     * Returns the UUID in full 128-bit string form.
+     *
+     * The string is always uppercase. Well-known service UUIDs
+     * (see services.h) are returned as shared strings without allocation.
+     *
+     * @return UUID string
+     */
+    QString toString() const;
+
+    friend bool operator==(const Uuid &a, const Uuid &b)
+    {
+        return a.m_high == b.m_high && a.m_low == b.m_low;
+    }
+
+    friend bool operator!=(const Uuid &a, const Uuid &b)
+    {
+        return !(a == b);
+    }
+
+    friend bool operator<(const Uuid &a, const Uuid &b)
+    {
+        return a.m_high < b.m_high || (a.m_high == b.m_high && a.m_low < b.m_low);
+    }
+
+    friend uint qHash(const Uuid &uuid, uint seed = 0) noexcept
+    {
+        const quint64 key = uuid.m_high ^ (uuid.m_low * Q_UINT64_C(0x9E3779B97F4A7C15));
+        return uint(key ^ (key >> 32)) ^ seed;
+    }
+
+private:
+    quint64 m_high;
+    quint64 m_low;
+};
+
+} // namespace BluezQt
+
+Q_DECLARE_TYPEINFO(BluezQt::Uuid, Q_PRIMITIVE_TYPE);
+Q_DECLARE_METATYPE(BluezQt::Uuid)
+
+#endif // BLUEZQT_UUID_H